@@ -4,6 +4,12 @@
 // Implemented features:
 //  [X] Platform: Keyboard support. Since 1.87 we are using the io.AddKeyEvent() function. Pass ImGuiKey values to all key functions e.g. ImGui::IsKeyPressed(ImGuiKey_Space). [Legacy AKEYCODE_* values are obsolete since 1.87 and not supported since 1.91.5]
 //  [X] Platform: Mouse support. Can discriminate Mouse/TouchScreen/Pen.
+//  [X] Platform: Optional raw evdev input (ImGui_ImplAndroid_StartEvdevThread()), reading touchscreens without android_native_app_glue.
+//  [X] Platform: Optional drag prediction (ImGui_ImplAndroid_SetTouchPrediction()).
+//  [X] Platform: Multi-touch. Pointers tracked by ID (ImGui_ImplAndroid_GetTouches()), pinch/two-finger pan/long-press (ImGui_ImplAndroid_GetGestures()).
+//  [X] Platform: Optional input thread (ImGui_ImplAndroid_StartInputThread()), so input is read while a frame renders.
+//  [X] Platform: IME text and composition (ImGui_ImplAndroid_AddImeText(), ImGui_ImplAndroid_SetImeComposition()), fed by the application.
+//  [X] Platform: Move coalescing. One mouse position per move burst is forwarded, historical samples stay available via ImGui_ImplAndroid_GetFrameMotionSamples().
 // Missing features or Issues:
 //  [ ] Platform: Clipboard support.
 //  [ ] Platform: Gamepad support.
@@ -11,7 +17,7 @@
 // Important:
 //  - Consider using SDL or GLFW backend on Android, which will be more full-featured than this.
 //  - FIXME: On-screen keyboard currently needs to be enabled by the application (see examples/ and issue #3446)
-//  - FIXME: Unicode character inputs needs to be passed by Dear ImGui by the application (see examples/ and issue #3446)
+//  - FIXME: Unicode character inputs needs to be passed by the application, e.g. from its InputConnection to ImGui_ImplAndroid_AddImeText() (see issue #3446)
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -23,6 +29,14 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-19: Inputs: Added ImGui_ImplAndroid_AddImeText()/SetImeComposition(): IME commit and composition strings from any thread, applied in one batch per frame. Handle AKEY_EVENT_ACTION_MULTIPLE repeats.
+//  2026-10-19: Inputs: Added ImGui_ImplAndroid_SetInputWakeLooper(): wake an idle main loop when the input or evdev thread queues input.
+//  2026-10-19: Inputs: Added ImGui_ImplAndroid_StartEvdevThread()/StopEvdevThread()/SetEvdevDisplay(): touchscreens read from /dev/input/event* (multi-touch protocol B), for processes without an input queue.
+//  2026-10-19: Inputs: Added ImGui_ImplAndroid_SetTouchPrediction(): optional drag position extrapolation to the expected present time.
+//  2026-10-19: Inputs: Handle AMOTION_EVENT_ACTION_POINTER_DOWN/UP and CANCEL. Only the first finger drives the mouse. Added ImGui_ImplAndroid_GetTouches(), ImGui_ImplAndroid_GetGestures().
+//  2026-10-19: Inputs: Added ImGui_ImplAndroid_GetFrameInputTimeNs(), for input-to-photon latency measurement.
+//  2026-10-19: Inputs: Added ImGui_ImplAndroid_StartInputThread()/StopInputThread(): events are read and timestamped on a dedicated thread, passed through a lock-free ring and applied in NewFrame(). A full ring coalesces moves and never drops transitions.
+//  2026-10-19: Inputs: Coalesce AMOTION_EVENT_ACTION_MOVE/HOVER_MOVE into one io.AddMousePosEvent() per burst, keep historical samples per frame. Added ImGui_ImplAndroid_GetFrameMotionSamples(), ImGui_ImplAndroid_GetInputStats().
 //  2022-09-26: Inputs: Renamed ImGuiKey_ModXXX introduced in 1.87 to ImGuiMod_XXX (old names still supported).
 //  2022-01-26: Inputs: replaced short-lived io.AddKeyModsEvent() (added two weeks ago) with io.AddKeyEvent() using ImGuiKey_ModXXX flags. Sorry for the confusion.
 //  2022-01-17: Inputs: calling new io.AddMousePosEvent(), io.AddMouseButtonEvent(), io.AddMouseWheelEvent() API (1.87+).
@@ -32,17 +46,214 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_android.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
 #include <time.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/input.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 #include <android/native_window.h>
 #include <android/input.h>
 #include <android/keycodes.h>
 #include <android/log.h>
+#include <android/looper.h>
+#include "EvdevTouchDecoder.h"    // jni/include
 
 // Android data
 static double                                   g_Time = 0.0;
 static ANativeWindow*                           g_Window;
 static char                                     g_LogTag[] = "ImGuiExample";
 
+// Move coalescing: a burst of move events (and their historical samples) only updates the pending position,
+// which is forwarded before the next non-move event or at NewFrame(). 240/360 Hz panels otherwise add several
+// redundant mouse position events per frame.
+static const int                                g_MaxMotionSamples = 1024;
+static ImVector<ImGui_ImplAndroid_MotionSample> g_MotionSamples;        // Received since the last NewFrame()
+static ImVector<ImGui_ImplAndroid_MotionSample> g_FrameMotionSamples;   // Exposed during the current frame
+static bool                                     g_HasPendingMousePos = false;
+static ImVec2                                   g_PendingMousePos;
+static ImGuiMouseSource                         g_MouseSource = ImGuiMouseSource_COUNT;
+static ImGui_ImplAndroid_InputStats             g_InputStats;
+static int64_t                                  g_PendingInputTime = 0;  // Oldest event applied since the last NewFrame()
+static int64_t                                  g_FrameInputTime = 0;    // Oldest event applied for the current frame
+
+// Drag prediction: recent samples of the finger driving the mouse, to extrapolate its position to the expected present time
+struct ImGui_ImplAndroid_PredictionSample
+{
+    ImVec2      Pos;
+    double      Time;
+};
+static const int                                g_PredictionHistorySize = 32;
+static const double                             g_PredictionWindow = 0.05;      // Velocity from the samples of the last 50 ms
+static const double                             g_MaxPredictionHorizon = 0.05;  // Never extrapolate further than 50 ms
+static ImGui_ImplAndroid_PredictionSample       g_PredictionSamples[g_PredictionHistorySize];
+static int                                      g_PredictionCount = 0;          // Total pushed since the finger went down
+static float                                    g_PredictionLeadTime = 0.0f;    // 0: disabled
+static bool                                     g_MousePosPredicted = false;
+
+// Snapshot of one input event (or one historical move sample), so events can be read on another thread
+struct ImGui_ImplAndroid_InputRecord
+{
+    int32_t     Type;           // AINPUT_EVENT_TYPE_KEY or AINPUT_EVENT_TYPE_MOTION
+    int32_t     Action;         // AKEY_EVENT_ACTION_* or AMOTION_EVENT_ACTION_* (masked)
+    int32_t     ToolType;
+    int32_t     ButtonState;
+    int32_t     KeyCode;
+    int32_t     ScanCode;
+    int32_t     MetaState;
+    int32_t     RepeatCount;
+    float       X, Y;
+    float       ScrollX, ScrollY;
+    int32_t     PointerId;
+    int64_t     Time;           // Nanoseconds, CLOCK_MONOTONIC
+    bool        Historical;     // Batched move sample: recorded, never forwarded on its own
+    bool        Continuation;   // Further pointer of the same multi-touch move event
+};
+
+// Single producer (input or evdev thread) / single consumer (NewFrame()) ring, no locks.
+// When full, moves are coalesced into the latest position of each pointer (OverflowMoves[]) and their batched history dropped;
+// the producer waits for room for anything else, so touch, button and key transitions are never lost.
+struct ImGui_ImplAndroid_InputRing
+{
+    static const unsigned int       Capacity = 4096;    // Power of two
+    static const int                MaxOverflowMoves = 16;
+    ImGui_ImplAndroid_InputRecord   Records[Capacity];
+    std::atomic<unsigned int>       Head{0};            // Written by the producer
+    std::atomic<unsigned int>       Tail{0};            // Written by the consumer
+    std::atomic<int>                Dropped{0};         // Historical samples and superseded moves, while full
+    ImGui_ImplAndroid_InputRecord   OverflowMoves[MaxOverflowMoves];    // Producer only: moves waiting for room, oldest first
+    int                             OverflowMoveCount = 0;
+
+    bool Push(const ImGui_ImplAndroid_InputRecord& record)
+    {
+        unsigned int head = Head.load(std::memory_order_relaxed);
+        if (head - Tail.load(std::memory_order_acquire) == Capacity)
+            return false;
+        Records[head & (Capacity - 1)] = record;
+        Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    bool Pop(ImGui_ImplAndroid_InputRecord* record)
+    {
+        unsigned int tail = Tail.load(std::memory_order_relaxed);
+        if (tail == Head.load(std::memory_order_acquire))
+            return false;
+        *record = Records[tail & (Capacity - 1)];
+        Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+static ImGui_ImplAndroid_InputRing              g_InputRing;
+static AInputQueue*                             g_InputQueue = nullptr;
+static std::thread                              g_InputThread;
+static std::atomic<ALooper*>                    g_InputLooper{nullptr};
+static std::atomic<bool>                        g_InputThreadStop{false};
+static std::atomic<bool>                        g_EvdevThreadStop{false};
+static std::atomic<ALooper*>                    g_InputWakeLooper{nullptr};   // Not owned
+
+// IME bridge: commit and composition strings may come from any thread (e.g. an InputConnection forwarded over JNI).
+// They are queued under g_ImeMutex. Commits are timestamped (CLOCK_MONOTONIC, as input records) and applied in order with the key and
+// touch events around them; the latest composition is applied once per NewFrame(), however many arrived in between.
+struct ImGui_ImplAndroid_ImeCommit
+{
+    int64_t     Time;           // Nanoseconds, CLOCK_MONOTONIC
+    int         TextOffset;     // In g_ImeCommitText
+};
+static std::mutex                               g_ImeMutex;
+static std::atomic<bool>                        g_ImePending{false};
+static ImVector<ImGui_ImplAndroid_ImeCommit>    g_ImeCommits;                   // Oldest first
+static ImVector<char>                           g_ImeCommitText;                // One zero-terminated string per commit
+static ImVector<char>                           g_ImeComposition;               // Zero-terminated when not empty
+static int                                      g_ImeCompositionCursor = -1;
+static bool                                     g_ImeCompositionChanged = false;
+
+// Multi-touch: fingers are tracked by pointer ID. Only the first finger down (the primary pointer) drives the mouse,
+// and only while it is alone on screen, so a second finger neither moves nor clicks anything. Two-finger gestures
+// and long-press are recognized once per frame from the pointer table.
+static const int                                g_MaxTouches = 10;
+static const double                             g_LongPressTime = 0.5;
+static ImVector<ImGui_ImplAndroid_TouchPoint>   g_Touches;              // In order of going down
+static int32_t                                  g_PrimaryPointerId = -1;
+static ImGui_ImplAndroid_Gestures               g_Gestures;
+static int32_t                                  g_GesturePointerIds[2] = { -1, -1 };
+static float                                    g_GestureDistance = 0.0f;
+static ImVec2                                   g_GestureCenter;
+
+static ImGui_ImplAndroid_TouchPoint* ImGui_ImplAndroid_FindTouch(int32_t pointer_id)
+{
+    for (ImGui_ImplAndroid_TouchPoint& touch : g_Touches)
+        if (touch.Id == pointer_id)
+            return &touch;
+    return nullptr;
+}
+
+static void ImGui_ImplAndroid_FlushMousePos(ImGuiIO& io)
+{
+    if (!g_HasPendingMousePos)
+        return;
+    io.AddMousePosEvent(g_PendingMousePos.x, g_PendingMousePos.y);
+    g_InputStats.EventsForwarded++;
+    g_HasPendingMousePos = false;
+}
+
+static void ImGui_ImplAndroid_AddMotionSample(float x, float y, int64_t time_ns)
+{
+    g_InputStats.SamplesReceived++;
+    if (g_MotionSamples.Size < g_MaxMotionSamples)
+        g_MotionSamples.push_back({ x, y, (double)time_ns / 1000000000.0 });
+    if (g_MouseSource == ImGuiMouseSource_TouchScreen)
+        g_PredictionSamples[g_PredictionCount++ % g_PredictionHistorySize] = { ImVec2(x, y), (double)time_ns / 1000000000.0 };
+}
+
+// Least-squares velocity over the recent samples, extrapolated from the newest one to 'target_time'
+static bool ImGui_ImplAndroid_PredictMousePos(double target_time, ImVec2* out_pos)
+{
+    int count = g_PredictionCount < g_PredictionHistorySize ? g_PredictionCount : g_PredictionHistorySize;
+    if (count < 2)
+        return false;
+    const ImGui_ImplAndroid_PredictionSample& newest = g_PredictionSamples[(g_PredictionCount - 1) % g_PredictionHistorySize];
+    if (target_time - newest.Time > g_PredictionWindow)
+        return false; // Finger resting: no move events, nothing to extrapolate
+
+    double n = 0.0, sum_t = 0.0, sum_tt = 0.0, sum_x = 0.0, sum_y = 0.0, sum_tx = 0.0, sum_ty = 0.0;
+    for (int i = 0; i < count; i++)
+    {
+        const ImGui_ImplAndroid_PredictionSample& sample = g_PredictionSamples[(g_PredictionCount - 1 - i) % g_PredictionHistorySize];
+        double t = sample.Time - newest.Time;
+        if (t < -g_PredictionWindow)
+            break;
+        n += 1.0;
+        sum_t += t;
+        sum_tt += t * t;
+        sum_x += sample.Pos.x;
+        sum_y += sample.Pos.y;
+        sum_tx += t * sample.Pos.x;
+        sum_ty += t * sample.Pos.y;
+    }
+    double denominator = n * sum_tt - sum_t * sum_t;
+    if (n < 2.0 || denominator <= 1e-12)
+        return false;
+
+    double velocity_x = (n * sum_tx - sum_t * sum_x) / denominator;
+    double velocity_y = (n * sum_ty - sum_t * sum_y) / denominator;
+    double horizon = target_time - newest.Time;
+    horizon = horizon < 0.0 ? 0.0 : horizon > g_MaxPredictionHorizon ? g_MaxPredictionHorizon : horizon;
+    *out_pos = ImVec2(newest.Pos.x + (float)(velocity_x * horizon), newest.Pos.y + (float)(velocity_y * horizon));
+    return true;
+}
+
 static ImGuiKey ImGui_ImplAndroid_KeyCodeToImGuiKey(int32_t key_code)
 {
     switch (key_code)
@@ -156,25 +367,105 @@ static ImGuiKey ImGui_ImplAndroid_KeyCodeToImGuiKey(int32_t key_code)
     }
 }
 
-int32_t ImGui_ImplAndroid_HandleInputEvent(const AInputEvent* input_event)
+// Read an AInputEvent into records (historical move samples first), 'sink' is called once per record.
+// Only touches the AInputEvent, so it is safe to call from the input thread.
+template<typename Sink>
+static int32_t ImGui_ImplAndroid_ReadInputEvent(const AInputEvent* input_event, Sink&& sink)
+{
+    ImGui_ImplAndroid_InputRecord record = {};
+    record.Type = AInputEvent_getType(input_event);
+    switch (record.Type)
+    {
+    case AINPUT_EVENT_TYPE_KEY:
+        record.Action = AKeyEvent_getAction(input_event);
+        record.KeyCode = AKeyEvent_getKeyCode(input_event);
+        record.ScanCode = AKeyEvent_getScanCode(input_event);
+        record.MetaState = AKeyEvent_getMetaState(input_event);
+        record.RepeatCount = AKeyEvent_getRepeatCount(input_event);
+        record.Time = AKeyEvent_getEventTime(input_event);
+        sink(record);
+        return 0;
+    case AINPUT_EVENT_TYPE_MOTION:
+    {
+        int32_t event_action = AMotionEvent_getAction(input_event);
+        size_t event_pointer_index = (size_t)((event_action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT);
+        record.Action = event_action & AMOTION_EVENT_ACTION_MASK;
+        record.ButtonState = AMotionEvent_getButtonState(input_event);
+        record.Time = AMotionEvent_getEventTime(input_event);
+
+        // A move carries every pointer: one record each, after their batched history (oldest first) from high-rate panels
+        if (record.Action == AMOTION_EVENT_ACTION_MOVE || record.Action == AMOTION_EVENT_ACTION_HOVER_MOVE)
+        {
+            size_t pointer_count = AMotionEvent_getPointerCount(input_event);
+            size_t history_size = AMotionEvent_getHistorySize(input_event);
+            for (size_t pointer_index = 0; pointer_index < pointer_count; pointer_index++)
+            {
+                ImGui_ImplAndroid_InputRecord sample = record;
+                sample.ToolType = AMotionEvent_getToolType(input_event, pointer_index);
+                sample.PointerId = AMotionEvent_getPointerId(input_event, pointer_index);
+                sample.Historical = true;
+                for (size_t history_index = 0; history_index < history_size; history_index++)
+                {
+                    sample.X = AMotionEvent_getHistoricalX(input_event, pointer_index, history_index);
+                    sample.Y = AMotionEvent_getHistoricalY(input_event, pointer_index, history_index);
+                    sample.Time = AMotionEvent_getHistoricalEventTime(input_event, history_index);
+                    sink(sample);
+                }
+            }
+            for (size_t pointer_index = 0; pointer_index < pointer_count; pointer_index++)
+            {
+                ImGui_ImplAndroid_InputRecord sample = record;
+                sample.ToolType = AMotionEvent_getToolType(input_event, pointer_index);
+                sample.PointerId = AMotionEvent_getPointerId(input_event, pointer_index);
+                sample.X = AMotionEvent_getX(input_event, pointer_index);
+                sample.Y = AMotionEvent_getY(input_event, pointer_index);
+                sample.Continuation = pointer_index > 0;
+                sink(sample);
+            }
+            return 1;
+        }
+
+        if (record.Action == AMOTION_EVENT_ACTION_SCROLL)
+        {
+            record.ScrollX = AMotionEvent_getAxisValue(input_event, AMOTION_EVENT_AXIS_HSCROLL, event_pointer_index);
+            record.ScrollY = AMotionEvent_getAxisValue(input_event, AMOTION_EVENT_AXIS_VSCROLL, event_pointer_index);
+        }
+        record.ToolType = AMotionEvent_getToolType(input_event, event_pointer_index);
+        record.PointerId = AMotionEvent_getPointerId(input_event, event_pointer_index);
+        record.X = AMotionEvent_getX(input_event, event_pointer_index);
+        record.Y = AMotionEvent_getY(input_event, event_pointer_index);
+        sink(record);
+        return 1;
+    }
+    default:
+        return 0;
+    }
+}
+
+// Apply one record to io. Main thread only.
+static void ImGui_ImplAndroid_ProcessInputRecord(const ImGui_ImplAndroid_InputRecord& record)
 {
     ImGuiIO& io = ImGui::GetIO();
-    int32_t event_type = AInputEvent_getType(input_event);
-    switch (event_type)
+    if (!record.Historical && !record.Continuation)
+    {
+        g_InputStats.EventsReceived++;
+        if (record.Time > 0 && (g_PendingInputTime == 0 || record.Time < g_PendingInputTime))
+            g_PendingInputTime = record.Time;
+    }
+
+    switch (record.Type)
     {
     case AINPUT_EVENT_TYPE_KEY:
     {
-        int32_t event_key_code = AKeyEvent_getKeyCode(input_event);
-        int32_t event_scan_code = AKeyEvent_getScanCode(input_event);
-        int32_t event_action = AKeyEvent_getAction(input_event);
-        int32_t event_meta_state = AKeyEvent_getMetaState(input_event);
+        ImGui_ImplAndroid_FlushMousePos(io);
 
-        io.AddKeyEvent(ImGuiMod_Ctrl,  (event_meta_state & AMETA_CTRL_ON)  != 0);
-        io.AddKeyEvent(ImGuiMod_Shift, (event_meta_state & AMETA_SHIFT_ON) != 0);
-        io.AddKeyEvent(ImGuiMod_Alt,   (event_meta_state & AMETA_ALT_ON)   != 0);
-        io.AddKeyEvent(ImGuiMod_Super, (event_meta_state & AMETA_META_ON)  != 0);
+        io.AddKeyEvent(ImGuiMod_Ctrl,  (record.MetaState & AMETA_CTRL_ON)  != 0);
+        io.AddKeyEvent(ImGuiMod_Shift, (record.MetaState & AMETA_SHIFT_ON) != 0);
+        io.AddKeyEvent(ImGuiMod_Alt,   (record.MetaState & AMETA_ALT_ON)   != 0);
+        io.AddKeyEvent(ImGuiMod_Super, (record.MetaState & AMETA_META_ON)  != 0);
+        g_InputStats.EventsForwarded += 4;
 
-        switch (event_action)
+        switch (record.Action)
         {
         // FIXME: AKEY_EVENT_ACTION_DOWN and AKEY_EVENT_ACTION_UP occur at once as soon as a touch pointer
         // goes up from a key. We use a simple key event queue/ and process one event per key per frame in
@@ -182,15 +473,33 @@ int32_t ImGui_ImplAndroid_HandleInputEvent(const AInputEvent* input_event)
         case AKEY_EVENT_ACTION_DOWN:
         case AKEY_EVENT_ACTION_UP:
         {
-            ImGuiKey key = ImGui_ImplAndroid_KeyCodeToImGuiKey(event_key_code);
+            ImGuiKey key = ImGui_ImplAndroid_KeyCodeToImGuiKey(record.KeyCode);
             if (key != ImGuiKey_None)
             {
-                io.AddKeyEvent(key, event_action == AKEY_EVENT_ACTION_DOWN);
-                io.SetKeyEventNativeData(key, event_key_code, event_scan_code);
+                io.AddKeyEvent(key, record.Action == AKEY_EVENT_ACTION_DOWN);
+                io.SetKeyEventNativeData(key, record.KeyCode, record.ScanCode);
+                g_InputStats.EventsForwarded++;
             }
 
             break;
         }
+        case AKEY_EVENT_ACTION_MULTIPLE:
+        {
+            // The same key RepeatCount times in a row. With AKEYCODE_UNKNOWN it carries a string instead (KeyEvent.getCharacters()),
+            // which the NDK doesn't expose: the application has to pass it to ImGui_ImplAndroid_AddImeText().
+            ImGuiKey key = ImGui_ImplAndroid_KeyCodeToImGuiKey(record.KeyCode);
+            if (key != ImGuiKey_None)
+            {
+                for (int n = 0; n < record.RepeatCount; n++)
+                {
+                    io.AddKeyEvent(key, true);
+                    io.AddKeyEvent(key, false);
+                }
+                io.SetKeyEventNativeData(key, record.KeyCode, record.ScanCode);
+                g_InputStats.EventsForwarded += record.RepeatCount * 2;
+            }
+            break;
+        }
         default:
             break;
         }
@@ -198,67 +507,647 @@ int32_t ImGui_ImplAndroid_HandleInputEvent(const AInputEvent* input_event)
     }
     case AINPUT_EVENT_TYPE_MOTION:
     {
-        int32_t event_action = AMotionEvent_getAction(input_event);
-        int32_t event_pointer_index = (event_action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
-        event_action &= AMOTION_EVENT_ACTION_MASK;
-
-        switch (AMotionEvent_getToolType(input_event, event_pointer_index))
+        ImGuiMouseSource mouse_source;
+        switch (record.ToolType)
         {
         case AMOTION_EVENT_TOOL_TYPE_MOUSE:
-            io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+            mouse_source = ImGuiMouseSource_Mouse;
             break;
         case AMOTION_EVENT_TOOL_TYPE_STYLUS:
         case AMOTION_EVENT_TOOL_TYPE_ERASER:
-            io.AddMouseSourceEvent(ImGuiMouseSource_Pen);
+            mouse_source = ImGuiMouseSource_Pen;
             break;
         case AMOTION_EVENT_TOOL_TYPE_FINGER:
         default:
-            io.AddMouseSourceEvent(ImGuiMouseSource_TouchScreen);
+            mouse_source = ImGuiMouseSource_TouchScreen;
             break;
         }
 
-        switch (event_action)
+        // Anything but a move (or a move from another tool) must see the pending position first, in order
+        bool is_move = record.Action == AMOTION_EVENT_ACTION_MOVE || record.Action == AMOTION_EVENT_ACTION_HOVER_MOVE;
+        if (!is_move || mouse_source != g_MouseSource)
+            ImGui_ImplAndroid_FlushMousePos(io);
+        if (mouse_source != g_MouseSource)
+        {
+            io.AddMouseSourceEvent(mouse_source);
+            g_MouseSource = mouse_source;
+        }
+
+        // Physical mouse buttons (and probably other physical devices) also invoke the actions AMOTION_EVENT_ACTION_DOWN/_UP,
+        // but we have to process them separately to identify the actual button pressed. This is done below via
+        // AMOTION_EVENT_ACTION_BUTTON_PRESS/_RELEASE. Here, we only process "FINGER" input (and "UNKNOWN", as a fallback).
+        bool is_touch = record.ToolType == AMOTION_EVENT_TOOL_TYPE_FINGER || record.ToolType == AMOTION_EVENT_TOOL_TYPE_UNKNOWN;
+        bool is_mouse_pointer = !is_touch || (record.PointerId == g_PrimaryPointerId && g_Touches.Size < 2);
+
+        switch (record.Action)
         {
         case AMOTION_EVENT_ACTION_DOWN:
+        case AMOTION_EVENT_ACTION_POINTER_DOWN:
+        {
+            if (!is_touch)
+                break;
+            if (ImGui_ImplAndroid_FindTouch(record.PointerId) == nullptr && g_Touches.Size < g_MaxTouches)
+            {
+                ImVec2 pos(record.X, record.Y);
+                g_Touches.push_back({ record.PointerId, pos, pos, (double)record.Time / 1000000000.0, false });
+            }
+            if (record.Action == AMOTION_EVENT_ACTION_DOWN && g_PrimaryPointerId < 0)
+            {
+                g_PrimaryPointerId = record.PointerId;
+                g_PredictionCount = 0;
+                ImGui_ImplAndroid_AddMotionSample(record.X, record.Y, record.Time);
+                io.AddMousePosEvent(record.X, record.Y);
+                io.AddMouseButtonEvent(0, true);
+                g_InputStats.EventsForwarded += 2;
+            }
+            break;
+        }
         case AMOTION_EVENT_ACTION_UP:
+        case AMOTION_EVENT_ACTION_POINTER_UP:
+        {
+            if (!is_touch)
+                break;
+            for (int touch_n = 0; touch_n < g_Touches.Size; touch_n++)
+                if (g_Touches[touch_n].Id == record.PointerId)
+                    g_Touches.erase(g_Touches.Data + touch_n);
+            if (record.PointerId == g_PrimaryPointerId || record.Action == AMOTION_EVENT_ACTION_UP)
+            {
+                // Released where the mouse last was when a gesture froze it
+                if (record.PointerId == g_PrimaryPointerId && is_mouse_pointer)
+                {
+                    ImGui_ImplAndroid_AddMotionSample(record.X, record.Y, record.Time);
+                    io.AddMousePosEvent(record.X, record.Y);
+                    g_InputStats.EventsForwarded++;
+                }
+                if (g_PrimaryPointerId >= 0)
+                {
+                    io.AddMouseButtonEvent(0, false);
+                    g_InputStats.EventsForwarded++;
+                }
+                g_PrimaryPointerId = -1;
+            }
+            if (record.Action == AMOTION_EVENT_ACTION_UP)
+                g_Touches.resize(0);
+            break;
+        }
+        case AMOTION_EVENT_ACTION_CANCEL:
         {
-            // Physical mouse buttons (and probably other physical devices) also invoke the actions AMOTION_EVENT_ACTION_DOWN/_UP,
-            // but we have to process them separately to identify the actual button pressed. This is done below via
-            // AMOTION_EVENT_ACTION_BUTTON_PRESS/_RELEASE. Here, we only process "FINGER" input (and "UNKNOWN", as a fallback).
-            int tool_type = AMotionEvent_getToolType(input_event, event_pointer_index);
-            if (tool_type == AMOTION_EVENT_TOOL_TYPE_FINGER || tool_type == AMOTION_EVENT_TOOL_TYPE_UNKNOWN)
+            if (g_PrimaryPointerId >= 0)
             {
-                io.AddMousePosEvent(AMotionEvent_getX(input_event, event_pointer_index), AMotionEvent_getY(input_event, event_pointer_index));
-                io.AddMouseButtonEvent(0, event_action == AMOTION_EVENT_ACTION_DOWN);
+                io.AddMouseButtonEvent(0, false);
+                g_InputStats.EventsForwarded++;
             }
+            g_PrimaryPointerId = -1;
+            g_Touches.resize(0);
             break;
         }
         case AMOTION_EVENT_ACTION_BUTTON_PRESS:
         case AMOTION_EVENT_ACTION_BUTTON_RELEASE:
         {
-            int32_t button_state = AMotionEvent_getButtonState(input_event);
-            io.AddMouseButtonEvent(0, (button_state & AMOTION_EVENT_BUTTON_PRIMARY) != 0);
-            io.AddMouseButtonEvent(1, (button_state & AMOTION_EVENT_BUTTON_SECONDARY) != 0);
-            io.AddMouseButtonEvent(2, (button_state & AMOTION_EVENT_BUTTON_TERTIARY) != 0);
+            io.AddMouseButtonEvent(0, (record.ButtonState & AMOTION_EVENT_BUTTON_PRIMARY) != 0);
+            io.AddMouseButtonEvent(1, (record.ButtonState & AMOTION_EVENT_BUTTON_SECONDARY) != 0);
+            io.AddMouseButtonEvent(2, (record.ButtonState & AMOTION_EVENT_BUTTON_TERTIARY) != 0);
+            g_InputStats.EventsForwarded += 3;
             break;
         }
         case AMOTION_EVENT_ACTION_HOVER_MOVE: // Hovering: Tool moves while NOT pressed (such as a physical mouse)
         case AMOTION_EVENT_ACTION_MOVE:       // Touch pointer moves while DOWN
-            io.AddMousePosEvent(AMotionEvent_getX(input_event, event_pointer_index), AMotionEvent_getY(input_event, event_pointer_index));
+        {
+            if (is_touch && !record.Historical)
+                if (ImGui_ImplAndroid_TouchPoint* touch = ImGui_ImplAndroid_FindTouch(record.PointerId))
+                    touch->Pos = ImVec2(record.X, record.Y);
+            if (!is_mouse_pointer)
+                break;
+            ImGui_ImplAndroid_AddMotionSample(record.X, record.Y, record.Time);
+            if (!record.Historical)
+            {
+                g_PendingMousePos = ImVec2(record.X, record.Y);
+                g_HasPendingMousePos = true;
+            }
             break;
+        }
         case AMOTION_EVENT_ACTION_SCROLL:
-            io.AddMouseWheelEvent(AMotionEvent_getAxisValue(input_event, AMOTION_EVENT_AXIS_HSCROLL, event_pointer_index), AMotionEvent_getAxisValue(input_event, AMOTION_EVENT_AXIS_VSCROLL, event_pointer_index));
+            io.AddMouseWheelEvent(record.ScrollX, record.ScrollY);
+            g_InputStats.EventsForwarded++;
             break;
         default:
             break;
         }
+        break;
     }
-        return 1;
     default:
         break;
     }
+}
+
+static void ImGui_ImplAndroid_ApplyIme(ImGuiIO& io, int64_t commit_time_limit, bool apply_composition);
+
+int32_t ImGui_ImplAndroid_HandleInputEvent(const AInputEvent* input_event)
+{
+    return ImGui_ImplAndroid_ReadInputEvent(input_event, [](const ImGui_ImplAndroid_InputRecord& record)
+    {
+        ImGui_ImplAndroid_ApplyIme(ImGui::GetIO(), record.Time, false);
+        ImGui_ImplAndroid_ProcessInputRecord(record);
+    });
+}
+
+// Input thread: owns the AInputQueue (attached to its own looper), finishes events immediately and hands records
+// over through g_InputRing. Records keep their AMotionEvent/AKeyEvent timestamps and are applied in NewFrame().
+static void ImGui_ImplAndroid_WakeInputConsumer()
+{
+    if (ALooper* looper = g_InputWakeLooper.load(std::memory_order_acquire))
+        ALooper_wake(looper); // One eventfd write, cheap next to the event itself
+}
+
+// Push moves held back while the ring was full. Returns false if some are still waiting for room.
+static bool ImGui_ImplAndroid_FlushOverflowMoves()
+{
+    ImGui_ImplAndroid_InputRing& ring = g_InputRing;
+    int flushed = 0;
+    while (flushed < ring.OverflowMoveCount && ring.Push(ring.OverflowMoves[flushed]))
+        flushed++;
+    if (flushed > 0)
+    {
+        ring.OverflowMoveCount -= flushed;
+        memmove(ring.OverflowMoves, ring.OverflowMoves + flushed, sizeof(ring.OverflowMoves[0]) * ring.OverflowMoveCount);
+        ImGui_ImplAndroid_WakeInputConsumer();
+    }
+    return ring.OverflowMoveCount == 0;
+}
+
+static void ImGui_ImplAndroid_PushInputRecord(const ImGui_ImplAndroid_InputRecord& record)
+{
+    ImGui_ImplAndroid_InputRing& ring = g_InputRing;
+    if (ImGui_ImplAndroid_FlushOverflowMoves() && ring.Push(record))
+    {
+        ImGui_ImplAndroid_WakeInputConsumer();
+        return;
+    }
+
+    // Full: NewFrame() only needs the latest position of each pointer, so moves replace each other until there is room again
+    bool is_move = record.Type == AINPUT_EVENT_TYPE_MOTION && (record.Action == AMOTION_EVENT_ACTION_MOVE || record.Action == AMOTION_EVENT_ACTION_HOVER_MOVE);
+    if (is_move)
+    {
+        if (record.Historical)
+        {
+            ring.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        for (int n = 0; n < ring.OverflowMoveCount; n++)
+            if (ring.OverflowMoves[n].PointerId == record.PointerId && ring.OverflowMoves[n].Action == record.Action)
+            {
+                ring.OverflowMoves[n] = record;
+                ring.Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        if (ring.OverflowMoveCount < ImGui_ImplAndroid_InputRing::MaxOverflowMoves)
+        {
+            ring.OverflowMoves[ring.OverflowMoveCount++] = record;
+            return;
+        }
+    }
+
+    // Transitions (touch down/up, buttons, keys, scroll) must not be lost: wait for NewFrame() to make room.
+    // Events stay unfinished meanwhile, which is what lets the system throttle the sender.
+    while (!ImGui_ImplAndroid_FlushOverflowMoves() || !ring.Push(record))
+    {
+        if (g_InputThreadStop.load(std::memory_order_acquire) || g_EvdevThreadStop.load(std::memory_order_acquire))
+        {
+            ring.Dropped.fetch_add(1, std::memory_order_relaxed); // Stopping: nothing will drain the ring before Shutdown()/the next thread
+            return;
+        }
+        ImGui_ImplAndroid_WakeInputConsumer();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ImGui_ImplAndroid_WakeInputConsumer();
+}
+
+void ImGui_ImplAndroid_SetInputWakeLooper(ALooper* looper)
+{
+    g_InputWakeLooper.store(looper, std::memory_order_release);
+}
+
+static void ImGui_ImplAndroid_AppendImeString(ImVector<char>* out_str, const char* str)
+{
+    if (str == nullptr || str[0] == 0)
+        return;
+    int offset = out_str->empty() ? 0 : out_str->Size - 1; // Over the terminator
+    int len = (int)strlen(str);
+    out_str->resize(offset + len + 1);
+    memcpy(out_str->Data + offset, str, (size_t)len + 1);
+}
+
+void ImGui_ImplAndroid_AddImeText(const char* utf8)
+{
+    if (utf8 == nullptr || utf8[0] == 0)
+        return;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    {
+        std::lock_guard<std::mutex> lock(g_ImeMutex);
+        ImGui_ImplAndroid_ImeCommit commit;
+        commit.Time = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+        commit.TextOffset = g_ImeCommitText.Size;
+        g_ImeCommits.push_back(commit);
+        g_ImeCommitText.resize(commit.TextOffset + (int)strlen(utf8) + 1);
+        memcpy(g_ImeCommitText.Data + commit.TextOffset, utf8, (size_t)(g_ImeCommitText.Size - commit.TextOffset));
+    }
+    g_ImePending.store(true, std::memory_order_release);
+    if (ALooper* looper = g_InputWakeLooper.load(std::memory_order_acquire))
+        ALooper_wake(looper);
+}
+
+void ImGui_ImplAndroid_SetImeComposition(const char* utf8, int cursor)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_ImeMutex);
+        g_ImeComposition.resize(0);
+        ImGui_ImplAndroid_AppendImeString(&g_ImeComposition, utf8);
+        g_ImeCompositionCursor = cursor;
+        g_ImeCompositionChanged = true;
+    }
+    g_ImePending.store(true, std::memory_order_release);
+    if (ALooper* looper = g_InputWakeLooper.load(std::memory_order_acquire))
+        ALooper_wake(looper);
+}
+
+// Forward the IME commits made up to 'commit_time_limit', then the latest composition if 'apply_composition'.
+// Called before each key/touch event is applied, so e.g. "commit X, backspace" doesn't become "backspace, commit X".
+static void ImGui_ImplAndroid_ApplyIme(ImGuiIO& io, int64_t commit_time_limit, bool apply_composition)
+{
+    if (!g_ImePending.load(std::memory_order_acquire))
+        return;
+    std::lock_guard<std::mutex> lock(g_ImeMutex);
+    int commit_n = 0;
+    for (; commit_n < g_ImeCommits.Size && g_ImeCommits[commit_n].Time <= commit_time_limit; commit_n++)
+    {
+        ImGui_ImplAndroid_FlushMousePos(io);
+        io.AddInputCharactersUTF8(g_ImeCommitText.Data + g_ImeCommits[commit_n].TextOffset);
+        g_InputStats.EventsForwarded++;
+    }
+    if (commit_n == g_ImeCommits.Size)
+    {
+        g_ImeCommits.resize(0);
+        g_ImeCommitText.resize(0);
+    }
+    else if (commit_n > 0)
+    {
+        const int text_offset = g_ImeCommits[commit_n].TextOffset;
+        g_ImeCommits.erase(g_ImeCommits.Data, g_ImeCommits.Data + commit_n);
+        g_ImeCommitText.erase(g_ImeCommitText.Data, g_ImeCommitText.Data + text_offset);
+        for (ImGui_ImplAndroid_ImeCommit& commit : g_ImeCommits)
+            commit.TextOffset -= text_offset;
+    }
+    if (apply_composition && g_ImeCompositionChanged)
+    {
+        io.SetInputComposition(g_ImeComposition.empty() ? nullptr : g_ImeComposition.Data, g_ImeCompositionCursor);
+        g_ImeCompositionChanged = false;
+    }
+    if (g_ImeCommits.empty() && !g_ImeCompositionChanged)
+        g_ImePending.store(false, std::memory_order_relaxed); // Writers set it again after releasing the lock
+}
+
+static int ImGui_ImplAndroid_InputQueueCallback(int, int, void*)
+{
+    AInputEvent* input_event = nullptr;
+    while (AInputQueue_getEvent(g_InputQueue, &input_event) >= 0)
+    {
+        if (AInputQueue_preDispatchEvent(g_InputQueue, input_event))
+            continue;
+        int32_t handled = ImGui_ImplAndroid_ReadInputEvent(input_event, ImGui_ImplAndroid_PushInputRecord);
+        AInputQueue_finishEvent(g_InputQueue, input_event, handled);
+    }
+    return 1; // Keep receiving callbacks
+}
+
+static void ImGui_ImplAndroid_InputThreadMain()
+{
+    ALooper* looper = ALooper_prepare(0);
+    ALooper_acquire(looper);
+    AInputQueue_attachLooper(g_InputQueue, looper, 1, ImGui_ImplAndroid_InputQueueCallback, nullptr);
+    g_InputLooper.store(looper, std::memory_order_release); // Released by StopInputThread(), after wake/join
+
+    // Moves held back by a full ring are retried every millisecond until NewFrame() made room, even without new events
+    while (!g_InputThreadStop.load(std::memory_order_acquire))
+    {
+        ALooper_pollOnce(g_InputRing.OverflowMoveCount > 0 ? 1 : -1, nullptr, nullptr, nullptr);
+        ImGui_ImplAndroid_FlushOverflowMoves();
+    }
+
+    // Leave the queue unattached while it is still valid: the caller may hand it to another looper or let it be destroyed
+    AInputQueue_detachLooper(g_InputQueue);
+}
+
+bool ImGui_ImplAndroid_StartInputThread(AInputQueue* input_queue)
+{
+    ImGui_ImplAndroid_StopInputThread();
+    ImGui_ImplAndroid_StopEvdevThread(); // g_InputRing has a single producer
+    if (input_queue == nullptr)
+        return false;
+
+    // Move the queue off the caller's looper (android_native_app_glue attaches it to the main looper)
+    AInputQueue_detachLooper(input_queue);
+    g_InputQueue = input_queue;
+    g_InputThreadStop.store(false, std::memory_order_release);
+    g_InputThread = std::thread(ImGui_ImplAndroid_InputThreadMain);
+    return true;
+}
+
+void ImGui_ImplAndroid_StopInputThread()
+{
+    if (!g_InputThread.joinable())
+        return;
+
+    g_InputThreadStop.store(true, std::memory_order_release);
+    ALooper* looper;
+    while ((looper = g_InputLooper.load(std::memory_order_acquire)) == nullptr)
+        std::this_thread::yield(); // Thread still starting up
+    ALooper_wake(looper);
+    g_InputThread.join(); // Detaches g_InputQueue from the thread's looper before exiting
+    g_InputThreadStop.store(false, std::memory_order_release); // Only set while stopping: PushInputRecord() from the next producer must keep waiting for room
+    ALooper_release(looper);
+    g_InputLooper.store(nullptr, std::memory_order_relaxed);
+    g_InputQueue = nullptr;
+    g_InputRing.OverflowMoveCount = 0;
+}
+
+// Raw evdev input: touchscreens read straight from /dev/input/event* (multi-touch protocol B) for processes without an AInputQueue,
+// such as a standalone executable drawing on an overlay. Each SYN_REPORT frame is turned into the same records an AMotionEvent
+// produces and handed over through g_InputRing, so coalescing, multi-touch and drag prediction apply unchanged.
+static const int                                g_EvdevMaxDevices = 8;
+static const int                                g_EvdevMaxSlots = android::detail::EvdevTouchDecoder::MaxSlots;
+struct ImGui_ImplAndroid_EvdevDevice
+{
+    int         Fd = -1;
+    bool        Replay = false;         // Regular file of recorded input_event: read once, paced by its timestamps
+    int         PointerIdBase = 0;      // Pointer IDs are slot numbers, offset per device
+    int32_t     MinX = 0, MaxX = 0, MinY = 0, MaxY = 0;  // MaxX <= MinX: no axis ranges, raw values are display coordinates
+    int64_t     ReplayTimeOffset = 0;
+    android::detail::EvdevTouchDecoder Decoder;     // Slots and SYN_DROPPED recovery (EvdevTouchDecoder.h)
+};
+static ImGui_ImplAndroid_EvdevDevice            g_EvdevDevices[g_EvdevMaxDevices];
+static int                                      g_EvdevDeviceCount = 0;
+static std::thread                              g_EvdevThread;
+static int                                      g_EvdevWakeFd = -1;
+static std::atomic<int>                         g_EvdevDisplayWidth{0};
+static std::atomic<int>                         g_EvdevDisplayHeight{0};
+static std::atomic<int>                         g_EvdevDisplayRotation{0};
+
+static bool ImGui_ImplAndroid_TestBit(const unsigned long* bits, int bit)
+{
+    return (bits[bit / (8 * sizeof(unsigned long))] >> (bit % (8 * sizeof(unsigned long)))) & 1;
+}
+
+static bool ImGui_ImplAndroid_EvdevOpen(const char* path, bool require_direct, ImGui_ImplAndroid_EvdevDevice* device)
+{
+    *device = ImGui_ImplAndroid_EvdevDevice();
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode))
+    {
+        device->Fd = fd;
+        device->Replay = true;
+        return true;
+    }
+
+    // Multi-touch protocol B touchscreens only (touchpads lack INPUT_PROP_DIRECT)
+    unsigned long abs_bits[(ABS_CNT + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))] = {};
+    unsigned long prop_bits[(INPUT_PROP_CNT + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))] = {};
+    input_absinfo x_info = {}, y_info = {}, slot_info = {};
+    if (ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits) < 0 || ioctl(fd, EVIOCGPROP(sizeof(prop_bits)), prop_bits) < 0 ||
+        !ImGui_ImplAndroid_TestBit(abs_bits, ABS_MT_SLOT) || !ImGui_ImplAndroid_TestBit(abs_bits, ABS_MT_TRACKING_ID) ||
+        !ImGui_ImplAndroid_TestBit(abs_bits, ABS_MT_POSITION_X) || !ImGui_ImplAndroid_TestBit(abs_bits, ABS_MT_POSITION_Y) ||
+        (require_direct && !ImGui_ImplAndroid_TestBit(prop_bits, INPUT_PROP_DIRECT)) ||
+        ioctl(fd, EVIOCGABS(ABS_MT_POSITION_X), &x_info) < 0 || ioctl(fd, EVIOCGABS(ABS_MT_POSITION_Y), &y_info) < 0 ||
+        ioctl(fd, EVIOCGABS(ABS_MT_SLOT), &slot_info) < 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // Same clock as AMotionEvent_getEventTime() (the default is CLOCK_REALTIME)
+    int clock_id = CLOCK_MONOTONIC;
+    ioctl(fd, EVIOCSCLOCKID, &clock_id);
+    device->Fd = fd;
+    device->Decoder = android::detail::EvdevTouchDecoder(slot_info.maximum + 1, android::detail::EvdevTouchDecoder::DeviceSlotQuery(fd));
+    device->MinX = x_info.minimum;
+    device->MaxX = x_info.maximum;
+    device->MinY = y_info.minimum;
+    device->MaxY = y_info.maximum;
+    device->Decoder.Resync();
+    return true;
+}
+
+// Panel coordinates are in the display's natural orientation: rotate them like InputReader does for Surface.ROTATION_*
+static void ImGui_ImplAndroid_EvdevToDisplay(const ImGui_ImplAndroid_EvdevDevice& device, int32_t raw_x, int32_t raw_y, float* out_x, float* out_y)
+{
+    int width = g_EvdevDisplayWidth.load(std::memory_order_relaxed);
+    int height = g_EvdevDisplayHeight.load(std::memory_order_relaxed);
+    if (device.MaxX <= device.MinX || device.MaxY <= device.MinY || width <= 0 || height <= 0)
+    {
+        *out_x = (float)raw_x;
+        *out_y = (float)raw_y;
+        return;
+    }
+    float u = (float)(raw_x - device.MinX) / (float)(device.MaxX - device.MinX);
+    float v = (float)(raw_y - device.MinY) / (float)(device.MaxY - device.MinY);
+    switch (g_EvdevDisplayRotation.load(std::memory_order_relaxed) & 3)
+    {
+    case 0:     *out_x = u * width;             *out_y = v * height;            break;
+    case 1:     *out_x = v * width;             *out_y = (1.0f - u) * height;   break;
+    case 2:     *out_x = (1.0f - u) * width;    *out_y = (1.0f - v) * height;   break;
+    default:    *out_x = (1.0f - v) * width;    *out_y = u * height;            break;
+    }
+}
+
+// Decoded contacts become the records an AMotionEvent with the same pointers would produce
+static void ImGui_ImplAndroid_EvdevPush(const ImGui_ImplAndroid_EvdevDevice& device, const android::detail::EvdevTouchEvent& event)
+{
+    using Kind = android::detail::EvdevTouchEvent::Kind;
+    ImGui_ImplAndroid_InputRecord record = {};
+    record.Type = AINPUT_EVENT_TYPE_MOTION;
+    switch (event.Action)
+    {
+    case Kind::Down:        record.Action = AMOTION_EVENT_ACTION_DOWN; break;
+    case Kind::PointerDown: record.Action = AMOTION_EVENT_ACTION_POINTER_DOWN; break;
+    case Kind::Move:        record.Action = AMOTION_EVENT_ACTION_MOVE; break;
+    case Kind::PointerUp:   record.Action = AMOTION_EVENT_ACTION_POINTER_UP; break;
+    default:                record.Action = AMOTION_EVENT_ACTION_UP; break;
+    }
+    record.ToolType = event.Stylus ? AMOTION_EVENT_TOOL_TYPE_STYLUS : AMOTION_EVENT_TOOL_TYPE_FINGER;
+    record.PointerId = device.PointerIdBase + event.Slot;
+    record.Time = event.TimeNs;
+    record.Continuation = event.Continuation;
+    ImGui_ImplAndroid_EvdevToDisplay(device, event.RawX, event.RawY, &record.X, &record.Y);
+    ImGui_ImplAndroid_PushInputRecord(record);
+}
+
+static void ImGui_ImplAndroid_EvdevProcess(ImGui_ImplAndroid_EvdevDevice* device, const input_event& event)
+{
+    int64_t time_ns = (int64_t)event.input_event_sec * 1000000000 + (int64_t)event.input_event_usec * 1000 + device->ReplayTimeOffset;
+    device->Decoder.Process(event, time_ns, [device](const android::detail::EvdevTouchEvent& touch_event) { ImGui_ImplAndroid_EvdevPush(*device, touch_event); });
+}
+
+// Recorded events are replayed at their original pace, shifted to the current time
+static void ImGui_ImplAndroid_EvdevReplay(ImGui_ImplAndroid_EvdevDevice* device, int epoll_fd)
+{
+    input_event event;
+    int64_t start_time = 0;
+    struct timespec current_timespec;
+    while (!g_EvdevThreadStop.load(std::memory_order_acquire) && read(device->Fd, &event, sizeof(event)) == (ssize_t)sizeof(event))
+    {
+        int64_t event_time = (int64_t)event.input_event_sec * 1000000000 + (int64_t)event.input_event_usec * 1000;
+        clock_gettime(CLOCK_MONOTONIC, &current_timespec);
+        int64_t current_time = (int64_t)current_timespec.tv_sec * 1000000000 + current_timespec.tv_nsec;
+        if (start_time == 0)
+        {
+            start_time = current_time;
+            device->ReplayTimeOffset = current_time - event_time;
+        }
+        int64_t wait_ns = event_time + device->ReplayTimeOffset - current_time;
+        epoll_event ready;
+        if (wait_ns > 1000000 && epoll_wait(epoll_fd, &ready, 1, (int)(wait_ns / 1000000)) > 0)
+            break; // Woken by StopEvdevThread()
+        ImGui_ImplAndroid_EvdevProcess(device, event);
+    }
+}
+
+static void ImGui_ImplAndroid_EvdevClose(ImGui_ImplAndroid_EvdevDevice* device, int epoll_fd)
+{
+    __android_log_print(ANDROID_LOG_WARN, g_LogTag, "Input device %d gone, no longer read", (int)(device - g_EvdevDevices));
+    struct timespec current_timespec;
+    clock_gettime(CLOCK_MONOTONIC, &current_timespec);
+    int64_t current_time = (int64_t)current_timespec.tv_sec * 1000000000 + current_timespec.tv_nsec;
+    device->Decoder.ReleaseAll(current_time, [device](const android::detail::EvdevTouchEvent& touch_event) { ImGui_ImplAndroid_EvdevPush(*device, touch_event); });
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, device->Fd, nullptr);
+    close(device->Fd);
+    device->Fd = -1;
+}
 
-    return 0;
+static void ImGui_ImplAndroid_EvdevThreadMain(int epoll_fd)
+{
+    if (g_EvdevDevices[0].Replay)
+    {
+        ImGui_ImplAndroid_EvdevReplay(&g_EvdevDevices[0], epoll_fd);
+        return;
+    }
+
+    // Contacts already down when the thread starts
+    for (int device_n = 0; device_n < g_EvdevDeviceCount; device_n++)
+    {
+        ImGui_ImplAndroid_EvdevDevice* device = &g_EvdevDevices[device_n];
+        device->Decoder.Report(0, [device](const android::detail::EvdevTouchEvent& touch_event) { ImGui_ImplAndroid_EvdevPush(*device, touch_event); });
+    }
+
+    input_event events[64];
+    epoll_event ready[g_EvdevMaxDevices + 1];
+    while (!g_EvdevThreadStop.load(std::memory_order_acquire))
+    {
+        int ready_count = epoll_wait(epoll_fd, ready, IM_ARRAYSIZE(ready), g_InputRing.OverflowMoveCount > 0 ? 1 : -1);
+        ImGui_ImplAndroid_FlushOverflowMoves();
+        for (int ready_n = 0; ready_n < ready_count; ready_n++)
+        {
+            if (ready[ready_n].data.u32 >= (uint32_t)g_EvdevDeviceCount)
+                continue; // Wake fd: the loop condition decides
+            ImGui_ImplAndroid_EvdevDevice* device = &g_EvdevDevices[ready[ready_n].data.u32];
+            if (device->Fd < 0)
+                continue; // Closed earlier in this batch
+            ssize_t size;
+            while ((size = read(device->Fd, events, sizeof(events))) > 0)
+                for (size_t event_n = 0; event_n < (size_t)size / sizeof(input_event); event_n++)
+                    ImGui_ImplAndroid_EvdevProcess(device, events[event_n]);
+
+            // Unplugged (ENODEV) or otherwise failing: the fd would stay ready and spin epoll_wait(), drop it
+            bool failed = (size < 0 && errno != EAGAIN && errno != EINTR) || size == 0;
+            if (failed || (ready[ready_n].events & (EPOLLHUP | EPOLLERR)))
+                ImGui_ImplAndroid_EvdevClose(device, epoll_fd);
+        }
+    }
+}
+
+void ImGui_ImplAndroid_SetEvdevDisplay(int width, int height, int rotation)
+{
+    g_EvdevDisplayWidth.store(width, std::memory_order_relaxed);
+    g_EvdevDisplayHeight.store(height, std::memory_order_relaxed);
+    g_EvdevDisplayRotation.store(rotation, std::memory_order_relaxed);
+}
+
+bool ImGui_ImplAndroid_StartEvdevThread(const char* device_path)
+{
+    ImGui_ImplAndroid_StopInputThread(); // g_InputRing has a single producer
+    ImGui_ImplAndroid_StopEvdevThread();
+
+    if (device_path != nullptr)
+    {
+        if (ImGui_ImplAndroid_EvdevOpen(device_path, false, &g_EvdevDevices[0]))
+            g_EvdevDeviceCount = 1;
+    }
+    else if (DIR* input_dir = opendir("/dev/input"))
+    {
+        while (dirent* entry = readdir(input_dir))
+        {
+            if (strncmp(entry->d_name, "event", 5) != 0 || g_EvdevDeviceCount == g_EvdevMaxDevices)
+                continue;
+            char path[sizeof("/dev/input/") + sizeof(entry->d_name)];
+            snprintf(path, sizeof(path), "/dev/input/%s", entry->d_name);
+            if (!ImGui_ImplAndroid_EvdevOpen(path, true, &g_EvdevDevices[g_EvdevDeviceCount]))
+                continue;
+            g_EvdevDevices[g_EvdevDeviceCount].PointerIdBase = g_EvdevDeviceCount * g_EvdevMaxSlots;
+            g_EvdevDeviceCount++;
+        }
+        closedir(input_dir);
+    }
+    if (g_EvdevDeviceCount == 0)
+    {
+        __android_log_print(ANDROID_LOG_WARN, g_LogTag, "No multi-touch input device found under %s", device_path != nullptr ? device_path : "/dev/input");
+        return false;
+    }
+
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    g_EvdevWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_event watch = {};
+    watch.events = EPOLLIN;
+    watch.data.u32 = (uint32_t)g_EvdevMaxDevices;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, g_EvdevWakeFd, &watch);
+    for (int device_n = 0; device_n < g_EvdevDeviceCount; device_n++)
+    {
+        if (g_EvdevDevices[device_n].Replay)
+            continue;
+        watch.data.u32 = (uint32_t)device_n;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, g_EvdevDevices[device_n].Fd, &watch);
+    }
+    g_EvdevThreadStop.store(false, std::memory_order_release);
+    g_EvdevThread = std::thread([epoll_fd]() {
+        ImGui_ImplAndroid_EvdevThreadMain(epoll_fd);
+        close(epoll_fd);
+    });
+    return true;
+}
+
+void ImGui_ImplAndroid_StopEvdevThread()
+{
+    if (g_EvdevThread.joinable())
+    {
+        g_EvdevThreadStop.store(true, std::memory_order_release);
+        uint64_t wake = 1;
+        if (write(g_EvdevWakeFd, &wake, sizeof(wake)) < 0)
+            __android_log_print(ANDROID_LOG_ERROR, g_LogTag, "Failed to wake the evdev thread");
+        g_EvdevThread.join();
+        g_EvdevThreadStop.store(false, std::memory_order_release); // Same as g_InputThreadStop: an input thread started next must not see it
+        g_InputRing.OverflowMoveCount = 0;
+    }
+    if (g_EvdevWakeFd >= 0)
+        close(g_EvdevWakeFd);
+    g_EvdevWakeFd = -1;
+    for (int device_n = 0; device_n < g_EvdevDeviceCount; device_n++)
+    {
+        if (g_EvdevDevices[device_n].Fd >= 0)
+            close(g_EvdevDevices[device_n].Fd);
+        g_EvdevDevices[device_n].Fd = -1;
+    }
+    g_EvdevDeviceCount = 0;
 }
 
 bool ImGui_ImplAndroid_Init(ANativeWindow* window)
@@ -279,6 +1168,115 @@ void ImGui_ImplAndroid_Shutdown()
 {
     ImGuiIO& io = ImGui::GetIO();
     io.BackendPlatformName = nullptr;
+
+    ImGui_ImplAndroid_StopInputThread();
+    ImGui_ImplAndroid_StopEvdevThread();
+    g_InputWakeLooper.store(nullptr, std::memory_order_release);
+    ImGui_ImplAndroid_InputRecord record;
+    while (g_InputRing.Pop(&record)) {}
+    g_InputRing.Dropped.store(0, std::memory_order_relaxed);
+    g_MotionSamples.clear();
+    g_FrameMotionSamples.clear();
+    g_HasPendingMousePos = false;
+    g_MouseSource = ImGuiMouseSource_COUNT;
+    g_InputStats = ImGui_ImplAndroid_InputStats();
+    {
+        std::lock_guard<std::mutex> lock(g_ImeMutex);
+        g_ImeCommits.clear();
+        g_ImeCommitText.clear();
+        g_ImeComposition.clear();
+        g_ImeCompositionCursor = -1;
+        g_ImeCompositionChanged = false;
+    }
+    g_ImePending.store(false, std::memory_order_relaxed);
+    io.SetInputComposition(nullptr);
+    g_PendingInputTime = g_FrameInputTime = 0;
+    g_Touches.clear();
+    g_PrimaryPointerId = -1;
+    g_Gestures = ImGui_ImplAndroid_Gestures();
+    g_GesturePointerIds[0] = g_GesturePointerIds[1] = -1;
+    g_PredictionCount = 0;
+    g_MousePosPredicted = false;
+}
+
+const ImGui_ImplAndroid_MotionSample* ImGui_ImplAndroid_GetFrameMotionSamples(int* out_count)
+{
+    *out_count = g_FrameMotionSamples.Size;
+    return g_FrameMotionSamples.Data;
+}
+
+// Per-frame deltas from the first two touches; a different pair (finger lifted/added) restarts without a jump
+static void ImGui_ImplAndroid_UpdateGestures(const ImGuiIO& io)
+{
+    ImGui_ImplAndroid_Gestures& gestures = g_Gestures;
+    gestures.PinchScale = 1.0f;
+    gestures.PanDelta = ImVec2(0.0f, 0.0f);
+    gestures.LongPress = false;
+
+    if (g_Touches.Size >= 2)
+    {
+        ImVec2 a = g_Touches[0].Pos, b = g_Touches[1].Pos;
+        ImVec2 center((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f);
+        float distance = sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+        bool same_pair = g_GesturePointerIds[0] == g_Touches[0].Id && g_GesturePointerIds[1] == g_Touches[1].Id;
+        if (same_pair && g_GestureDistance > 0.0f && distance > 0.0f)
+        {
+            gestures.PinchScale = distance / g_GestureDistance;
+            gestures.PanDelta = ImVec2(center.x - g_GestureCenter.x, center.y - g_GestureCenter.y);
+        }
+        gestures.Active = true;
+        gestures.Center = center;
+        g_GesturePointerIds[0] = g_Touches[0].Id;
+        g_GesturePointerIds[1] = g_Touches[1].Id;
+        g_GestureDistance = distance;
+        g_GestureCenter = center;
+    }
+    else
+    {
+        gestures.Active = false;
+        g_GesturePointerIds[0] = g_GesturePointerIds[1] = -1;
+    }
+
+    // Long-press: a single finger held still (within the drag threshold), reported once
+    if (g_Touches.Size == 1)
+    {
+        ImGui_ImplAndroid_TouchPoint& touch = g_Touches[0];
+        ImVec2 delta(touch.Pos.x - touch.StartPos.x, touch.Pos.y - touch.StartPos.y);
+        if (!touch.LongPressed && g_Time - touch.DownTime >= g_LongPressTime && delta.x * delta.x + delta.y * delta.y <= io.MouseDragThreshold * io.MouseDragThreshold)
+        {
+            touch.LongPressed = true;
+            gestures.LongPress = true;
+            gestures.LongPressPos = touch.Pos;
+        }
+    }
+}
+
+void ImGui_ImplAndroid_SetTouchPrediction(float lead_time)
+{
+    g_PredictionLeadTime = lead_time > 0.0f ? lead_time : 0.0f;
+}
+
+const ImGui_ImplAndroid_TouchPoint* ImGui_ImplAndroid_GetTouches(int* out_count)
+{
+    *out_count = g_Touches.Size;
+    return g_Touches.Data;
+}
+
+const ImGui_ImplAndroid_Gestures& ImGui_ImplAndroid_GetGestures()
+{
+    return g_Gestures;
+}
+
+int64_t ImGui_ImplAndroid_GetFrameInputTimeNs()
+{
+    return g_FrameInputTime;
+}
+
+ImGui_ImplAndroid_InputStats ImGui_ImplAndroid_GetInputStats()
+{
+    ImGui_ImplAndroid_InputStats stats = g_InputStats;
+    stats.EventsDropped = g_InputRing.Dropped.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void ImGui_ImplAndroid_NewFrame()
@@ -301,6 +1299,51 @@ void ImGui_ImplAndroid_NewFrame()
     double current_time = (double)(current_timespec.tv_sec) + (current_timespec.tv_nsec / 1000000000.0);
     io.DeltaTime = g_Time > 0.0 ? (float)(current_time - g_Time) : (float)(1.0f / 60.0f);
     g_Time = current_time;
+
+    // Apply what the input thread read since the last frame, in order and interleaved with IME commits by timestamp,
+    // then forward the last coalesced move and publish this frame's samples
+    ImGui_ImplAndroid_InputRecord record;
+    while (g_InputRing.Pop(&record))
+    {
+        ImGui_ImplAndroid_ApplyIme(io, record.Time, false);
+        ImGui_ImplAndroid_ProcessInputRecord(record);
+    }
+
+    // IME: commits made after the last event, followed by the latest composition (which no longer includes them)
+    ImGui_ImplAndroid_ApplyIme(io, INT64_MAX, true);
+    ImGui_ImplAndroid_FlushMousePos(io);
+    ImGui_ImplAndroid_UpdateGestures(io);
+
+    // Drag prediction: only while the primary finger drags alone, the real position is given back as soon as it stops applying
+    // (releases are always sent at the real position, see AMOTION_EVENT_ACTION_UP)
+    ImGui_ImplAndroid_TouchPoint* primary_touch = g_Touches.Size == 1 ? ImGui_ImplAndroid_FindTouch(g_PrimaryPointerId) : nullptr;
+    ImVec2 predicted_pos;
+    bool dragging = false;
+    if (primary_touch != nullptr)
+    {
+        float dx = primary_touch->Pos.x - primary_touch->StartPos.x;
+        float dy = primary_touch->Pos.y - primary_touch->StartPos.y;
+        dragging = dx * dx + dy * dy > io.MouseDragThreshold * io.MouseDragThreshold;
+    }
+    if (g_PredictionLeadTime > 0.0f && dragging && g_MouseSource == ImGuiMouseSource_TouchScreen && ImGui_ImplAndroid_PredictMousePos(g_Time + g_PredictionLeadTime, &predicted_pos))
+    {
+        io.AddMousePosEvent(predicted_pos.x, predicted_pos.y);
+        g_InputStats.EventsForwarded++;
+        g_MousePosPredicted = true;
+    }
+    else if (g_MousePosPredicted)
+    {
+        if (primary_touch != nullptr)
+        {
+            io.AddMousePosEvent(primary_touch->Pos.x, primary_touch->Pos.y);
+            g_InputStats.EventsForwarded++;
+        }
+        g_MousePosPredicted = false;
+    }
+    g_FrameInputTime = g_PendingInputTime;
+    g_PendingInputTime = 0;
+    g_FrameMotionSamples.swap(g_MotionSamples);
+    g_MotionSamples.resize(0);
 }
 
 //-----------------------------------------------------------------------------
@@ -23,10 +23,13 @@
 
 #pragma once
 #include "imgui.h"      // IMGUI_IMPL_API
+#include <stdint.h>     // int32_t, int64_t
 #ifndef IMGUI_DISABLE
 
 struct ANativeWindow;
 struct AInputEvent;
+struct AInputQueue;
+struct ALooper;
 
 // Follow "Getting Started" link and check examples/ folder to learn about using backends!
 IMGUI_IMPL_API bool     ImGui_ImplAndroid_Init(ANativeWindow* window);
@@ -34,4 +37,95 @@ IMGUI_IMPL_API int32_t  ImGui_ImplAndroid_HandleInputEvent(const AInputEvent* in
 IMGUI_IMPL_API void     ImGui_ImplAndroid_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplAndroid_NewFrame();
 
+// Move events are coalesced: one io.AddMousePosEvent() per burst of moves. Every sample, including the historical ones
+// Android batches from high-rate touch panels, received before the last NewFrame() stays available for drawing/gestures.
+struct ImGui_ImplAndroid_MotionSample
+{
+    float   X, Y;
+    double  Time;               // Seconds, CLOCK_MONOTONIC (same clock as AMotionEvent_getEventTime())
+};
+struct ImGui_ImplAndroid_InputStats
+{
+    int     EventsReceived;     // Key and motion events passed to ImGui_ImplAndroid_HandleInputEvent()
+    int     SamplesReceived;    // Motion samples, including historical ones
+    int     EventsForwarded;    // io.AddXXXEvent() calls
+    int     EventsDropped;      // Move records coalesced or dropped (batched history) because the input thread ring was full. Transitions are never dropped.
+};
+IMGUI_IMPL_API const ImGui_ImplAndroid_MotionSample* ImGui_ImplAndroid_GetFrameMotionSamples(int* out_count);
+IMGUI_IMPL_API ImGui_ImplAndroid_InputStats          ImGui_ImplAndroid_GetInputStats();   // Totals since ImGui_ImplAndroid_Init()
+IMGUI_IMPL_API int64_t                               ImGui_ImplAndroid_GetFrameInputTimeNs(); // Event time (CLOCK_MONOTONIC ns) of the oldest key/motion event applied by the last NewFrame(), 0 if none
+
+// Multi-touch: active fingers (in order of going down) and gestures recognized at the last NewFrame().
+// The first finger drives the mouse while it is alone; during a two-finger gesture the mouse stays where it was.
+struct ImGui_ImplAndroid_TouchPoint
+{
+    int     Id;                 // AMotionEvent_getPointerId()
+    ImVec2  Pos;
+    ImVec2  StartPos;
+    double  DownTime;           // Seconds, CLOCK_MONOTONIC
+    bool    LongPressed;
+};
+struct ImGui_ImplAndroid_Gestures
+{
+    bool    Active;             // Two fingers down
+    ImVec2  Center;             // Midpoint of the two fingers
+    float   PinchScale;         // Distance ratio since the previous frame (1.0f: no change), multiply into a zoom factor
+    ImVec2  PanDelta;           // Midpoint movement since the previous frame
+    bool    LongPress;          // Set for the one frame where a single still finger passed the long-press delay
+    ImVec2  LongPressPos;
+};
+IMGUI_IMPL_API const ImGui_ImplAndroid_TouchPoint*   ImGui_ImplAndroid_GetTouches(int* out_count);
+IMGUI_IMPL_API const ImGui_ImplAndroid_Gestures&     ImGui_ImplAndroid_GetGestures();
+
+// (Optional) Drag prediction: while a single finger drags (moved past io.MouseDragThreshold), the mouse position given to Dear ImGui
+// is extrapolated 'lead_time' seconds past NewFrame() (~ the expected present time) from the least-squares velocity of the last 50 ms
+// of samples, at most 50 ms ahead. Taps, releases and a resting finger always use the real position. 0.0f (default): disabled.
+IMGUI_IMPL_API void     ImGui_ImplAndroid_SetTouchPrediction(float lead_time);
+
+// (Optional) Read 'input_queue' on a dedicated thread instead of the caller's looper, so input is picked up and finished while a frame
+// renders. Events keep their AMotionEvent_getEventTime() timestamps and are applied in order at the start of ImGui_ImplAndroid_NewFrame().
+// When NewFrame() doesn't keep up and the 4096 records ring fills, moves are coalesced per pointer and the thread waits for room
+// for touch, button and key transitions, which are never dropped.
+// ImGui_ImplAndroid_StopInputThread() detaches the queue from the thread's looper before returning, so it must be called while the
+// queue is still alive. With android_native_app_glue, the old queue may be destroyed as soon as the glue's android_app_pre_exec_cmd()
+// ran for APP_CMD_INPUT_CHANGED: stop before it (see process_app_cmd() in main.cpp), then start again with the new queue from onAppCmd.
+IMGUI_IMPL_API bool     ImGui_ImplAndroid_StartInputThread(AInputQueue* input_queue);
+IMGUI_IMPL_API void     ImGui_ImplAndroid_StopInputThread();
+
+// (Optional) ALooper_wake() 'looper' whenever the input or evdev thread queues input, so a main loop that idles in ALooper_pollAll() with a
+// timeout (e.g. while ImGuiContext::QuiescentFrames > 0) renders the next frame as soon as there is input to apply. nullptr (default): none.
+// Input read on the caller's looper (ImGui_ImplAndroid_HandleInputEvent()) wakes ALooper_pollAll() by itself.
+IMGUI_IMPL_API void     ImGui_ImplAndroid_SetInputWakeLooper(ALooper* looper);
+
+// (Optional) IME bridge. Android only hands text from input methods to an InputConnection (Java), so the application forwards it here,
+// from any thread. Commits are timestamped (CLOCK_MONOTONIC) when AddImeText() is called and reach io.AddInputCharactersUTF8() in event
+// time order with key and touch events, so "commit, then backspace" is not applied as "backspace, then commit".
+// The composition (pre-edit) string goes to io.SetInputComposition() and is drawn at the InputText() cursor until it is committed.
+// - AddImeText(): committed text (InputConnection.commitText(), or KeyEvent.getCharacters() of an AKEY_EVENT_ACTION_MULTIPLE event).
+// - SetImeComposition(): current composing text, 'cursor' a byte offset in it (-1: end). nullptr or "" when composing ends.
+// The InputText() being deactivated clears the composition on the Dear ImGui side (io.SetInputComposition(nullptr)) but not in the IME.
+// Forwarding, e.g. from a View in the NativeActivity's window that returns a BaseInputConnection subclass from onCreateInputConnection(),
+// through JNI 'native' methods that convert the jstring with GetStringUTFChars() and call these two:
+// - commitText(text): AddImeText(text). setComposingText(text, pos): SetImeComposition(text), with the Java char index converted to bytes.
+//   finishComposingText(): AddImeText() of the last composition, then SetImeComposition(nullptr).
+// - dispatchKeyEvent() of an ACTION_MULTIPLE KEYCODE_UNKNOWN event: AddImeText(event.getCharacters()). Other key events keep reaching the
+//   AInputQueue and ImGui_ImplAndroid_HandleInputEvent() (backspace, arrows, enter).
+// - Show the soft keyboard (InputMethodManager.showSoftInput()) while io.WantTextInput is true and hide it when it goes false; when it goes
+//   false, also call InputMethodManager.restartInput() so the IME drops its composition along with the deactivated InputText().
+IMGUI_IMPL_API void     ImGui_ImplAndroid_AddImeText(const char* utf8);
+IMGUI_IMPL_API void     ImGui_ImplAndroid_SetImeComposition(const char* utf8, int cursor = -1);
+
+// (Optional) Read touchscreens straight from /dev/input/event* (multi-touch protocol B) on a dedicated thread, for processes that get no
+// AInputQueue or don't want the extra hop through the system input dispatcher. Needs read access to /dev/input (root or the input group).
+// Contacts become the same records as AMotionEvent pointers (kernel timestamps, CLOCK_MONOTONIC) and are applied in NewFrame().
+// - 'device_path' nullptr: every direct-touch multi-touch device under /dev/input. Otherwise that one device, or a regular file of raw
+//   'struct input_event' records (e.g. captured with 'cat /dev/input/eventN > file'), replayed once at its recorded pace.
+// - Replaces ImGui_ImplAndroid_StartInputThread() (and vice versa). Events also still delivered through an AInputQueue would count twice.
+// - A device that is unplugged or fails is closed and its contacts lifted. Start again to pick up new devices.
+// - Panel coordinates are mapped to a 'width' x 'height' display in its current orientation, 'rotation' in Surface.ROTATION_* quarter
+//   turns from the natural orientation. Update it on every rotation. Until it is set, raw panel coordinates are passed through.
+IMGUI_IMPL_API bool     ImGui_ImplAndroid_StartEvdevThread(const char* device_path = nullptr);
+IMGUI_IMPL_API void     ImGui_ImplAndroid_StopEvdevThread();
+IMGUI_IMPL_API void     ImGui_ImplAndroid_SetEvdevDisplay(int width, int height, int rotation);
+
 #endif // #ifndef IMGUI_DISABLE
@@ -7,6 +7,9 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture as texture identifier. Read the FAQ about ImTextureID/ImTextureRef!
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: ImTextureFormat_Alpha8 textures (e.g. 'io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8') stored as GL_R8 on GL 3.3+/ES 3.0+.
+//  [X] Renderer: Signed distance field text for ImFontFlags_SDF fonts (ImGuiBackendFlags_RendererHasSdfText) [GLSL 130+/ES 3.0+ only!]
+//  [X] Renderer: Rotated output (ImGui_ImplOpenGL3_SetDisplayRotation), e.g. to pre-rotate into a fixed-size surface on device rotation.
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -23,6 +26,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-19: OpenGL: Added ImGui_ImplOpenGL3_SetDisplayRotation(): projection matrix and scissor rectangles rotate the frame by quarter turns into the framebuffer.
+//  2026-10-19: OpenGL: Added support for ImGuiBackendFlags_RendererHasSdfText: ImDrawCallback_SdfTextBegin/End toggle a distance-to-coverage path in the fragment shader.
+//  2026-10-19: OpenGL: Support ImTextureFormat_Alpha8 textures: uploaded as GL_R8 and swizzled to white-with-alpha on GL 3.3+/ES 3.0+, expanded to RGBA32 on upload otherwise.
 //  2025-12-11: OpenGL: Fixed embedded loader multiple init/shutdown cycles broken on some platforms. (#8792, #9112)
 //  2025-09-18: Call platform_io.ClearRendererHandlers() on shutdown.
 //  2025-07-22: OpenGL: Add and call embedded loader shutdown during ImGui_ImplOpenGL3_Shutdown() to facilitate multiple init/shutdown cycles in same process. (#8792)
@@ -219,6 +225,11 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0+ have GL_R8 textures and GL_TEXTURE_SWIZZLE_XXX
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && defined(GL_TEXTURE_SWIZZLE_R) && defined(GL_R8)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -241,6 +252,7 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationSdfText;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -250,7 +262,9 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasPolygonMode;
     bool            HasBindSampler;
     bool            HasClipOrigin;
+    bool            HasTextureSwizzle;
     bool            UseBufferSubData;
+    int             DisplayRotation;         // Quarter turns clockwise, see ImGui_ImplOpenGL3_SetDisplayRotation()
     ImVector<char>  TempBuffer;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
@@ -399,6 +413,12 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     strcpy(bd->GlslVersionString, glsl_version);
     strcat(bd->GlslVersionString, "\n");
 
+    // Distance field text needs fwidth(), which GLSL 100/120 don't have without extensions
+    int glsl_version_num = 130;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_num);
+    if (glsl_version_num >= 130)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfText;    // We can honor ImDrawCallback_SdfTextBegin/ImDrawCallback_SdfTextEnd.
+
     // Make an arbitrary GL call (we don't actually need the result)
     // IF YOU GET A CRASH HERE: it probably means the OpenGL function loader didn't do its job. Let us know!
     GLint current_texture;
@@ -412,6 +432,9 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasBindSampler = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    bd->HasTextureSwizzle = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -437,7 +460,7 @@ void    ImGui_ImplOpenGL3_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasSdfText);
     platform_io.ClearRendererHandlers();
     IM_DELETE(bd);
 
@@ -455,6 +478,26 @@ void    ImGui_ImplOpenGL3_NewFrame()
             IM_ASSERT(0 && "ImGui_ImplOpenGL3_CreateDeviceObjects() failed!");
 }
 
+void ImGui_ImplOpenGL3_SetDisplayRotation(int quarter_turns)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->DisplayRotation = ((quarter_turns % 4) + 4) % 4;
+}
+
+// Map a clip rectangle from display space (width x height) into the framebuffer rotated clockwise by 'rotation' quarter turns
+static void ImGui_ImplOpenGL3_RotateClipRect(int rotation, float width, float height, ImVec2* clip_min, ImVec2* clip_max)
+{
+    ImVec2 min = *clip_min, max = *clip_max;
+    switch (rotation)
+    {
+    case 1: *clip_min = ImVec2(height - max.y, min.x);        *clip_max = ImVec2(height - min.y, max.x);        break;
+    case 2: *clip_min = ImVec2(width - max.x, height - max.y); *clip_max = ImVec2(width - min.x, height - min.y); break;
+    case 3: *clip_min = ImVec2(min.y, width - max.x);         *clip_max = ImVec2(max.y, width - min.x);         break;
+    default: break;
+    }
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -489,7 +532,11 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 
     // Setup viewport, orthographic projection matrix
     // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
-    GL_CALL(glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
+    // fb_width/fb_height are in display (unrotated) orientation, the framebuffer itself is rotated by bd->DisplayRotation
+    if (bd->DisplayRotation & 1)
+        GL_CALL(glViewport(0, 0, (GLsizei)fb_height, (GLsizei)fb_width));
+    else
+        GL_CALL(glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
     float L = draw_data->DisplayPos.x;
     float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
     float T = draw_data->DisplayPos.y;
@@ -497,16 +544,26 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #if defined(GL_CLIP_ORIGIN)
     if (!clip_origin_lower_left) { float tmp = T; T = B; B = tmp; } // Swap top and bottom if origin is upper left
 #endif
-    const float ortho_projection[4][4] =
+    float ortho_projection[4][4] =
     {
         { 2.0f/(R-L),   0.0f,         0.0f,   0.0f },
         { 0.0f,         2.0f/(T-B),   0.0f,   0.0f },
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
+    // Rotate clip space clockwise: (x, y) -> (y, -x) per quarter turn
+    for (int turn = 0; turn < (bd->DisplayRotation & 3); turn++)
+        for (int column = 0; column < 4; column++)
+        {
+            float x = ortho_projection[column][0];
+            ortho_projection[column][0] = ortho_projection[column][1];
+            ortho_projection[column][1] = -x;
+        }
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    if (bd->AttribLocationSdfText != -1)
+        glUniform1i(bd->AttribLocationSdfText, 0);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->HasBindSampler)
@@ -644,8 +701,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             {
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                // (ImDrawCallback_SdfTextBegin/End are emitted by ImFont around distance field glyphs.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                else if (pcmd->UserCallback == ImDrawCallback_SdfTextBegin || pcmd->UserCallback == ImDrawCallback_SdfTextEnd)
+                    glUniform1i(bd->AttribLocationSdfText, pcmd->UserCallback == ImDrawCallback_SdfTextBegin ? 1 : 0);
                 else
                     pcmd->UserCallback(draw_list, pcmd);
             }
@@ -657,8 +717,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
+                // Rotate into framebuffer orientation (top-left origin)
+                if (bd->DisplayRotation != 0)
+                    ImGui_ImplOpenGL3_RotateClipRect(bd->DisplayRotation, (float)fb_width, (float)fb_height, &clip_min, &clip_max);
+                const float fb_rotated_height = (bd->DisplayRotation & 1) ? (float)fb_width : (float)fb_height;
+
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                GL_CALL(glScissor((int)clip_min.x, (int)(fb_rotated_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
 
                 // Bind texture, Draw
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
@@ -727,6 +792,31 @@ static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+// Alpha8 textures are stored as GL_R8 and swizzled to (1,1,1,R) when the context supports it: this is 4x less memory/bandwidth for the font atlas.
+// Without swizzle support (GL ES 2, GL < 3.3) we expand them to RGBA32 on upload, so only the CPU-side copy benefits.
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+static bool ImGui_ImplOpenGL3_TextureUseR8(ImTextureData* tex)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    return tex->Format == ImTextureFormat_Alpha8 && bd->HasTextureSwizzle;
+}
+#endif
+
+// Copy a region of an Alpha8 texture into bd->TempBuffer as white-with-alpha RGBA32 pixels.
+static const void* ImGui_ImplOpenGL3_ExpandAlpha8(ImTextureData* tex, int x, int y, int w, int h)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    bd->TempBuffer.resize(w * h * 4);
+    ImU32* out_p = (ImU32*)(void*)bd->TempBuffer.Data;
+    for (int ny = 0; ny < h; ny++)
+    {
+        const unsigned char* src_p = (const unsigned char*)tex->GetPixelsAt(x, y + ny);
+        for (int nx = 0; nx < w; nx++)
+            *out_p++ = IM_COL32(255, 255, 255, src_p[nx]);
+    }
+    return bd->TempBuffer.Data;
+}
+
 void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 {
     // FIXME: Consider backing up and restoring
@@ -745,7 +835,7 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == 0 && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
         const void* pixels = tex->GetPixels();
         GLuint gl_texture_id = 0;
 
@@ -759,7 +849,22 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->Width, tex->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        if (ImGui_ImplOpenGL3_TextureUseR8(tex))
+        {
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+            GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+            GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, tex->Width, tex->Height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+        }
+        else
+#endif
+        {
+            if (tex->Format == ImTextureFormat_Alpha8)
+                pixels = ImGui_ImplOpenGL3_ExpandAlpha8(tex, 0, 0, tex->Width, tex->Height);
+            GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->Width, tex->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
 
         // Store identifiers
         tex->SetTexID((ImTextureID)(intptr_t)gl_texture_id);
@@ -777,25 +882,39 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
-#if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
-        for (ImTextureRect& r : tex->Updates)
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-#else
-        // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
-        ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-        for (ImTextureRect& r : tex->Updates)
+        GLenum gl_format = GL_RGBA;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        if (ImGui_ImplOpenGL3_TextureUseR8(tex))
+            gl_format = GL_RED;
+#endif
+        if (tex->Format == ImTextureFormat_Alpha8 && gl_format == GL_RGBA)
         {
-            const int src_pitch = r.w * tex->BytesPerPixel;
-            bd->TempBuffer.resize(r.h * src_pitch);
-            char* out_p = bd->TempBuffer.Data;
-            for (int y = 0; y < r.h; y++, out_p += src_pitch)
-                memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
-            IM_ASSERT(out_p == bd->TempBuffer.end());
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
+            // No GL_R8 support: expand each updated block to RGBA32.
+            for (ImTextureRect& r : tex->Updates)
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, ImGui_ImplOpenGL3_ExpandAlpha8(tex, r.x, r.y, r.w, r.h)));
         }
+        else
+        {
+#if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
+            for (ImTextureRect& r : tex->Updates)
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#else
+            // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
+            ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+            for (ImTextureRect& r : tex->Updates)
+            {
+                const int src_pitch = r.w * tex->BytesPerPixel;
+                bd->TempBuffer.resize(r.h * src_pitch);
+                char* out_p = bd->TempBuffer.Data;
+                for (int y = 0; y < r.h; y++, out_p += src_pitch)
+                    memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
+                IM_ASSERT(out_p == bd->TempBuffer.end());
+                GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
+            }
 #endif
+        }
         tex->SetStatus(ImTextureStatus_OK);
         GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
     }
@@ -934,33 +1053,48 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform bool SdfText;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    float w = max(fwidth(tex.a), 0.0001);\n"
+        "    if (SdfText)\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool SdfText;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    float w = max(fwidth(tex.a), 0.0001);\n"
+        "    if (SdfText)\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform bool SdfText;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    float w = max(fwidth(tex.a), 0.0001);\n"
+        "    if (SdfText)\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -1019,6 +1153,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationSdfText = glGetUniformLocation(bd->ShaderHandle, "SdfText"); // -1 with GLSL 120/100 shaders
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -43,6 +43,10 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = nullptr to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex);
 
+// (Advanced) Rotate the rendered frame clockwise by 'quarter_turns' into the framebuffer (viewport, projection and scissor).
+// ImDrawData::DisplaySize stays in display orientation; the framebuffer is expected to be DisplaySize swapped for odd turns.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetDisplayRotation(int quarter_turns);
+
 // Configuration flags to add in your imconfig file:
 //#define IMGUI_IMPL_OPENGL_ES2     // Enable ES 2 (Auto-detected on Emscripten)
 //#define IMGUI_IMPL_OPENGL_ES3     // Enable ES 3 (Auto-detected on iOS/Android)
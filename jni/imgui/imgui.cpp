@@ -1310,6 +1310,7 @@ static ImGuiWindow*     CreateNewWindow(const char* name, ImGuiWindowFlags flags
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window);
 
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
+static void             HitTestGridUpdateWindow(ImGuiWindow* window);
 
 // Settings
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
@@ -1714,6 +1715,19 @@ void ImGuiIO::AddInputCharactersUTF8(const char* str)
     }
 }
 
+// Not an event: takes effect immediately, the composition is only displayed (see InputTextEx()) and replaced as a whole on every change.
+void ImGuiIO::SetInputComposition(const char* str, int cursor)
+{
+    InputComposition.resize(0);
+    InputCompositionCursor = 0;
+    if (str == NULL || str[0] == 0)
+        return;
+    const int len = (int)strlen(str);
+    InputComposition.resize(len + 1);
+    memcpy(InputComposition.Data, str, (size_t)len + 1);
+    InputCompositionCursor = (cursor < 0 || cursor > len) ? len : cursor;
+}
+
 // Clear all incoming events.
 void ImGuiIO::ClearEventsQueue()
 {
@@ -4125,6 +4139,7 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
 
     InputEventsNextMouseSource = ImGuiMouseSource_Mouse;
     InputEventsNextEventId = 1;
+    QuiescentFrames = 0;
 
     WindowsActiveCount = 0;
     WindowsBorderHoverPadding = 0.0f;
@@ -4167,6 +4182,8 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     LastActiveIdTimer = 0.0f;
 
     LastKeyboardKeyPressTime = LastKeyModsChangeTime = LastKeyModsChangeFromNoneTime = -1.0;
+    KeysQuiescent = false;
+    KeysQuiescentSkip = true;
 
     ActiveIdUsingNavDirMask = 0x00;
     ActiveIdUsingAllKeyboardKeys = false;
@@ -4422,6 +4439,10 @@ void ImGui::Shutdown()
     CallContextHooks(&g, ImGuiContextHookType_Shutdown);
 
     // Clear everything else
+    for (ImVector<ImGuiWindow*>& bucket : g.WindowsHitTestGrid.Buckets)
+        bucket.clear();
+    g.WindowsHitTestGrid.LargeWindows.clear();
+    g.WindowsHitTestGrid.OrderDirty = true;
     g.Windows.clear_delete();
     g.WindowsFocusOrder.clear();
     g.WindowsTempSortBuffer.clear();
@@ -5502,6 +5523,14 @@ void ImGui::NewFrame()
     if (g.IO.ConfigDebugHighlightIdConflicts && g.HoveredIdPreviousFrameItemCount > 1)
         g.DebugDrawIdConflictsId = g.HoveredIdPreviousFrame;
 
+    // Quiescent frame (see g.QuiescentFrames): no input since last frame and nothing that keeps changing on its own.
+    // Checked before the per-frame state below is shifted, so HoveredId/ActiveId still hold last frame's values.
+    bool frame_quiescent = g.InputEventsTrail.Size == 0 && g.KeysQuiescent && !IsAnyMouseDown();
+    frame_quiescent &= g.ActiveId == 0 && g.ActiveIdPreviousFrame == 0 && g.HoveredId == g.HoveredIdPreviousFrame;
+    frame_quiescent &= g.HoverItemDelayId == 0 && g.HoverItemDelayTimer == 0.0f;
+    frame_quiescent &= g.MovingWindow == NULL && !g.DragDropActive && g.NavWindowingTarget == NULL && !g.NavInitRequest && !g.NavMoveScoringItems;
+    frame_quiescent &= g.DimBgRatio == 0.0f || g.DimBgRatio == 1.0f;
+
     // Update HoveredId data
     if (!g.HoveredIdPreviousFrame)
         g.HoveredIdTimer = 0.0f;
@@ -5630,7 +5659,12 @@ void ImGui::NewFrame()
         // Garbage collect transient buffers of recently unused windows
         if (!window->WasActive && !window->MemoryCompacted && window->LastTimeActive < memory_compact_start_time)
             GcCompactTransientWindowBuffers(window);
+
+        // Windows still auto-fitting, hidden for their first frames or with a pending scroll request settle over the next frames
+        if (window->WasActive && (window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 || window->HiddenFramesCanSkipItems > 0 || window->HiddenFramesCannotSkipItems > 0 || window->ScrollTarget.x < FLT_MAX || window->ScrollTarget.y < FLT_MAX))
+            frame_quiescent = false;
     }
+    g.QuiescentFrames = frame_quiescent ? g.QuiescentFrames + 1 : 0;
 
     // Find hovered window
     // (needs to be before UpdateMouseMovingWindowNewFrame so we fill g.HoveredWindowUnderMovingWindow on the mouse release frame)
@@ -5998,6 +6032,9 @@ void ImGui::EndFrame()
     // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
     IM_ASSERT(g.Windows.Size == g.WindowsTempSortBuffer.Size);
     g.Windows.swap(g.WindowsTempSortBuffer);
+    for (int i = 0; i < g.Windows.Size; i++)
+        g.Windows[i]->HitTestOrder = i;
+    g.WindowsHitTestGrid.OrderDirty = false;
     g.IO.MetricsActiveWindows = g.WindowsActiveCount;
 
     UpdateTexturesEndFrame();
@@ -6118,6 +6155,53 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     return text_size;
 }
 
+// Cell coordinates must fit an int: anything further away (or unbounded, NaN) is handled by LargeWindows
+static bool HitTestGridIsInRange(float x, float y)
+{
+    const float limit = IMGUI_HITTEST_GRID_CELL_SIZE * (float)(1 << 20);
+    return x > -limit && x < limit && y > -limit && y < limit;
+}
+
+static int HitTestGridGetBucket(int cell_x, int cell_y)
+{
+    return (int)(((ImU32)cell_x * 73856093u) ^ ((ImU32)cell_y * 19349663u)) & (IMGUI_HITTEST_GRID_BUCKETS - 1);
+}
+
+// Calls 'func' for every bucket touched by 'rect', or returns false if it belongs to LargeWindows
+template<typename FUNC>
+static bool HitTestGridForEachBucket(const ImRect& rect, FUNC func)
+{
+    if (!HitTestGridIsInRange(rect.Min.x, rect.Min.y) || !HitTestGridIsInRange(rect.Max.x, rect.Max.y))
+        return false;
+    const int x0 = (int)ImFloor(rect.Min.x / IMGUI_HITTEST_GRID_CELL_SIZE), x1 = (int)ImFloor(rect.Max.x / IMGUI_HITTEST_GRID_CELL_SIZE);
+    const int y0 = (int)ImFloor(rect.Min.y / IMGUI_HITTEST_GRID_CELL_SIZE), y1 = (int)ImFloor(rect.Max.y / IMGUI_HITTEST_GRID_CELL_SIZE);
+    if (x1 >= x0 && y1 >= y0 && (ImS64)(x1 - x0 + 1) * (y1 - y0 + 1) > IMGUI_HITTEST_GRID_MAX_CELLS)
+        return false;
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+            func(HitTestGridGetBucket(x, y));
+    return true;
+}
+
+// Called whenever OuterRectClipped is updated: moves the window to the buckets of its new (padded) rectangle
+static void HitTestGridUpdateWindow(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiHitTestGrid& grid = g.WindowsHitTestGrid;
+    ImRect rect = window->OuterRectClipped;
+    rect.Expand(grid.Padding);
+    if (window->HitTestGridInserted && rect.Min == window->HitTestGridRect.Min && rect.Max == window->HitTestGridRect.Max)
+        return;
+
+    if (window->HitTestGridInserted)
+        if (!HitTestGridForEachBucket(window->HitTestGridRect, [&](int bucket_n) { grid.Buckets[bucket_n].find_erase_unsorted(window); }))
+            grid.LargeWindows.find_erase_unsorted(window);
+    if (!HitTestGridForEachBucket(rect, [&](int bucket_n) { if (!grid.Buckets[bucket_n].contains(window)) grid.Buckets[bucket_n].push_back(window); }))
+        grid.LargeWindows.push_back(window);
+    window->HitTestGridRect = rect;
+    window->HitTestGridInserted = true;
+}
+
 // Find window given position, search front-to-back
 // - Typically write output back to g.HoveredWindow and g.HoveredWindowUnderMovingWindow.
 // - FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
@@ -6135,46 +6219,67 @@ void ImGui::FindHoveredWindowEx(const ImVec2& pos, bool find_first_and_in_any_vi
 
     ImVec2 padding_regular = g.Style.TouchExtraPadding;
     ImVec2 padding_for_resize = ImMax(g.Style.TouchExtraPadding, ImVec2(g.Style.WindowBorderHoverPadding, g.Style.WindowBorderHoverPadding));
-    for (int i = g.Windows.Size - 1; i >= 0; i--)
+
+    // Only windows sharing the mouse cell of g.WindowsHitTestGrid can be hit. The front-most (highest display order) wins.
+    ImGuiHitTestGrid& grid = g.WindowsHitTestGrid;
+    const float grid_padding = ImMax(padding_for_resize.x, padding_for_resize.y);
+    if (grid.Padding < grid_padding)
     {
-        ImGuiWindow* window = g.Windows[i];
-        IM_MSVC_WARNING_SUPPRESS(28182); // [Static Analyzer] Dereferencing NULL pointer.
-        if (!window->WasActive || window->Hidden)
-            continue;
-        if (window->Flags & ImGuiWindowFlags_NoMouseInputs)
-            continue;
+        grid.Padding = grid_padding;
+        for (ImGuiWindow* window : g.Windows)
+            if (window->HitTestGridInserted)
+                HitTestGridUpdateWindow(window);
+    }
+    if (grid.OrderDirty)
+    {
+        for (int i = 0; i < g.Windows.Size; i++)
+            g.Windows[i]->HitTestOrder = i;
+        grid.OrderDirty = false;
+    }
 
-        // Using the clipped AABB, a child window will typically be clipped by its parent (not always)
-        ImVec2 hit_padding = (window->Flags & (ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize)) ? padding_regular : padding_for_resize;
-        if (!window->OuterRectClipped.ContainsWithPad(pos, hit_padding))
+    ImGuiWindow* front_window = NULL;
+    ImVector<ImGuiWindow*>* candidate_lists[2] = { NULL, &grid.LargeWindows };
+    if (HitTestGridIsInRange(pos.x, pos.y))
+        candidate_lists[0] = &grid.Buckets[HitTestGridGetBucket((int)ImFloor(pos.x / IMGUI_HITTEST_GRID_CELL_SIZE), (int)ImFloor(pos.y / IMGUI_HITTEST_GRID_CELL_SIZE))];
+    for (ImVector<ImGuiWindow*>* candidates : candidate_lists)
+    {
+        if (candidates == NULL)
             continue;
-
-        // Support for one rectangular hole in any given window
-        // FIXME: Consider generalizing hit-testing override (with more generic data, callback, etc.) (#1512)
-        if (window->HitTestHoleSize.x != 0)
+        for (ImGuiWindow* window : *candidates)
         {
-            ImVec2 hole_pos(window->Pos.x + (float)window->HitTestHoleOffset.x, window->Pos.y + (float)window->HitTestHoleOffset.y);
-            ImVec2 hole_size((float)window->HitTestHoleSize.x, (float)window->HitTestHoleSize.y);
-            if (ImRect(hole_pos, hole_pos + hole_size).Contains(pos))
+            IM_MSVC_WARNING_SUPPRESS(28182); // [Static Analyzer] Dereferencing NULL pointer.
+            if (!window->WasActive || window->Hidden)
                 continue;
-        }
+            if (window->Flags & ImGuiWindowFlags_NoMouseInputs)
+                continue;
+            if (front_window != NULL && window->HitTestOrder < front_window->HitTestOrder && (find_first_and_in_any_viewport || (hovered_window_under_moving_window != NULL && window->HitTestOrder < hovered_window_under_moving_window->HitTestOrder)))
+                continue; // Behind everything already found
 
-        if (find_first_and_in_any_viewport)
-        {
-            hovered_window = window;
-            break;
-        }
-        else
-        {
-            if (hovered_window == NULL)
-                hovered_window = window;
+            // Using the clipped AABB, a child window will typically be clipped by its parent (not always)
+            ImVec2 hit_padding = (window->Flags & (ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize)) ? padding_regular : padding_for_resize;
+            if (!window->OuterRectClipped.ContainsWithPad(pos, hit_padding))
+                continue;
+
+            // Support for one rectangular hole in any given window
+            // FIXME: Consider generalizing hit-testing override (with more generic data, callback, etc.) (#1512)
+            if (window->HitTestHoleSize.x != 0)
+            {
+                ImVec2 hole_pos(window->Pos.x + (float)window->HitTestHoleOffset.x, window->Pos.y + (float)window->HitTestHoleOffset.y);
+                ImVec2 hole_size((float)window->HitTestHoleSize.x, (float)window->HitTestHoleSize.y);
+                if (ImRect(hole_pos, hole_pos + hole_size).Contains(pos))
+                    continue;
+            }
+
+            if (front_window == NULL || window->HitTestOrder > front_window->HitTestOrder)
+                front_window = window;
             IM_MSVC_WARNING_SUPPRESS(28182); // [Static Analyzer] Dereferencing NULL pointer.
-            if (hovered_window_under_moving_window == NULL && (!g.MovingWindow || window->RootWindow != g.MovingWindow->RootWindow))
-                hovered_window_under_moving_window = window;
-            if (hovered_window && hovered_window_under_moving_window)
-                break;
+            if (!find_first_and_in_any_viewport && (!g.MovingWindow || window->RootWindow != g.MovingWindow->RootWindow))
+                if (hovered_window_under_moving_window == NULL || window->HitTestOrder > hovered_window_under_moving_window->HitTestOrder)
+                    hovered_window_under_moving_window = window;
         }
     }
+    if (hovered_window == NULL)
+        hovered_window = front_window;
 
     *out_hovered_window = hovered_window;
     if (out_hovered_window_under_moving_window != NULL)
@@ -6610,6 +6715,7 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
         g.Windows.push_front(window); // Quite slow but rare and only once
     else
         g.Windows.push_back(window);
+    g.WindowsHitTestGrid.OrderDirty = true;
 
     return window;
 }
@@ -7837,6 +7943,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         const ImRect title_bar_rect = window->TitleBarRect();
         window->OuterRectClipped = outer_rect;
         window->OuterRectClipped.ClipWith(host_rect);
+        HitTestGridUpdateWindow(window);
 
         // Inner rectangle
         // Not affected by window border size. Used by:
@@ -8846,11 +8953,12 @@ static void ImGui::UpdateTexturesNewFrame()
     // Cannot update every atlases based on atlas's FrameCount < g.FrameCount, because an atlas may be shared by multiple contexts with different frame count.
     ImGuiContext& g = *GImGui;
     const bool has_textures = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) != 0;
+    const bool has_sdf_text = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasSdfText) != 0;
     for (ImFontAtlas* atlas : g.FontAtlases)
     {
         if (atlas->OwnerContext == &g)
         {
-            ImFontAtlasUpdateNewFrame(atlas, g.FrameCount, has_textures);
+            ImFontAtlasUpdateNewFrame(atlas, g.FrameCount, has_textures, has_sdf_text);
         }
         else
         {
@@ -9490,6 +9598,7 @@ static void ImGui::UpdateKeyRoutingTable(ImGuiKeyRoutingTable* rt)
                 if (owner_data->OwnerCurr == ImGuiKeyOwner_NoOwner)
                 {
                     owner_data->OwnerCurr = routing_entry->RoutingCurr;
+                    g.KeysQuiescent = false;
                     //IMGUI_DEBUG_LOG("SetKeyOwner(%s, owner_id=0x%08X) via Routing\n", GetKeyName(key), routing_entry->RoutingCurr);
                 }
             }
@@ -10023,6 +10132,8 @@ static void UpdateAliasKey(ImGuiKey key, bool v, float analog_value)
     ImGuiKeyData* key_data = ImGui::GetKeyData(key);
     key_data->Down = v;
     key_data->AnalogValue = analog_value;
+    if (v)
+        GImGui->KeysQuiescent = false;
 }
 
 // [Internal] Do not use directly
@@ -10073,30 +10184,41 @@ static void ImGui::UpdateKeyboardInputs()
             io.KeysData[key - ImGuiKey_NamedKey_BEGIN].AnalogValue = 0.0f;
         }
 
-    // Update keys
-    for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; key++)
+    // Quiescent keys: when every named key came out of the previous update up (with DownDuration == DownDurationPrev == -1),
+    // unowned and unlocked, the two loops below rewrite the same values. Any key going down (events, aliases above), SetKeyOwner()
+    // and owners granted by routing clear g.KeysQuiescent, so idle frames skip ~2 x ImGuiKey_NamedKey_COUNT read-modify-writes.
+    if (!g.KeysQuiescent || !g.KeysQuiescentSkip)
     {
-        ImGuiKeyData* key_data = &io.KeysData[key - ImGuiKey_NamedKey_BEGIN];
-        key_data->DownDurationPrev = key_data->DownDuration;
-        key_data->DownDuration = key_data->Down ? (key_data->DownDuration < 0.0f ? 0.0f : key_data->DownDuration + io.DeltaTime) : -1.0f;
-        if (key_data->DownDuration == 0.0f)
+        bool keys_quiescent = true;
+
+        // Update keys
+        for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; key++)
         {
-            if (IsKeyboardKey((ImGuiKey)key))
-                g.LastKeyboardKeyPressTime = g.Time;
-            else if (key == ImGuiKey_ReservedForModCtrl || key == ImGuiKey_ReservedForModShift || key == ImGuiKey_ReservedForModAlt || key == ImGuiKey_ReservedForModSuper)
-                g.LastKeyboardKeyPressTime = g.Time;
+            ImGuiKeyData* key_data = &io.KeysData[key - ImGuiKey_NamedKey_BEGIN];
+            key_data->DownDurationPrev = key_data->DownDuration;
+            key_data->DownDuration = key_data->Down ? (key_data->DownDuration < 0.0f ? 0.0f : key_data->DownDuration + io.DeltaTime) : -1.0f;
+            if (key_data->DownDuration == 0.0f)
+            {
+                if (IsKeyboardKey((ImGuiKey)key))
+                    g.LastKeyboardKeyPressTime = g.Time;
+                else if (key == ImGuiKey_ReservedForModCtrl || key == ImGuiKey_ReservedForModShift || key == ImGuiKey_ReservedForModAlt || key == ImGuiKey_ReservedForModSuper)
+                    g.LastKeyboardKeyPressTime = g.Time;
+            }
+            keys_quiescent &= !key_data->Down && key_data->DownDurationPrev < 0.0f;
         }
-    }
 
-    // Update keys/input owner (named keys only): one entry per key
-    for (ImGuiKey key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; key = (ImGuiKey)(key + 1))
-    {
-        ImGuiKeyData* key_data = &io.KeysData[key - ImGuiKey_NamedKey_BEGIN];
-        ImGuiKeyOwnerData* owner_data = &g.KeysOwnerData[key - ImGuiKey_NamedKey_BEGIN];
-        owner_data->OwnerCurr = owner_data->OwnerNext;
-        if (!key_data->Down) // Important: ownership is released on the frame after a release. Ensure a 'MouseDown -> CloseWindow -> MouseUp' chain doesn't lead to someone else seeing the MouseUp.
-            owner_data->OwnerNext = ImGuiKeyOwner_NoOwner;
-        owner_data->LockThisFrame = owner_data->LockUntilRelease = owner_data->LockUntilRelease && key_data->Down;  // Clear LockUntilRelease when key is not Down anymore
+        // Update keys/input owner (named keys only): one entry per key
+        for (ImGuiKey key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; key = (ImGuiKey)(key + 1))
+        {
+            ImGuiKeyData* key_data = &io.KeysData[key - ImGuiKey_NamedKey_BEGIN];
+            ImGuiKeyOwnerData* owner_data = &g.KeysOwnerData[key - ImGuiKey_NamedKey_BEGIN];
+            owner_data->OwnerCurr = owner_data->OwnerNext;
+            if (!key_data->Down) // Important: ownership is released on the frame after a release. Ensure a 'MouseDown -> CloseWindow -> MouseUp' chain doesn't lead to someone else seeing the MouseUp.
+                owner_data->OwnerNext = ImGuiKeyOwner_NoOwner;
+            owner_data->LockThisFrame = owner_data->LockUntilRelease = owner_data->LockUntilRelease && key_data->Down;  // Clear LockUntilRelease when key is not Down anymore
+            keys_quiescent &= owner_data->OwnerCurr == ImGuiKeyOwner_NoOwner;
+        }
+        g.KeysQuiescent = keys_quiescent;
     }
 
     // Update key routing (for e.g. shortcuts)
@@ -10452,6 +10574,8 @@ void ImGui::UpdateInputEvents(bool trickle_fast_inputs)
 
             key_data->Down = e->Key.Down;
             key_data->AnalogValue = e->Key.AnalogValue;
+            if (e->Key.Down)
+                g.KeysQuiescent = false;
         }
         else if (e->Type == ImGuiInputEventType_Text)
         {
@@ -10573,6 +10697,7 @@ void ImGui::SetKeyOwner(ImGuiKey key, ImGuiID owner_id, ImGuiInputFlags flags)
 
     ImGuiKeyOwnerData* owner_data = GetKeyOwnerData(&g, key);
     owner_data->OwnerCurr = owner_data->OwnerNext = owner_id;
+    g.KeysQuiescent = false;
 
     // We cannot lock by default as it would likely break lots of legacy code.
     // In the case of using LockUntilRelease while key is not down we still lock during the frame (no key_data->Down test)
@@ -12802,6 +12927,7 @@ void ImGui::BringWindowToDisplayFront(ImGuiWindow* window)
         {
             memmove(&g.Windows[i], &g.Windows[i + 1], (size_t)(g.Windows.Size - i - 1) * sizeof(ImGuiWindow*));
             g.Windows[g.Windows.Size - 1] = window;
+            g.WindowsHitTestGrid.OrderDirty = true;
             break;
         }
 }
@@ -12816,6 +12942,7 @@ void ImGui::BringWindowToDisplayBack(ImGuiWindow* window)
         {
             memmove(&g.Windows[1], &g.Windows[0], (size_t)i * sizeof(ImGuiWindow*));
             g.Windows[0] = window;
+            g.WindowsHitTestGrid.OrderDirty = true;
             break;
         }
 }
@@ -12840,6 +12967,7 @@ void ImGui::BringWindowToDisplayBehind(ImGuiWindow* window, ImGuiWindow* behind_
         memmove(&g.Windows.Data[pos_beh + 1], &g.Windows.Data[pos_beh], copy_bytes);
         g.Windows[pos_beh] = window;
     }
+    g.WindowsHitTestGrid.OrderDirty = true;
 }
 
 int ImGui::FindWindowDisplayIndex(ImGuiWindow* window)
@@ -16210,6 +16338,7 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
 
     BeginDisabled();
     CheckboxFlags("io.BackendFlags: RendererHasTextures", &io.BackendFlags, ImGuiBackendFlags_RendererHasTextures);
+    CheckboxFlags("io.BackendFlags: RendererHasSdfText", &io.BackendFlags, ImGuiBackendFlags_RendererHasSdfText);
     EndDisabled();
     ShowFontSelector("Font");
     //BeginDisabled((io.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0);
@@ -16303,6 +16432,14 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         ImFontAtlasBuildClear(atlas);
     SetItemTooltip("Destroy cache and custom rectangles.");
 
+    int budget_kb = atlas->TexMemoryBudget / 1024;
+    SetNextItemWidth(GetFontSize() * 10);
+    if (DragInt("Memory Budget", &budget_kb, 16.0f, 0, 256 * 1024, budget_kb > 0 ? "%d KB" : "Unlimited"))
+        atlas->TexMemoryBudget = budget_kb * 1024;
+    const ImFontAtlasCacheStats& stats = atlas->Builder->CacheStats;
+    Text("Baked: %" IM_PRIu64 " hits, %" IM_PRIu64 " misses, %" IM_PRIu64 " evicted", stats.BakedHits, stats.BakedMisses, stats.BakedEvictions);
+    Text("Glyphs: %" IM_PRIu64 " hits, %" IM_PRIu64 " misses, %" IM_PRIu64 " evicted, %" IM_PRIu64 " compactions", stats.GlyphHits, stats.GlyphMisses, stats.GlyphEvictions, stats.Compactions);
+
     for (int tex_n = 0; tex_n < atlas->TexList.Size; tex_n++)
     {
         ImTextureData* tex = atlas->TexList[tex_n];
@@ -17313,7 +17450,7 @@ void ImGui::DebugNodeFont(ImFont* font)
         if (baked->OwnerFont != font)
             continue;
         PushID(baked->BakedId);
-        if (TreeNode("Glyphs", "Baked at { %.2fpx, d.%.2f }: %d glyphs%s", baked->Size, baked->RasterizerDensity, baked->Glyphs.Size, (baked->LastUsedFrame < atlas->Builder->FrameCount - 1) ? " *Unused*" : ""))
+        if (TreeNode("Glyphs", "Baked at { %.2fpx, d.%.2f }: %d glyphs%s", baked->Size, baked->RasterizerDensity, baked->Glyphs.Size - baked->GlyphsFreeSlots.Size, (baked->LastUsedFrame < atlas->Builder->FrameCount - 1) ? " *Unused*" : ""))
         {
             if (SmallButton("Load all"))
                 for (unsigned int base = 0; base <= IM_UNICODE_CODEPOINT_MAX; base++)
@@ -17322,6 +17459,10 @@ void ImGui::DebugNodeFont(ImFont* font)
             const int surface_sqrt = (int)ImSqrt((float)baked->MetricsTotalSurface);
             Text("Ascent: %f, Descent: %f, Ascent-Descent: %f", baked->Ascent, baked->Descent, baked->Ascent - baked->Descent);
             Text("Texture Area: about %d px ~%dx%d px", baked->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+            int index_pages_used = 0;
+            for (ImFontBakedIndexPage* page : baked->IndexPages)
+                index_pages_used += (page != ImFontBakedIndexPage_GetEmpty()) ? 1 : 0;
+            Text("Index: %d/%d pages, %d bytes", index_pages_used, baked->IndexPages.Size, index_pages_used * (int)sizeof(ImFontBakedIndexPage) + baked->IndexPages.Size * (int)sizeof(ImFontBakedIndexPage*));
             for (int src_n = 0; src_n < font->Sources.Size; src_n++)
             {
                 ImFontConfig* src = font->Sources[src_n];
@@ -180,6 +180,7 @@ struct ImFontAtlas;                 // Runtime data for multiple fonts, bake mul
 struct ImFontAtlasBuilder;          // Opaque storage for building a ImFontAtlas
 struct ImFontAtlasRect;             // Output of ImFontAtlas::GetCustomRect() when using custom rectangles.
 struct ImFontBaked;                 // Baked data for a ImFont at a given size.
+struct ImFontBakedIndexPage;        // Codepoint->glyph index for a block of 256 codepoints within a ImFontBaked (opaque)
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
@@ -1728,6 +1729,7 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
     ImGuiBackendFlags_RendererHasTextures   = 1 << 4,   // Backend Renderer supports ImTextureData requests to create/update/destroy textures. This enables incremental texture updates and texture reloads. See https://github.com/ocornut/imgui/blob/master/docs/BACKENDS.md for instructions on how to upgrade your custom backend.
+    ImGuiBackendFlags_RendererHasSdfText    = 1 << 5,   // Backend Renderer handles ImDrawCallback_SdfTextBegin/ImDrawCallback_SdfTextEnd by switching to a distance-field shader. This enables ImFontFlags_SDF fonts.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -2520,6 +2522,7 @@ struct ImGuiIO
     IMGUI_API void  AddInputCharacter(unsigned int c);                      // Queue a new character input
     IMGUI_API void  AddInputCharacterUTF16(ImWchar16 c);                    // Queue a new character input from a UTF-16 character, it can be a surrogate
     IMGUI_API void  AddInputCharactersUTF8(const char* str);                // Queue a new characters input from a UTF-8 string
+    IMGUI_API void  SetInputComposition(const char* str, int cursor = -1);  // Set IME composition (pre-edit) text from a UTF-8 string, drawn at the active InputText() cursor without entering its buffer. NULL or "": none. 'cursor': byte offset in 'str', -1: end. Commit the final text with AddInputCharactersUTF8(). Cleared when that InputText() is deactivated.
 
     IMGUI_API void  SetKeyEventNativeData(ImGuiKey key, int native_keycode, int native_scancode, int native_legacy_index = -1); // [Optional] Specify index for legacy <1.87 IsKeyXXX() functions with native indices + specify native keycode, scancode.
     IMGUI_API void  SetAppAcceptingEvents(bool accepting_events);           // Set master flag for accepting key/mouse/text events (default to true). Useful if you have native dialog boxes that are interrupting your application loop/refresh, and you want to disable events being queued while your app is frozen.
@@ -2591,6 +2594,8 @@ struct ImGuiIO
     bool        AppAcceptingEvents;                 // Only modify via SetAppAcceptingEvents()
     ImWchar16   InputQueueSurrogate;                // For AddInputCharacterUTF16()
     ImVector<ImWchar> InputQueueCharacters;         // Queue of _characters_ input (obtained by platform backend). Fill using AddInputCharacter() helper.
+    ImVector<char>    InputComposition;             // IME composition text, zero-terminated (empty: none). Only modify via SetInputComposition()
+    int               InputCompositionCursor;       // Byte offset of the IME cursor in InputComposition
 
     // Legacy: before 1.87, we required backend to fill io.KeyMap[] (imgui->native map) during initialization and io.KeysDown[] (native indices) every frame.
     // This is still temporarily supported as a legacy feature. However the new preferred scheme is for backend to call io.AddKeyEvent().
@@ -3149,6 +3154,11 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // Render state is not reset by default because they are many perfectly useful way of altering render state (e.g. changing shader/blending settings before an Image call).
 #define ImDrawCallback_ResetRenderState     (ImDrawCallback)(-8)
 
+// Special Draw callback values bracketing text drawn with a signed distance field font (ImFontFlags_SDF).
+// Only emitted when the renderer backend sets ImGuiBackendFlags_RendererHasSdfText. Between them, texture alpha is a distance (0.5 = glyph edge) which the backend converts to coverage.
+#define ImDrawCallback_SdfTextBegin         (ImDrawCallback)(-9)
+#define ImDrawCallback_SdfTextEnd           (ImDrawCallback)(-10)
+
 // Typically, 1 command = 1 GPU draw call (unless command is a callback)
 // - VtxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   this fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
@@ -3663,6 +3673,7 @@ struct ImFontAtlas
     IMGUI_API void              Clear();                    // Clear everything (input fonts, output glyphs/textures).
     IMGUI_API void              CompactCache();             // Compact cached glyphs and texture.
     IMGUI_API void              SetFontLoader(const ImFontLoader* font_loader); // Change font loader at runtime.
+    IMGUI_API int               PrebakeGlyphs(ImFont* font, float font_size, const ImWchar* glyph_ranges, int threads_count = 0); // Load glyphs ahead of time (e.g. at startup), rasterizing on 'threads_count' threads (0 = all cores). Returns number of glyphs loaded.
 
     // As we are transitioning toward a new font system, we expect to obsolete those soon:
     IMGUI_API void              ClearInputData();           // [OBSOLETE] Clear input data (all ImFontConfig structures including sizes, TTF data, glyph ranges, etc.) = all the data used to build the texture and fonts.
@@ -3744,6 +3755,7 @@ struct ImFontAtlas
     int                         TexMinHeight;       // Minimum desired texture height. Must be a power of two. Default to 128.
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
+    int                         TexMemoryBudget;    // Soft cap on texture memory in bytes (Width * Height * BytesPerPixel). 0 = unlimited (default). When set, least recently used baked sizes then glyphs are evicted instead of growing past it, and the texture is compacted during idle frames.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
     // Output
@@ -3760,6 +3772,7 @@ struct ImFontAtlas
     ImVector<ImTextureData*>    TexList;            // Texture list (most often TexList.Size == 1). TexData is always == TexList.back(). DO NOT USE DIRECTLY, USE GetDrawData().Textures[]/GetPlatformIO().Textures[] instead!
     bool                        Locked;             // Marked as locked during ImGui::NewFrame()..EndFrame() scope if TexUpdates are not supported. Any attempt to modify the atlas will assert.
     bool                        RendererHasTextures;// Copy of (BackendFlags & ImGuiBackendFlags_RendererHasTextures) from supporting context.
+    bool                        RendererHasSdfText; // Copy of (BackendFlags & ImGuiBackendFlags_RendererHasSdfText) from supporting context.
     bool                        TexIsBuilt;         // Set when texture was built matching current font input. Mostly useful for legacy IsBuilt() call.
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format or conversion process.
     ImVec2                      TexUvScale;         // = (1.0f/TexData->TexWidth, 1.0f/TexData->TexHeight). May change as new texture gets created.
@@ -3799,14 +3812,13 @@ struct ImFontAtlas
 // Important: pointers to ImFontBaked are only valid for the current frame.
 struct ImFontBaked
 {
-    // [Internal] Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI).
+    // [Internal] Members: Hot ~20/24 bytes (for CalcTextSize and RenderText loops)
+    ImVector<ImFontBakedIndexPage*> IndexPages;     // 12-16 // out // Sparse two-level index by Unicode code-point: IndexPages[c >> 8] holds AdvanceX[] + Lookup[] for 256 code-points. Allocated on first use of a block (holes share a read-only empty page), so CJK/emoji working sets don't require giant contiguous arrays.
     float                       FallbackAdvanceX;   // 4     // out // FindGlyph(FallbackChar)->AdvanceX
     float                       Size;               // 4     // in  // Height of characters/line, set during loading (doesn't change after loading)
     float                       RasterizerDensity;  // 4     // in  // Density this is baked at
 
-    // [Internal] Members: Hot ~28/36 bytes (for RenderText loop)
-    ImVector<ImU16>             IndexLookup;        // 12-16 // out // Sparse. Index glyphs by Unicode code-point.
+    // [Internal] Members: Hot ~16/20 bytes (for RenderText loop)
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out // All glyphs.
     int                         FallbackGlyphIndex; // 4     // out // Index of FontFallbackChar
 
@@ -3816,7 +3828,10 @@ struct ImFontBaked
     unsigned int                WantDestroy:1;         // 0  //     // Queued for destroy
     unsigned int                LoadNoFallback:1;      // 0  //     // Disable loading fallback in lower-level calls.
     unsigned int                LoadNoRenderOnLayout:1;// 0  //     // Enable a two-steps mode where CalcTextSize() calls will load AdvanceX *without* rendering/packing glyphs. Only advantageous if you know that the glyph is unlikely to actually be rendered, otherwise it is slower because we'd do one query on the first CalcTextSize and one query on the first Draw.
+    unsigned int                SdfMode:1;             // 0  //     // Glyphs are signed distance fields (ImFontFlags_SDF + renderer support). Text is bracketed with ImDrawCallback_SdfTextBegin/End.
     int                         LastUsedFrame;         // 4  //     // Record of that time this was bounds
+    ImVector<int>               GlyphsLastUsedFrame;// 12-16 //     // Parallel to Glyphs[]: last frame each glyph was drawn. Used by ImFontAtlas::TexMemoryBudget eviction.
+    ImVector<int>               GlyphsFreeSlots;    // 12-16 //     // Indices of discarded entries in Glyphs[], reused by the next added glyph so eviction churn doesn't grow Glyphs[].
     ImGuiID                     BakedId;            // 4     //     // Unique ID for this baked storage
     ImFont*                     OwnerFont;          // 4-8   // in  // Parent font
     void*                       FontLoaderDatas;    // 4-8   //     // Font loader opaque storage (per baked font * sources): single contiguous buffer allocated by imgui, passed to loader.
@@ -3838,6 +3853,7 @@ enum ImFontFlags_
     ImFontFlags_NoLoadError             = 1 << 1,   // Disable throwing an error/assert when calling AddFontXXX() with missing file/data. Calling code is expected to check AddFontXXX() return value.
     ImFontFlags_NoLoadGlyphs            = 1 << 2,   // [Internal] Disable loading new glyphs.
     ImFontFlags_LockBakedSizes          = 1 << 3,   // [Internal] Disable loading new baked sizes, disable garbage collecting current ones. e.g. if you want to lock a font to a single size. Important: if you use this to preload given sizes, consider the possibility of multiple font density used on Retina display.
+    ImFontFlags_SDF                     = 1 << 4,   // Rasterize glyphs as signed distance fields in a single bake (IMGUI_FONT_SDF_BAKE_SIZE) reused at every size. Requires ImGuiBackendFlags_RendererHasSdfText, otherwise ignored. Set via ImFontConfig::Flags.
 };
 
 // Font runtime data and rendering
@@ -15,6 +15,7 @@ Index of this file:
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas, ImFontAtlasBuilder
 // [SECTION] ImFontAtlas: backend for stb_truetype
+// [SECTION] ImFontAtlas: glyph pre-baking
 // [SECTION] ImFontAtlas: glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFontBaked, ImFont
@@ -42,6 +43,10 @@ Index of this file:
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#ifndef IMGUI_DISABLE_FONT_PREBAKE_THREADS
+#include <atomic>       // std::atomic (ImFontAtlas::PrebakeGlyphs)
+#include <thread>       // std::thread (ImFontAtlas::PrebakeGlyphs)
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -140,8 +145,11 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// stbtt_fontinfo::userdata is NULL except when rasterizing from worker threads (ImFontAtlasBuildPrebakeGlyphs), where it points to
+// the raw allocator functions: ImGui::MemAlloc() also updates debug counters of the current context, which is not thread-safe.
+struct ImFontStbTrueTypeAllocator { ImGuiMemAllocFunc AllocFunc; ImGuiMemFreeFunc FreeFunc; void* UserData; };
+#define STBTT_malloc(x,u)   ((u) ? ((ImFontStbTrueTypeAllocator*)(u))->AllocFunc(x, ((ImFontStbTrueTypeAllocator*)(u))->UserData) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? ((ImFontStbTrueTypeAllocator*)(u))->FreeFunc(x, ((ImFontStbTrueTypeAllocator*)(u))->UserData) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -2639,6 +2647,44 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
 #define IM_FONTGLYPH_INDEX_UNUSED           ((ImU16)-1) // 0xFFFF
 #define IM_FONTGLYPH_INDEX_NOT_FOUND        ((ImU16)-2) // 0xFFFE
 
+// Read ImFontBaked::IndexPages[]. Holes point to a shared read-only page reporting -1.0f / IM_FONTGLYPH_INDEX_UNUSED, so lookups don't need a NULL check.
+static inline float ImFontBaked_IndexGetAdvanceX(const ImFontBaked* baked, unsigned int c)
+{
+    const unsigned int page_n = c >> IM_FONTBAKED_INDEX_PAGE_SHIFT;
+    return (page_n < (unsigned int)baked->IndexPages.Size) ? baked->IndexPages.Data[page_n]->AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] : -1.0f;
+}
+
+static inline int ImFontBaked_IndexGetLookup(const ImFontBaked* baked, unsigned int c)
+{
+    const unsigned int page_n = c >> IM_FONTBAKED_INDEX_PAGE_SHIFT;
+    return (page_n < (unsigned int)baked->IndexPages.Size) ? baked->IndexPages.Data[page_n]->Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK] : IM_FONTGLYPH_INDEX_UNUSED;
+}
+
+// Variant for loops walking text, reading from a copy of IndexPages.Data/Size kept in registers (otherwise both are reloaded for every
+// character, as the compiler can't tell they don't change across the out-of-line calls of the slow paths), along with the first page
+// so that ASCII/Latin-1 characters cost a single load as with a flat array. Loading a glyph may grow IndexPages[] or allocate a page:
+// callers take a new view after any load.
+struct ImFontBakedIndexView
+{
+    ImFontBakedIndexPage* const*    Pages;
+    unsigned int                    PagesCount;
+    const ImFontBakedIndexPage*     FirstPage;
+
+    ImFontBakedIndexView(const ImFontBaked* baked)
+    {
+        Pages = baked->IndexPages.Data;
+        PagesCount = (unsigned int)baked->IndexPages.Size;
+        FirstPage = (PagesCount > 0) ? Pages[0] : ImFontBakedIndexPage_GetEmpty();
+    }
+    float GetAdvanceX(unsigned int c) const
+    {
+        if (c < IM_FONTBAKED_INDEX_PAGE_SIZE)
+            return FirstPage->AdvanceX[c];
+        const unsigned int page_n = c >> IM_FONTBAKED_INDEX_PAGE_SHIFT;
+        return (page_n < PagesCount) ? Pages[page_n]->AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] : -1.0f;
+    }
+};
+
 ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
@@ -2685,6 +2731,17 @@ void ImFontAtlas::SetFontLoader(const ImFontLoader* font_loader)
     ImFontAtlasBuildSetupFontLoader(this, font_loader);
 }
 
+// Call after backend initialization (ImGuiBackendFlags_RendererHasTextures set), otherwise building the atlas will preload all GlyphRanges.
+int ImFontAtlas::PrebakeGlyphs(ImFont* font, float font_size, const ImWchar* glyph_ranges, int threads_count)
+{
+    IM_ASSERT(font != NULL && font->OwnerAtlas == this);
+    IM_ASSERT(glyph_ranges != NULL);
+    if (Builder == NULL)
+        ImFontAtlasBuildMain(this);
+    ImFontBaked* baked = font->GetFontBaked(font_size);
+    return ImFontAtlasBuildPrebakeGlyphs(this, baked, glyph_ranges, threads_count);
+}
+
 void ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas!");
@@ -2749,10 +2806,12 @@ static void ImFontAtlasBuildUpdateRendererHasTexturesFromContext(ImFontAtlas* at
 // If you manually manage font atlases, you'll need to call this yourself.
 // - 'frame_count' needs to be provided because we can gc/prioritize baked fonts based on their age.
 // - 'frame_count' may not match those of all imgui contexts using this atlas, as contexts may be updated as different frequencies. But generally you can use ImGui::GetFrameCount() on one of your context.
-void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool renderer_has_textures)
+void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool renderer_has_textures, bool renderer_has_sdf_text)
 {
     IM_ASSERT(atlas->Builder == NULL || atlas->Builder->FrameCount < frame_count); // Protection against being called twice.
     atlas->RendererHasTextures = renderer_has_textures;
+    const bool sdf_text_changed = (atlas->RendererHasSdfText != renderer_has_sdf_text);
+    atlas->RendererHasSdfText = renderer_has_sdf_text;
 
     // Check that font atlas was built or backend support texture reload in which case we can build now
     if (atlas->RendererHasTextures)
@@ -2772,7 +2831,31 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
     ImFontAtlasBuilder* builder = atlas->Builder;
     builder->FrameCount = frame_count;
     for (ImFont* font : atlas->Fonts)
+    {
         font->LastBaked = NULL;
+        if (sdf_text_changed && (font->Flags & ImFontFlags_SDF)) // Bakes were made for the other mode (coverage vs distance)
+            ImFontAtlasFontDiscardBakes(atlas, font, 0);
+    }
+
+    // Enforce memory budget once nothing got loaded for a while: evict least recently used data and repack into a smaller texture.
+    if (atlas->TexMemoryBudget > 0 && atlas->RendererHasTextures && frame_count - builder->LastLoadFrame >= IMGUI_FONT_BUDGET_IDLE_FRAMES)
+    {
+        ImTextureData* tex = atlas->TexData;
+        if (tex->Width * tex->Height * tex->BytesPerPixel > atlas->TexMemoryBudget || builder->RectsDiscardedSurface > builder->RectsPackedSurface / 4)
+        {
+            // Over budget with nothing evictable (e.g. everything still drawn every frame): the last pass recorded when to try again,
+            // at most once every IMGUI_FONT_BUDGET_IDLE_FRAMES. Skip the full scan until then, unless something got loaded or the budget changed.
+            const bool evict_skip = frame_count < builder->EvictSkipUntilFrame && builder->EvictSkipLoadFrame == builder->LastLoadFrame && builder->EvictSkipBudget == atlas->TexMemoryBudget;
+            if (!evict_skip)
+                ImFontAtlasBuildEvictToBudget(atlas, atlas->TexMemoryBudget);
+            if (builder->RectsDiscardedCount > 0) // Nothing to reclaim otherwise (repacking live data to a smaller estimate may fail and grow back)
+            {
+                ImVec2i new_tex_size = ImFontAtlasTextureGetSizeEstimate(atlas);
+                ImFontAtlasTextureRepack(atlas, new_tex_size.x, new_tex_size.y);
+                builder->CacheStats.Compactions++;
+            }
+        }
+    }
 
     // Garbage collect BakedPool
     if (builder->BakedDiscardedCount > 0)
@@ -3491,12 +3574,7 @@ void ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas)
         if (font->EllipsisChar != 0)
             baked->FindGlyph(font->EllipsisChar);
         for (ImFontConfig* src : font->Sources)
-        {
-            const ImWchar* ranges = src->GlyphRanges ? src->GlyphRanges : atlas->GetGlyphRangesDefault();
-            for (; ranges[0]; ranges += 2)
-                for (unsigned int c = ranges[0]; c <= ranges[1] && c <= IM_UNICODE_CODEPOINT_MAX; c++) //-V560
-                    baked->FindGlyph((ImWchar)c);
-        }
+            ImFontAtlasBuildPrebakeGlyphs(atlas, baked, src->GlyphRanges ? src->GlyphRanges : atlas->GetGlyphRangesDefault(), 0);
     }
 }
 
@@ -3836,8 +3914,13 @@ void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBa
     IM_ASSERT(font->FallbackChar != c && font->EllipsisChar != c); // Unsupported for simplicity
     IM_ASSERT(glyph >= baked->Glyphs.Data && glyph < baked->Glyphs.Data + baked->Glyphs.Size);
     IM_UNUSED(font);
-    baked->IndexLookup[c] = IM_FONTGLYPH_INDEX_UNUSED;
-    baked->IndexAdvanceX[c] = baked->FallbackAdvanceX;
+    ImFontBakedIndexPage* page = baked->IndexPages[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT];
+    page->Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK] = IM_FONTGLYPH_INDEX_UNUSED;
+    page->AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] = baked->FallbackAdvanceX;
+
+    // Keep the slot for the next ImFontAtlasBakedAddFontGlyph() call (Glyphs[] indices are stored in Lookup[] so we can't compact cheaply)
+    glyph->Visible = false;
+    baked->GlyphsFreeSlots.push_back((int)(glyph - baked->Glyphs.Data));
 }
 
 ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_size, float font_rasterizer_density, ImGuiID baked_id)
@@ -3849,6 +3932,8 @@ ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_si
     baked->BakedId = baked_id;
     baked->OwnerFont = font;
     baked->LastUsedFrame = atlas->Builder->FrameCount;
+    atlas->Builder->LastLoadFrame = atlas->Builder->FrameCount;
+    baked->SdfMode = (font->Flags & ImFontFlags_SDF) && atlas->RendererHasSdfText;
 
     // Initialize backend data
     size_t loader_data_size = 0;
@@ -3959,6 +4044,118 @@ void ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames)
     }
 }
 
+static int ImFontAtlasBuildGetEstimatedTexBytes(ImFontAtlas* atlas)
+{
+    ImVec2i tex_size = ImFontAtlasTextureGetSizeEstimate(atlas);
+    return tex_size.x * tex_size.y * atlas->TexData->BytesPerPixel;
+}
+
+struct ImFontAtlasEvictGlyphCandidate
+{
+    ImFontBaked*    Baked;
+    int             GlyphIdx;
+    int             LastUsedFrame;
+};
+
+static int IMGUI_CDECL ImFontAtlasEvictGlyphCandidateComparerByLastUsedFrame(const void* lhs, const void* rhs)
+{
+    const ImFontAtlasEvictGlyphCandidate* a = (const ImFontAtlasEvictGlyphCandidate*)lhs;
+    const ImFontAtlasEvictGlyphCandidate* b = (const ImFontAtlasEvictGlyphCandidate*)rhs;
+    return (a->LastUsedFrame < b->LastUsedFrame) ? -1 : (a->LastUsedFrame > b->LastUsedFrame) ? +1 : 0;
+}
+
+// Second half of ImFontAtlasBuildEvictToBudget(): individual glyphs, least recently used first.
+static void ImFontAtlasBuildEvictGlyphsToBudget(ImFontAtlas* atlas, int budget_bytes, int frame_limit, int* next_evictable_frame)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImVector<ImFontAtlasEvictGlyphCandidate> candidates;
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+    {
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        if (baked->WantDestroy || (baked->OwnerFont->Flags & ImFontFlags_LockBakedSizes))
+            continue;
+        ImFont* font = baked->OwnerFont;
+        for (int glyph_n = 0; glyph_n < baked->Glyphs.Size; glyph_n++)
+        {
+            const ImFontGlyph* glyph = &baked->Glyphs[glyph_n];
+            const int last_used_frame = baked->GlyphsLastUsedFrame[glyph_n];
+            if (glyph->PackId == ImFontAtlasRectId_Invalid || glyph_n == baked->FallbackGlyphIndex)
+                continue;
+            if (glyph->Codepoint == font->FallbackChar || glyph->Codepoint == font->EllipsisChar)
+                continue;
+            if (last_used_frame > frame_limit)
+            {
+                *next_evictable_frame = ImMin(*next_evictable_frame, last_used_frame + 2);
+                continue;
+            }
+            ImFontAtlasEvictGlyphCandidate candidate = { baked, glyph_n, last_used_frame };
+            candidates.push_back(candidate);
+        }
+    }
+    if (candidates.Size > 1)
+        ImQsort(candidates.Data, (size_t)candidates.Size, sizeof(ImFontAtlasEvictGlyphCandidate), ImFontAtlasEvictGlyphCandidateComparerByLastUsedFrame);
+    for (const ImFontAtlasEvictGlyphCandidate& candidate : candidates)
+    {
+        ImFontBaked* baked = candidate.Baked;
+        ImFontGlyph* glyph = &baked->Glyphs[candidate.GlyphIdx];
+        const ImWchar c = (ImWchar)glyph->Codepoint;
+        const float advance_x = glyph->AdvanceX;
+        ImFontAtlasBakedDiscardFontGlyph(atlas, baked->OwnerFont, baked, glyph);
+        baked->IndexPages[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]->AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] = advance_x; // Only pixels are evicted: keep layout stable without reloading.
+        builder->CacheStats.GlyphEvictions++;
+        if (ImFontAtlasBuildGetEstimatedTexBytes(atlas) <= budget_bytes)
+            break;
+    }
+}
+
+// Discard least recently used data until repacking would produce a texture fitting in 'budget_bytes'.
+// - Whole baked sizes go first (oldest first), then individual glyphs of the remaining ones (oldest first).
+// - Anything drawn during the last 2 frames is kept, so no draw list refers to texture space that may be reused.
+// - This only discards rectangles: caller decides when/how to repack.
+// - When nothing could be discarded, records in builder->EvictSkipUntilFrame when it is worth trying again (see ImFontAtlasUpdateNewFrame()).
+void ImFontAtlasBuildEvictToBudget(ImFontAtlas* atlas, int budget_bytes)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    const int frame_limit = builder->FrameCount - 2;
+    const ImU64 evictions_before = builder->CacheStats.BakedEvictions + builder->CacheStats.GlyphEvictions;
+    int next_evictable_frame = INT_MAX; // Earliest frame at which data only kept for being recently used could go
+    while (ImFontAtlasBuildGetEstimatedTexBytes(atlas) > budget_bytes)
+    {
+        ImFontBaked* lru_baked = NULL;
+        for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+        {
+            ImFontBaked* baked = &builder->BakedPool[baked_n];
+            if (baked->WantDestroy || (baked->OwnerFont->Flags & ImFontFlags_LockBakedSizes))
+                continue;
+            if (baked->LastUsedFrame > frame_limit)
+            {
+                next_evictable_frame = ImMin(next_evictable_frame, baked->LastUsedFrame + 2);
+                continue;
+            }
+            if (lru_baked == NULL || baked->LastUsedFrame < lru_baked->LastUsedFrame)
+                lru_baked = baked;
+        }
+        if (lru_baked == NULL)
+            break;
+        ImFontAtlasBakedDiscard(atlas, lru_baked->OwnerFont, lru_baked);
+        builder->CacheStats.BakedEvictions++;
+    }
+    if (ImFontAtlasBuildGetEstimatedTexBytes(atlas) > budget_bytes)
+        ImFontAtlasBuildEvictGlyphsToBudget(atlas, budget_bytes, frame_limit, &next_evictable_frame);
+
+    if (builder->CacheStats.BakedEvictions + builder->CacheStats.GlyphEvictions == evictions_before)
+    {
+        builder->EvictSkipUntilFrame = ImMax(next_evictable_frame, builder->FrameCount + IMGUI_FONT_BUDGET_IDLE_FRAMES);
+        builder->EvictSkipLoadFrame = builder->LastLoadFrame;
+        builder->EvictSkipBudget = budget_bytes;
+    }
+    else
+    {
+        builder->EvictSkipUntilFrame = 0;
+    }
+}
+
+
 // Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
 void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
 {
@@ -4181,6 +4378,13 @@ void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontAtlasBuildDiscardBakes(atlas, 2);
 
+    // With a memory budget, evict least recently used data instead of growing past it.
+    // Only evict down to the budget: the heuristic below decides between repacking in place and growing.
+    ImTextureData* tex = atlas->TexData;
+    const int tex_bytes = tex->Width * tex->Height * tex->BytesPerPixel;
+    if (atlas->TexMemoryBudget > 0 && tex_bytes * 2 > atlas->TexMemoryBudget)
+        ImFontAtlasBuildEvictToBudget(atlas, atlas->TexMemoryBudget);
+
     // Currently using a heuristic for repack without growing.
     if (builder->RectsDiscardedSurface < builder->RectsPackedSurface * 0.20f)
         ImFontAtlasTextureGrow(atlas);
@@ -4480,13 +4684,43 @@ static bool ImFontAtlasBuildAcceptCodepointForSource(ImFontConfig* src, ImWchar
     return true;
 }
 
-static void ImFontBaked_BuildGrowIndex(ImFontBaked* baked, int new_size)
+static void ImFontBakedIndexPage_Init(ImFontBakedIndexPage* page)
 {
-    IM_ASSERT(baked->IndexAdvanceX.Size == baked->IndexLookup.Size);
-    if (new_size <= baked->IndexLookup.Size)
-        return;
-    baked->IndexAdvanceX.resize(new_size, -1.0f);
-    baked->IndexLookup.resize(new_size, IM_FONTGLYPH_INDEX_UNUSED);
+    for (int n = 0; n < IM_FONTBAKED_INDEX_PAGE_SIZE; n++)
+        page->AdvanceX[n] = -1.0f;
+    memset(page->Lookup, 0xFF, sizeof(page->Lookup)); // IM_FONTGLYPH_INDEX_UNUSED
+}
+
+static ImFontBakedIndexPage ImFontBakedIndexPage_MakeEmpty()
+{
+    ImFontBakedIndexPage page;
+    ImFontBakedIndexPage_Init(&page);
+    return page;
+}
+
+// Shared page for holes in IndexPages[]. Never written to.
+// Initialized as a function-local static (thread-safe since C++11): it is shared by every atlas, and atlases owned by different contexts
+// may be used from different threads, so two of them may be the first to get here at the same time.
+ImFontBakedIndexPage* ImFontBakedIndexPage_GetEmpty()
+{
+    static ImFontBakedIndexPage empty_page = ImFontBakedIndexPage_MakeEmpty();
+    return &empty_page;
+}
+
+// Return the index page holding 'codepoint', allocating it on first use.
+static ImFontBakedIndexPage* ImFontBaked_BuildGetIndexPage(ImFontBaked* baked, unsigned int codepoint)
+{
+    ImFontBakedIndexPage* empty_page = ImFontBakedIndexPage_GetEmpty();
+    const int page_n = (int)(codepoint >> IM_FONTBAKED_INDEX_PAGE_SHIFT);
+    if (page_n >= baked->IndexPages.Size)
+        baked->IndexPages.resize(page_n + 1, empty_page);
+    ImFontBakedIndexPage* page = baked->IndexPages.Data[page_n];
+    if (page == empty_page)
+    {
+        page = baked->IndexPages.Data[page_n] = (ImFontBakedIndexPage*)IM_ALLOC(sizeof(ImFontBakedIndexPage));
+        ImFontBakedIndexPage_Init(page);
+    }
+    return page;
 }
 
 static void ImFontAtlas_FontHookRemapCodepoint(ImFontAtlas* atlas, ImFont* font, ImWchar* c)
@@ -4508,6 +4742,9 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
         return NULL;
     }
 
+    atlas->Builder->LastLoadFrame = atlas->Builder->FrameCount;
+    atlas->Builder->CacheStats.GlyphMisses++;
+
     // User remapping hooks
     ImWchar src_codepoint = codepoint;
     ImFontAtlas_FontHookRemapCodepoint(atlas, font, &codepoint);
@@ -4561,9 +4798,9 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
         ImFontAtlasBuildSetupFontBakedFallback(baked);
 
     // Mark index as not found, so we don't attempt the search twice
-    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
-    baked->IndexAdvanceX[codepoint] = baked->FallbackAdvanceX;
-    baked->IndexLookup[codepoint] = IM_FONTGLYPH_INDEX_NOT_FOUND;
+    ImFontBakedIndexPage* page = ImFontBaked_BuildGetIndexPage(baked, codepoint);
+    page->AdvanceX[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = baked->FallbackAdvanceX;
+    page->Lookup[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = IM_FONTGLYPH_INDEX_NOT_FOUND;
     return NULL;
 }
 
@@ -4633,6 +4870,8 @@ struct ImGui_ImplStbTrueType_FontSrcData
 {
     stbtt_fontinfo  FontInfo;
     float           ScaleFactor;
+
+    ImGui_ImplStbTrueType_FontSrcData() { memset(this, 0, sizeof(*this)); } // FontInfo.userdata = NULL: see STBTT_malloc()
 };
 
 static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig* src)
@@ -4707,6 +4946,62 @@ static bool ImGui_ImplStbTrueType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig
     return true;
 }
 
+// Scales and offsets for the glyphs of 'src' at the size of 'baked'.
+// Also used by ImFontAtlasBuildPrebakeGlyphs(), which must produce the same glyphs as the on-demand path.
+struct ImGui_ImplStbTrueType_BakedMetrics
+{
+    int     OversampleH, OversampleV;
+    float   ScaleForLayout;                     // Font units to pixels
+    float   ScaleForRasterX, ScaleForRasterY;   // Font units to bitmap texels (rasterizer density, oversampling)
+    float   RecipH, RecipV;                     // Bitmap texels to pixels
+    float   FontOffX, FontOffY;                 // Snapped GlyphOffset, + ascent
+};
+
+static void ImGui_ImplStbTrueType_GetBakedMetrics(ImFontConfig* src, ImFontBaked* baked, ImGui_ImplStbTrueType_BakedMetrics* out_metrics)
+{
+    ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
+    ImFontAtlasBuildGetOversampleFactors(src, baked, &out_metrics->OversampleH, &out_metrics->OversampleV);
+    const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
+    out_metrics->ScaleForLayout = bd_font_data->ScaleFactor * baked->Size;
+    out_metrics->ScaleForRasterX = out_metrics->ScaleForLayout * rasterizer_density * out_metrics->OversampleH;
+    out_metrics->ScaleForRasterY = out_metrics->ScaleForLayout * rasterizer_density * out_metrics->OversampleV;
+    out_metrics->RecipH = 1.0f / (out_metrics->OversampleH * rasterizer_density);
+    out_metrics->RecipV = 1.0f / (out_metrics->OversampleV * rasterizer_density);
+    const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
+    const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
+    out_metrics->FontOffX = ImFloor(src->GlyphOffset.x * offsets_scale + 0.5f); // Snap scaled offset.
+    out_metrics->FontOffY = ImFloor(src->GlyphOffset.y * offsets_scale + 0.5f) + IM_ROUND(baked->Ascent);
+}
+
+// Bitmap box of a glyph, in texels. Size includes room for the oversampling filter, and is zero when there is nothing to draw (e.g. Space).
+static void ImGui_ImplStbTrueType_GetGlyphBitmapBox(const stbtt_fontinfo* font_info, const ImGui_ImplStbTrueType_BakedMetrics* metrics, int glyph_index, int* out_x0, int* out_y0, int* out_w, int* out_h)
+{
+    int x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index, metrics->ScaleForRasterX, metrics->ScaleForRasterY, 0, 0, out_x0, out_y0, &x1, &y1);
+    const bool is_visible = (*out_x0 != x1 && *out_y0 != y1);
+    *out_w = is_visible ? (x1 - *out_x0 + metrics->OversampleH - 1) : 0;
+    *out_h = is_visible ? (y1 - *out_y0 + metrics->OversampleV - 1) : 0;
+}
+
+// Render with oversampling into cleared 'pixels' (stride 'w'), returns the shift applied by the filter in 'out_sub_x'/'out_sub_y'.
+// Doesn't touch shared state: may be called from worker threads.
+static void ImGui_ImplStbTrueType_RasterizeGlyph(const stbtt_fontinfo* font_info, const ImGui_ImplStbTrueType_BakedMetrics* metrics, int glyph_index, unsigned char* pixels, int w, int h, float* out_sub_x, float* out_sub_y)
+{
+    stbtt_MakeGlyphBitmapSubpixelPrefilter(font_info, pixels, w, h, w,
+        metrics->ScaleForRasterX, metrics->ScaleForRasterY, 0, 0, metrics->OversampleH, metrics->OversampleV, out_sub_x, out_sub_y, glyph_index);
+}
+
+// Drawing coordinates from base text position of a glyph rendered at (x0, y0) texels, accounting for oversampling.
+static void ImGui_ImplStbTrueType_SetGlyphBox(const ImGui_ImplStbTrueType_BakedMetrics* metrics, int x0, int y0, int w, int h, float sub_x, float sub_y, ImFontGlyph* out_glyph)
+{
+    const float font_off_x = metrics->FontOffX + sub_x;
+    const float font_off_y = metrics->FontOffY + sub_y;
+    out_glyph->X0 = x0 * metrics->RecipH + font_off_x;
+    out_glyph->Y0 = y0 * metrics->RecipV + font_off_y;
+    out_glyph->X1 = (x0 + w) * metrics->RecipH + font_off_x;
+    out_glyph->Y1 = (y0 + h) * metrics->RecipV + font_off_y;
+}
+
 static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
 {
     // Search for first font which has the glyph
@@ -4717,38 +5012,58 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         return false;
 
     // Fonts unit to pixels
-    int oversample_h, oversample_v;
-    ImFontAtlasBuildGetOversampleFactors(src, baked, &oversample_h, &oversample_v);
-    const float scale_for_layout = bd_font_data->ScaleFactor * baked->Size;
-    const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
-    const float scale_for_raster_x = bd_font_data->ScaleFactor * baked->Size * rasterizer_density * oversample_h;
-    const float scale_for_raster_y = bd_font_data->ScaleFactor * baked->Size * rasterizer_density * oversample_v;
+    ImGui_ImplStbTrueType_BakedMetrics metrics;
+    ImGui_ImplStbTrueType_GetBakedMetrics(src, baked, &metrics);
 
     // Obtain size and advance
-    int x0, y0, x1, y1;
+    int x0, y0, w, h;
     int advance, lsb;
-    stbtt_GetGlyphBitmapBoxSubpixel(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, 0, 0, &x0, &y0, &x1, &y1);
+    ImGui_ImplStbTrueType_GetGlyphBitmapBox(&bd_font_data->FontInfo, &metrics, glyph_index, &x0, &y0, &w, &h);
     stbtt_GetGlyphHMetrics(&bd_font_data->FontInfo, glyph_index, &advance, &lsb);
 
     // Load metrics only mode
     if (out_advance_x != NULL)
     {
         IM_ASSERT(out_glyph == NULL);
-        *out_advance_x = advance * scale_for_layout;
+        *out_advance_x = advance * metrics.ScaleForLayout;
         return true;
     }
 
     // Prepare glyph
     out_glyph->Codepoint = codepoint;
-    out_glyph->AdvanceX = advance * scale_for_layout;
+    out_glyph->AdvanceX = advance * metrics.ScaleForLayout;
+
+    // Signed distance field: rendered at baked size without oversampling, with IMGUI_FONT_SDF_PADDING texels of spread around the outline.
+    // Edge maps to 128, distance falls to 0 at PADDING texels outside.
+    if (baked->SdfMode)
+    {
+        int w = 0, h = 0, x_off = 0, y_off = 0;
+        unsigned char* sdf_pixels = stbtt_GetGlyphSDF(&bd_font_data->FontInfo, metrics.ScaleForLayout, glyph_index, IMGUI_FONT_SDF_PADDING, 128, 128.0f / IMGUI_FONT_SDF_PADDING, &w, &h, &x_off, &y_off);
+        if (sdf_pixels == NULL) // e.g. Space
+            return true;
+        ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
+        if (pack_id == ImFontAtlasRectId_Invalid)
+        {
+            IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+            stbtt_FreeSDF(sdf_pixels, NULL);
+            return false;
+        }
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+        out_glyph->X0 = x_off + metrics.FontOffX;
+        out_glyph->Y0 = y_off + metrics.FontOffY;
+        out_glyph->X1 = out_glyph->X0 + w;
+        out_glyph->Y1 = out_glyph->Y0 + h;
+        out_glyph->Visible = true;
+        out_glyph->PackId = pack_id;
+        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, sdf_pixels, ImTextureFormat_Alpha8, w);
+        stbtt_FreeSDF(sdf_pixels, NULL);
+        return true;
+    }
 
     // Pack and retrieve position inside texture atlas
     // (generally based on stbtt_PackFontRangesRenderIntoRects)
-    const bool is_visible = (x0 != x1 && y0 != y1);
-    if (is_visible)
+    if (w > 0)
     {
-        const int w = (x1 - x0 + oversample_h - 1);
-        const int h = (y1 - y0 + oversample_v - 1);
         ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
         if (pack_id == ImFontAtlasRectId_Invalid)
         {
@@ -4759,7 +5074,6 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
 
         // Render
-        stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
         ImFontAtlasBuilder* builder = atlas->Builder;
         builder->TempBuffer.resize(w * h * 1);
         unsigned char* bitmap_pixels = builder->TempBuffer.Data;
@@ -4768,25 +5082,12 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         // Render with oversampling
         // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
         float sub_x, sub_y;
-        stbtt_MakeGlyphBitmapSubpixelPrefilter(&bd_font_data->FontInfo, bitmap_pixels, w, h, w,
-            scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
-
-        const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
-        const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
-        float font_off_x = ImFloor(src->GlyphOffset.x * offsets_scale + 0.5f); // Snap scaled offset.
-        float font_off_y = ImFloor(src->GlyphOffset.y * offsets_scale + 0.5f);
-        font_off_x += sub_x;
-        font_off_y += sub_y + IM_ROUND(baked->Ascent);
-        float recip_h = 1.0f / (oversample_h * rasterizer_density);
-        float recip_v = 1.0f / (oversample_v * rasterizer_density);
+        ImGui_ImplStbTrueType_RasterizeGlyph(&bd_font_data->FontInfo, &metrics, glyph_index, bitmap_pixels, w, h, &sub_x, &sub_y);
 
         // Register glyph
         // r->x r->y are coordinates inside texture (in pixels)
         // glyph.X0, glyph.Y0 are drawing coordinates from base text position, and accounting for oversampling.
-        out_glyph->X0 = x0 * recip_h + font_off_x;
-        out_glyph->Y0 = y0 * recip_v + font_off_y;
-        out_glyph->X1 = (x0 + (int)r->w) * recip_h + font_off_x;
-        out_glyph->Y1 = (y0 + (int)r->h) * recip_v + font_off_y;
+        ImGui_ImplStbTrueType_SetGlyphBox(&metrics, x0, y0, w, h, sub_x, sub_y, out_glyph);
         out_glyph->Visible = true;
         out_glyph->PackId = pack_id;
         ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
@@ -4810,6 +5111,240 @@ const ImFontLoader* ImFontAtlasGetFontLoaderForStbTruetype()
 
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: glyph pre-baking
+//-------------------------------------------------------------------------
+// - ImFontAtlasBuildPrebakeGlyphs()
+//-------------------------------------------------------------------------
+// Bulk load a known character set (e.g. common CJK ideographs) instead of paying for each glyph on first use.
+// Glyphs served by stb_truetype are processed in three passes:
+// - calling thread: select source and measure bitmaps.
+// - worker threads: rasterize into private slices of a single pixel buffer (stbtt functions don't touch shared state).
+// - calling thread: pack and blit, tallest first.
+// Everything else (other loaders, SDF fonts, ellipsis hook, missing glyphs) goes through the regular FindGlyph() path.
+// Metrics and rasterization go through the same ImGui_ImplStbTrueType_XXX helpers as the on-demand loader, so glyphs come out identical.
+//-------------------------------------------------------------------------
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+
+struct ImFontPrebakeSource
+{
+    stbtt_fontinfo                      FontInfo;   // Copy with userdata pointing to raw allocator
+    bool                                Enabled;    // Using stb_truetype loader
+    ImGui_ImplStbTrueType_BakedMetrics  Metrics;
+};
+
+struct ImFontPrebakeGlyph
+{
+    ImWchar         Codepoint;          // Before remapping
+    int             SourceIdx;
+    int             GlyphIndex;         // stb_truetype glyph index
+    int             X0, Y0;             // Bitmap box origin, in raster pixels
+    int             W, H;               // Bitmap size, 0 when not visible
+    int             PixelsOffset;
+    float           AdvanceX;
+    float           SubX, SubY;         // Written by stbtt_MakeGlyphBitmapSubpixelPrefilter()
+};
+
+static void ImFontAtlasBuildPrebakeRasterize(const ImFontPrebakeSource* sources, ImFontPrebakeGlyph* glyphs, unsigned char* pixels, int glyph_begin, int glyph_end)
+{
+    for (int glyph_n = glyph_begin; glyph_n < glyph_end; glyph_n++)
+    {
+        ImFontPrebakeGlyph* g = &glyphs[glyph_n];
+        if (g->W == 0)
+            continue;
+        const ImFontPrebakeSource* s = &sources[g->SourceIdx];
+        ImGui_ImplStbTrueType_RasterizeGlyph(&s->FontInfo, &s->Metrics, g->GlyphIndex, pixels + g->PixelsOffset, g->W, g->H, &g->SubX, &g->SubY);
+    }
+}
+
+static int IMGUI_CDECL ImFontPrebakeGlyphComparerByHeight(const void* lhs, const void* rhs)
+{
+    const ImFontPrebakeGlyph* a = (const ImFontPrebakeGlyph*)lhs;
+    const ImFontPrebakeGlyph* b = (const ImFontPrebakeGlyph*)rhs;
+    if (a->H != b->H)
+        return b->H - a->H;
+    return (int)a->Codepoint - (int)b->Codepoint;
+}
+
+// Load all codepoints that stb_truetype can serve. Leave the others in 'codepoints'.
+static void ImFontAtlasBuildPrebakeGlyphsStbTrueType(ImFontAtlas* atlas, ImFontBaked* baked, ImVector<ImWchar>* codepoints, int threads_count)
+{
+    ImFont* font = baked->OwnerFont;
+    if (baked->SdfMode)
+        return;
+
+    ImFontStbTrueTypeAllocator allocator;
+    ImGui::GetAllocatorFunctions(&allocator.AllocFunc, &allocator.FreeFunc, &allocator.UserData);
+    ImVector<ImFontPrebakeSource> sources;
+    sources.resize(font->Sources.Size);
+    for (int src_n = 0; src_n < font->Sources.Size; src_n++)
+    {
+        ImFontConfig* src = font->Sources[src_n];
+        ImFontPrebakeSource* s = &sources[src_n];
+        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+        s->Enabled = (loader == ImFontAtlasGetFontLoaderForStbTruetype());
+        if (!s->Enabled)
+            continue;
+        ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
+        IM_ASSERT(bd_font_data);
+        s->FontInfo = bd_font_data->FontInfo;
+        s->FontInfo.userdata = &allocator;
+
+        ImGui_ImplStbTrueType_GetBakedMetrics(src, baked, &s->Metrics);
+    }
+
+    // Select source and measure
+    ImVector<ImFontPrebakeGlyph> glyphs;
+    glyphs.reserve(codepoints->Size);
+    int pixels_size = 0;
+    int remaining_count = 0;
+    for (ImWchar src_codepoint : *codepoints)
+    {
+        ImWchar codepoint = src_codepoint;
+        ImFontAtlas_FontHookRemapCodepoint(atlas, font, &codepoint);
+        int src_n = -1;
+        int glyph_index = 0;
+        if (!(codepoint == font->EllipsisChar && font->EllipsisAutoBake))
+            for (int n = 0; n < font->Sources.Size; n++)
+            {
+                ImFontConfig* src = font->Sources[n];
+                if (src->GlyphExcludeRanges && !ImFontAtlasBuildAcceptCodepointForSource(src, codepoint))
+                    continue;
+                if (!sources[n].Enabled) // Source has priority but uses another loader
+                    break;
+                glyph_index = stbtt_FindGlyphIndex(&sources[n].FontInfo, (int)codepoint);
+                if (glyph_index != 0)
+                {
+                    src_n = n;
+                    break;
+                }
+            }
+        if (src_n == -1)
+        {
+            (*codepoints)[remaining_count++] = src_codepoint;
+            continue;
+        }
+
+        const ImFontPrebakeSource* s = &sources[src_n];
+        glyphs.resize(glyphs.Size + 1);
+        ImFontPrebakeGlyph* g = &glyphs.back();
+        int advance, lsb;
+        ImGui_ImplStbTrueType_GetGlyphBitmapBox(&s->FontInfo, &s->Metrics, glyph_index, &g->X0, &g->Y0, &g->W, &g->H);
+        stbtt_GetGlyphHMetrics(&s->FontInfo, glyph_index, &advance, &lsb);
+        g->Codepoint = src_codepoint;
+        g->SourceIdx = src_n;
+        g->GlyphIndex = glyph_index;
+        g->PixelsOffset = pixels_size;
+        g->AdvanceX = advance * s->Metrics.ScaleForLayout;
+        g->SubX = g->SubY = 0.0f;
+        pixels_size += g->W * g->H;
+    }
+    codepoints->resize(remaining_count);
+    if (glyphs.Size == 0)
+        return;
+
+    // Rasterize
+    // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
+    ImVector<unsigned char> pixels;
+    pixels.resize(pixels_size);
+    memset(pixels.Data, 0, (size_t)pixels_size);
+#ifndef IMGUI_DISABLE_FONT_PREBAKE_THREADS
+    if (threads_count <= 0)
+        threads_count = (int)std::thread::hardware_concurrency();
+    threads_count = ImClamp(threads_count, 1, ImMax(glyphs.Size / IMGUI_FONT_PREBAKE_GLYPHS_PER_THREAD, 1));
+    if (threads_count > 1)
+    {
+        // Glyphs are handed out in small batches as rasterization cost varies a lot between glyphs.
+        const int batch_size = 16;
+        std::atomic<int> next_glyph(0);
+        auto worker_func = [&]()
+        {
+            for (int glyph_n = next_glyph.fetch_add(batch_size); glyph_n < glyphs.Size; glyph_n = next_glyph.fetch_add(batch_size))
+                ImFontAtlasBuildPrebakeRasterize(sources.Data, glyphs.Data, pixels.Data, glyph_n, ImMin(glyph_n + batch_size, glyphs.Size));
+        };
+        std::thread* workers = (std::thread*)IM_ALLOC(sizeof(std::thread) * (threads_count - 1));
+        for (int worker_n = 0; worker_n < threads_count - 1; worker_n++)
+            IM_PLACEMENT_NEW(&workers[worker_n]) std::thread(worker_func);
+        worker_func();
+        for (int worker_n = 0; worker_n < threads_count - 1; worker_n++)
+        {
+            workers[worker_n].join();
+            workers[worker_n].~thread();
+        }
+        IM_FREE(workers);
+    }
+    else
+#endif
+    {
+        IM_UNUSED(threads_count);
+        ImFontAtlasBuildPrebakeRasterize(sources.Data, glyphs.Data, pixels.Data, 0, glyphs.Size);
+    }
+
+    // Pack and blit, tallest first for a tighter packing
+    ImQsort(glyphs.Data, (size_t)glyphs.Size, sizeof(ImFontPrebakeGlyph), ImFontPrebakeGlyphComparerByHeight);
+    atlas->Builder->LastLoadFrame = atlas->Builder->FrameCount;
+    for (const ImFontPrebakeGlyph& g : glyphs)
+    {
+        ImFontConfig* src = font->Sources[g.SourceIdx];
+        const ImFontPrebakeSource* s = &sources[g.SourceIdx];
+        ImFontGlyph glyph;
+        glyph.Codepoint = g.Codepoint;
+        glyph.SourceIdx = g.SourceIdx;
+        glyph.AdvanceX = g.AdvanceX;
+        if (g.W > 0)
+        {
+            ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, g.W, g.H);
+            if (pack_id == ImFontAtlasRectId_Invalid)
+            {
+                // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
+                IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+                return;
+            }
+            ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+            ImGui_ImplStbTrueType_SetGlyphBox(&s->Metrics, g.X0, g.Y0, g.W, g.H, g.SubX, g.SubY, &glyph);
+            glyph.Visible = true;
+            glyph.PackId = pack_id;
+            ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, &glyph, r, pixels.Data + g.PixelsOffset, ImTextureFormat_Alpha8, g.W);
+        }
+        ImFontAtlasBakedAddFontGlyph(atlas, baked, src, &glyph);
+    }
+}
+
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+
+// Returns number of glyphs added to 'baked'.
+int ImFontAtlasBuildPrebakeGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* glyph_ranges, int threads_count)
+{
+    ImFont* font = baked->OwnerFont;
+    if (atlas->Locked || (font->Flags & ImFontFlags_NoLoadGlyphs))
+        return 0;
+    const int glyphs_count_before = baked->Glyphs.Size - baked->GlyphsFreeSlots.Size;
+
+    // Gather codepoints not loaded yet (ranges may overlap)
+    ImVector<ImWchar> codepoints;
+    ImBitVector codepoints_seen;
+    codepoints_seen.Create(IM_UNICODE_CODEPOINT_MAX + 1);
+    for (const ImWchar* ranges = glyph_ranges; ranges[0]; ranges += 2)
+        for (unsigned int c = ranges[0]; c <= ranges[1] && c <= IM_UNICODE_CODEPOINT_MAX; c++) //-V560
+            if (!codepoints_seen.TestBit((int)c) && ImFontBaked_IndexGetLookup(baked, c) == IM_FONTGLYPH_INDEX_UNUSED)
+            {
+                codepoints_seen.SetBit((int)c);
+                codepoints.push_back((ImWchar)c);
+            }
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    ImFontAtlasBuildPrebakeGlyphsStbTrueType(atlas, baked, &codepoints, threads_count);
+#else
+    IM_UNUSED(threads_count);
+#endif
+
+    // Regular path for the rest
+    for (ImWchar c : codepoints)
+        baked->FindGlyph(c);
+    return baked->Glyphs.Size - baked->GlyphsFreeSlots.Size - glyphs_count_before;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] ImFontAtlas: glyph ranges helpers
 //-------------------------------------------------------------------------
@@ -5142,8 +5677,12 @@ void ImFontBaked::ClearOutputData()
 {
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
-    IndexAdvanceX.clear();
-    IndexLookup.clear();
+    GlyphsLastUsedFrame.clear();
+    GlyphsFreeSlots.clear();
+    for (ImFontBakedIndexPage* page : IndexPages)
+        if (page != ImFontBakedIndexPage_GetEmpty())
+            IM_FREE(page);
+    IndexPages.clear();
     FallbackGlyphIndex = -1;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
@@ -5189,10 +5728,23 @@ bool ImFont::IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last)
 // - 'src' is not necessarily == 'this->Sources' because multiple source fonts+configs can be used to build one target font.
 ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, const ImFontGlyph* in_glyph)
 {
-    int glyph_idx = baked->Glyphs.Size;
-    baked->Glyphs.push_back(*in_glyph);
+    int glyph_idx;
+    if (baked->GlyphsFreeSlots.Size > 0)
+    {
+        // Reuse a slot discarded by ImFontAtlasBakedDiscardFontGlyph()
+        glyph_idx = baked->GlyphsFreeSlots.back();
+        baked->GlyphsFreeSlots.pop_back();
+        baked->Glyphs[glyph_idx] = *in_glyph;
+        baked->GlyphsLastUsedFrame[glyph_idx] = atlas->Builder->FrameCount;
+    }
+    else
+    {
+        glyph_idx = baked->Glyphs.Size;
+        baked->Glyphs.push_back(*in_glyph);
+        baked->GlyphsLastUsedFrame.push_back(atlas->Builder->FrameCount);
+    }
     ImFontGlyph* glyph = &baked->Glyphs[glyph_idx];
-    IM_ASSERT(baked->Glyphs.Size < 0xFFFE); // IndexLookup[] hold 16-bit values and -1/-2 are reserved.
+    IM_ASSERT(baked->Glyphs.Size < 0xFFFE); // ImFontBakedIndexPage::Lookup[] hold 16-bit values and -1/-2 are reserved.
 
     // Set UV from packed rectangle
     if (glyph->PackId != ImFontAtlasRectId_Invalid)
@@ -5231,9 +5783,9 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
 
     // Update lookup tables
     const int codepoint = glyph->Codepoint;
-    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
-    baked->IndexAdvanceX[codepoint] = glyph->AdvanceX;
-    baked->IndexLookup[codepoint] = (ImU16)glyph_idx;
+    ImFontBakedIndexPage* page = ImFontBaked_BuildGetIndexPage(baked, codepoint);
+    page->AdvanceX[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = glyph->AdvanceX;
+    page->Lookup[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = (ImU16)glyph_idx;
     const int page_n = codepoint / 8192;
     baked->OwnerFont->Used8kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
 
@@ -5259,8 +5811,8 @@ void ImFontAtlasBakedAddFontGlyphAdvancedX(ImFontAtlas* atlas, ImFontBaked* bake
         advance_x += src->GlyphExtraAdvanceX;
     }
 
-    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
-    baked->IndexAdvanceX[codepoint] = advance_x;
+    ImFontBakedIndexPage* page = ImFontBaked_BuildGetIndexPage(baked, codepoint);
+    page->AdvanceX[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = advance_x;
 }
 
 // Copy to texture, post-process and queue update for backend
@@ -5282,14 +5834,11 @@ void ImFont::AddRemapChar(ImWchar from_codepoint, ImWchar to_codepoint)
 // Find glyph, load if necessary, return fallback if missing
 ImFontGlyph* ImFontBaked::FindGlyph(ImWchar c)
 {
-    if (c < (size_t)IndexLookup.Size) IM_LIKELY
-    {
-        const int i = (int)IndexLookup.Data[c];
-        if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
-            return &Glyphs.Data[FallbackGlyphIndex];
-        if (i != IM_FONTGLYPH_INDEX_UNUSED)
-            return &Glyphs.Data[i];
-    }
+    const int i = ImFontBaked_IndexGetLookup(this, c);
+    if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
+        return &Glyphs.Data[FallbackGlyphIndex];
+    if (i != IM_FONTGLYPH_INDEX_UNUSED) IM_LIKELY
+        return &Glyphs.Data[i];
     ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(this, c, NULL);
     return glyph ? glyph : &Glyphs.Data[FallbackGlyphIndex];
 }
@@ -5297,14 +5846,11 @@ ImFontGlyph* ImFontBaked::FindGlyph(ImWchar c)
 // Attempt to load but when missing, return NULL instead of FallbackGlyph
 ImFontGlyph* ImFontBaked::FindGlyphNoFallback(ImWchar c)
 {
-    if (c < (size_t)IndexLookup.Size) IM_LIKELY
-    {
-        const int i = (int)IndexLookup.Data[c];
-        if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
-            return NULL;
-        if (i != IM_FONTGLYPH_INDEX_UNUSED)
-            return &Glyphs.Data[i];
-    }
+    const int i = ImFontBaked_IndexGetLookup(this, c);
+    if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
+        return NULL;
+    if (i != IM_FONTGLYPH_INDEX_UNUSED) IM_LIKELY
+        return &Glyphs.Data[i];
     LoadNoFallback = true; // This is actually a rare call, not done in hot-loop, so we prioritize not adding extra cruft to ImFontBaked_BuildLoadGlyph() call sites.
     ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(this, c, NULL);
     LoadNoFallback = false;
@@ -5313,15 +5859,8 @@ ImFontGlyph* ImFontBaked::FindGlyphNoFallback(ImWchar c)
 
 bool ImFontBaked::IsGlyphLoaded(ImWchar c)
 {
-    if (c < (size_t)IndexLookup.Size) IM_LIKELY
-    {
-        const int i = (int)IndexLookup.Data[c];
-        if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
-            return false;
-        if (i != IM_FONTGLYPH_INDEX_UNUSED)
-            return true;
-    }
-    return false;
+    const int i = ImFontBaked_IndexGetLookup(this, c);
+    return i != IM_FONTGLYPH_INDEX_NOT_FOUND && i != IM_FONTGLYPH_INDEX_UNUSED;
 }
 
 // This is not fast query
@@ -5338,17 +5877,14 @@ bool ImFont::IsGlyphInFont(ImWchar c)
     return false;
 }
 
-// This is manually inlined in CalcTextSizeA() and CalcWordWrapPosition(), with a non-inline call to BuildLoadGlyphGetAdvanceOrFallback().
+// This is manually inlined in CalcTextSizeA() and CalcWordWrapPosition() (see ImFontBakedIndexView), with a non-inline call to BuildLoadGlyphGetAdvanceOrFallback().
 IM_MSVC_RUNTIME_CHECKS_OFF
 float ImFontBaked::GetCharAdvance(ImWchar c)
 {
-    if ((int)c < IndexAdvanceX.Size)
-    {
-        // Missing glyphs fitting inside index will have stored FallbackAdvanceX already.
-        const float x = IndexAdvanceX.Data[c];
-        if (x >= 0.0f)
-            return x;
-    }
+    // Missing glyphs already looked up will have stored FallbackAdvanceX.
+    const float x = ImFontBaked_IndexGetAdvanceX(this, c);
+    if (x >= 0.0f)
+        return x;
     return ImFontBaked_BuildLoadGlyphAdvanceX(this, c);
 }
 IM_MSVC_RUNTIME_CHECKS_RESTORE
@@ -5373,6 +5909,13 @@ ImFontBaked* ImFont::GetFontBaked(float size, float density)
 
     if (density < 0.0f)
         density = CurrentRasterizerDensity;
+
+    // Distance field fonts use a single bake for all sizes, the renderer upscales/downscales it.
+    if ((Flags & ImFontFlags_SDF) && OwnerAtlas->RendererHasSdfText)
+    {
+        size = IMGUI_FONT_SDF_BAKE_SIZE;
+        density = 1.0f;
+    }
     if (baked && baked->Size == size && baked->RasterizerDensity == density)
         return baked;
 
@@ -5398,6 +5941,7 @@ ImFontBaked* ImFontAtlasBakedGetOrAdd(ImFontAtlas* atlas, ImFont* font, float fo
     if (baked != NULL)
     {
         IM_ASSERT(baked->Size == font_size && baked->OwnerFont == font && baked->BakedId == baked_id);
+        builder->CacheStats.BakedHits++;
         return baked;
     }
 
@@ -5416,6 +5960,7 @@ ImFontBaked* ImFontAtlasBakedGetOrAdd(ImFontAtlas* atlas, ImFont* font, float fo
     }
 
     // Create new
+    builder->CacheStats.BakedMisses++;
     baked = ImFontAtlasBakedAdd(atlas, font, font_size, font_rasterizer_density, baked_id);
     *p_baked_in_map = baked; // To avoid 'builder->BakedMap.SetVoidPtr(baked_id, baked);' while we can.
     return baked;
@@ -5513,6 +6058,7 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
     //const char* span_begin = s;
     const char* span_end = s;
     float span_width = 0.0f;
+    ImFontBakedIndexView index(baked);
 
     while (s < text_end)
     {
@@ -5535,9 +6081,12 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
         }
 
         // Optimized inline version of 'float char_width = GetCharAdvance((ImWchar)c);'
-        float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+        float char_width = index.GetAdvanceX(c);
         if (char_width < 0.0f)
+        {
             char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
+            index = ImFontBakedIndexView(baked);
+        }
 
         // Classify current character
         int curr_type;
@@ -5620,6 +6169,7 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    ImFontBakedIndexView index(baked);
 
     const char* s = text_begin;
     while (s < text_end_display)
@@ -5629,7 +6179,10 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
+            {
                 word_wrap_eol = ImFontCalcWordWrapPositionEx(font, size, s, text_end, wrap_width - line_width, flags);
+                index = ImFontBakedIndexView(baked); // May have loaded glyphs
+            }
 
             if (s >= word_wrap_eol)
             {
@@ -5666,9 +6219,12 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
             continue;
 
         // Optimized inline version of 'float char_width = GetCharAdvance((ImWchar)c);'
-        float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+        float char_width = index.GetAdvanceX(c);
         if (char_width < 0.0f)
+        {
             char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
+            index = ImFontBakedIndexView(baked);
+        }
         char_width *= scale;
 
         if (line_width + char_width >= max_width)
@@ -5701,6 +6257,41 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
+// Bracket distance field glyphs with ImDrawCallback_SdfTextBegin/ImDrawCallback_SdfTextEnd.
+// Consecutive SDF texts are merged into a single run, and a run that ended up drawing nothing is removed.
+static void ImFontSdfTextBegin(ImDrawList* draw_list)
+{
+    ImVector<ImDrawCmd>& cmds = draw_list->CmdBuffer;
+    int n = cmds.Size - 1;
+    while (n > 0 && cmds[n].ElemCount == 0 && cmds[n].UserCallback == NULL)
+        n--;
+    if (cmds[n].UserCallback == ImDrawCallback_SdfTextEnd)
+    {
+        cmds.resize(n);
+        draw_list->AddDrawCmd();
+        draw_list->_TryMergeDrawCmds();
+        return;
+    }
+    draw_list->AddCallback(ImDrawCallback_SdfTextBegin, NULL);
+}
+
+static void ImFontSdfTextEnd(ImDrawList* draw_list)
+{
+    ImVector<ImDrawCmd>& cmds = draw_list->CmdBuffer;
+    int n = cmds.Size - 1;
+    while (n > 0 && cmds[n].ElemCount == 0 && cmds[n].UserCallback == NULL)
+        n--;
+    if (cmds[n].UserCallback == ImDrawCallback_SdfTextBegin)
+    {
+        cmds.resize(n);
+        draw_list->AddDrawCmd();
+        if (cmds.Size > 1)
+            draw_list->_TryMergeDrawCmds();
+        return;
+    }
+    draw_list->AddCallback(ImDrawCallback_SdfTextEnd, NULL);
+}
+
 void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c, const ImVec4* cpu_fine_clip)
 {
     ImFontBaked* baked = GetFontBaked(size);
@@ -5735,8 +6326,15 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
         if (y1 >= y2)
             return;
     }
+    ImFontAtlasBuilder* builder = OwnerAtlas->Builder;
+    baked->GlyphsLastUsedFrame.Data[glyph - baked->Glyphs.Data] = builder->FrameCount;
+    builder->CacheStats.GlyphHits++;
+    if (baked->SdfMode)
+        ImFontSdfTextBegin(draw_list);
     draw_list->PrimReserve(6, 4);
     draw_list->PrimRectUV(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
+    if (baked->SdfMode)
+        ImFontSdfTextEnd(draw_list);
 }
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
@@ -5798,6 +6396,10 @@ begin:
     if (s == text_end)
         return;
 
+    // Distance field glyphs need the renderer to switch shader
+    if (baked->SdfMode)
+        ImFontSdfTextBegin(draw_list);
+
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
     const int vtx_count_max = (int)(text_end - s) * 4;
     const int idx_count_max = (int)(text_end - s) * 6;
@@ -5811,6 +6413,8 @@ begin:
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
+    const int frame_count = OwnerAtlas->Builder->FrameCount;
+    int glyphs_drawn = 0;
 
     while (s < text_end)
     {
@@ -5903,6 +6507,10 @@ begin:
                     }
                 }
 
+                // Record use for TexMemoryBudget eviction
+                baked->GlyphsLastUsedFrame.Data[glyph - baked->Glyphs.Data] = frame_count;
+                glyphs_drawn++;
+
                 // Support for untinted glyphs
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
 
@@ -5930,6 +6538,8 @@ begin:
         draw_list->CmdBuffer.pop_back();
         draw_list->PrimUnreserve(idx_count_max, vtx_count_max);
         draw_list->AddDrawCmd();
+        if (baked->SdfMode)
+            ImFontSdfTextEnd(draw_list);
         //IMGUI_DEBUG_LOG("RenderText: cancel and retry to missing glyphs.\n"); // [DEBUG]
         //draw_list->AddRectFilled(pos, pos + ImVec2(10, 10), IM_COL32(255, 0, 0, 255)); // [DEBUG]
         goto begin;
@@ -5944,6 +6554,9 @@ begin:
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_index;
+    OwnerAtlas->Builder->CacheStats.GlyphHits += glyphs_drawn;
+    if (baked->SdfMode)
+        ImFontSdfTextEnd(draw_list);
 }
 
 //-----------------------------------------------------------------------------
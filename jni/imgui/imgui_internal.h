@@ -31,6 +31,7 @@ Index of this file:
 // [SECTION] Localization support
 // [SECTION] Error handling, State recovery support
 // [SECTION] Metrics, Debug tools
+// [SECTION] Hit-test grid
 // [SECTION] Generic context hooks
 // [SECTION] ImGuiContext (main imgui context)
 // [SECTION] ImGuiWindowTempData, ImGuiWindow
@@ -143,6 +144,7 @@ struct ImGuiTextIndex;              // Maintain a line index for a text buffer.
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
 struct ImFontAtlasBuilder;          // Internal storage for incrementally packing and building a ImFontAtlas
+struct ImFontBakedIndexPage;        // Codepoint->glyph index for a block of 256 codepoints within a ImFontBaked
 struct ImFontAtlasPostProcessData;  // Data available to potential texture post-processing functions
 struct ImFontAtlasRectEntry;        // Packed rectangle lookup entry
 
@@ -155,6 +157,7 @@ struct ImGuiDataTypeInfo;           // Type information associated to a ImGuiDat
 struct ImGuiDeactivatedItemData;    // Data for IsItemDeactivated()/IsItemDeactivatedAfterEdit() function.
 struct ImGuiErrorRecoveryState;     // Storage of stack sizes for error handling and recovery
 struct ImGuiGroupData;              // Stacked storage data for BeginGroup()/EndGroup()
+struct ImGuiHitTestGrid;            // Spatial hash of window hit-test rectangles, for FindHoveredWindowEx()
 struct ImGuiInputTextState;         // Internal state of the currently focused/edited text input box
 struct ImGuiInputTextDeactivateData;// Short term storage to backup text of a deactivating InputText() while another is stealing active id
 struct ImGuiLastItemData;           // Status storage for last submitted items
@@ -2164,6 +2167,27 @@ struct ImGuiIDStackTool
     ImGuiIDStackTool()      { memset(this, 0, sizeof(*this)); LastActiveFrame = -1; OptHexEncodeNonAsciiChars = true; CopyToClipboardLastTime = -FLT_MAX; }
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] Hit-test grid
+//-----------------------------------------------------------------------------
+
+// Windows are hashed by the grid cells their padded OuterRectClipped covers, so FindHoveredWindowEx() only tests the windows
+// sharing the mouse cell instead of walking g.Windows. Entries are updated in Begin() when the rectangle changes, and kept for
+// inactive windows (filtered when queried). Display order comes from ImGuiWindow::HitTestOrder, reassigned when g.Windows changes.
+#define IMGUI_HITTEST_GRID_CELL_SIZE        128.0f
+#define IMGUI_HITTEST_GRID_BUCKETS          256     // Power of two. Distinct cells may share a bucket: hits are always checked against the rectangle.
+#define IMGUI_HITTEST_GRID_MAX_CELLS        64      // Windows covering more cells (or far away/unbounded) are kept in LargeWindows
+
+struct ImGuiHitTestGrid
+{
+    ImVector<ImGuiWindow*>  Buckets[IMGUI_HITTEST_GRID_BUCKETS];
+    ImVector<ImGuiWindow*>  LargeWindows;
+    float                   Padding;                // Hover padding rectangles were inserted with, all entries are rebuilt when the style needs more
+    bool                    OrderDirty;             // g.Windows was reordered since HitTestOrder was last assigned
+
+    ImGuiHitTestGrid()      { Padding = 0.0f; OrderDirty = true; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Generic context hooks
 //-----------------------------------------------------------------------------
@@ -2217,11 +2241,13 @@ struct ImGuiContext
     ImVector<ImGuiInputEvent> InputEventsTrail;                 // Past input events processed in NewFrame(). This is to allow domain-specific application to access e.g mouse/pen trail.
     ImGuiMouseSource        InputEventsNextMouseSource;
     ImU32                   InputEventsNextEventId;
+    int                     QuiescentFrames;                    // Consecutive NewFrame() calls with no input event, no key/button down, nothing active, moving or auto-fitting and no hover change or delay pending. Lets the application throttle its main loop while idle.
 
     // Windows state
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
     ImVector<ImGuiWindow*>  WindowsFocusOrder;                  // Root windows, sorted in focus order, back to front.
     ImVector<ImGuiWindow*>  WindowsTempSortBuffer;              // Temporary buffer used in EndFrame() to reorder windows so parents are kept before their child
+    ImGuiHitTestGrid        WindowsHitTestGrid;                 // Windows by screen area, for FindHoveredWindowEx()
     ImVector<ImGuiWindowStackData> CurrentWindowStack;
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
@@ -2282,6 +2308,8 @@ struct ImGuiContext
     ImBitArrayForNamedKeys  KeysMayBeCharInput;                 // Lookup to tell if a key can emit char input, see IsKeyChordPotentiallyCharInput(). sizeof() = 20 bytes
     ImGuiKeyOwnerData       KeysOwnerData[ImGuiKey_NamedKey_COUNT];
     ImGuiKeyRoutingTable    KeysRoutingTable;
+    bool                    KeysQuiescent;                      // All named keys were up, unowned and unlocked after the last UpdateKeyboardInputs(): its per-key updates are no-ops until a key goes down or gets an owner.
+    bool                    KeysQuiescentSkip;                  // = true. Set to false to run UpdateKeyboardInputs() per-key updates on quiescent frames too (to check the fast path against).
     ImU32                   ActiveIdUsingNavDirMask;            // Active widget will want to read those nav move requests (e.g. can activate a button and move away from it)
     bool                    ActiveIdUsingAllKeyboardKeys;       // Active widget will want to read all keyboard keys inputs. (this is a shortcut for not taking ownership of 100+ keys, frequently used by drag operations)
     ImGuiKeyChord           DebugBreakInShortcutRouting;        // Set to break in SetShortcutRouting()/Shortcut() calls.
@@ -2719,6 +2747,9 @@ struct IMGUI_API ImGuiWindow
     ImRect                  ContentRegionRect;                  // FIXME: This is currently confusing/misleading. It is essentially WorkRect but not handling of scrolling. We currently rely on it as right/bottom aligned sizing operation need some size to rely on.
     ImVec2ih                HitTestHoleSize;                    // Define an optional rectangular hole where mouse will pass-through the window.
     ImVec2ih                HitTestHoleOffset;
+    ImRect                  HitTestGridRect;                    // Padded OuterRectClipped as stored in g.WindowsHitTestGrid
+    bool                    HitTestGridInserted;
+    int                     HitTestOrder;                       // Index in g.Windows (display order), valid while g.WindowsHitTestGrid.OrderDirty is false
 
     int                     LastFrameActive;                    // Last frame number the window was Active.
     float                   LastTimeActive;                     // Last timestamp the window was Active (using float as we don't need high precision there)
@@ -3805,6 +3836,18 @@ typedef ImFontLoader ImFontBuilderIO; // [renamed/changed in 1.92.0] The types a
 
 #define IMGUI_FONT_SIZE_MAX                                     (512.0f)
 #define IMGUI_FONT_SIZE_THRESHOLD_FOR_LOADADVANCEXONLYMODE      (128.0f)
+#ifndef IMGUI_FONT_SDF_BAKE_SIZE
+#define IMGUI_FONT_SDF_BAKE_SIZE                                (32.0f)     // ImFontFlags_SDF: the single size glyphs are baked at, scaled to every requested size.
+#endif
+#ifndef IMGUI_FONT_SDF_PADDING
+#define IMGUI_FONT_SDF_PADDING                                  (4)         // ImFontFlags_SDF: distance spread in texels around each glyph (at IMGUI_FONT_SDF_BAKE_SIZE).
+#endif
+#ifndef IMGUI_FONT_BUDGET_IDLE_FRAMES
+#define IMGUI_FONT_BUDGET_IDLE_FRAMES                           (30)        // ImFontAtlas::TexMemoryBudget: frames without any glyph/baked load before enforcing the budget by compacting.
+#endif
+#ifndef IMGUI_FONT_PREBAKE_GLYPHS_PER_THREAD
+#define IMGUI_FONT_PREBAKE_GLYPHS_PER_THREAD                    (64)        // ImFontAtlas::PrebakeGlyphs(): minimum amount of glyphs to rasterize for each extra worker thread to be worth spawning.
+#endif
 
 // Helpers: ImTextureRef ==/!= operators provided as convenience
 // (note that _TexID and _TexData are never set simultaneously)
@@ -3831,6 +3874,18 @@ struct ImFontAtlasRectEntry
     unsigned int        IsUsed : 1;
 };
 
+// Second level of ImFontBaked::IndexPages[]: lookup data for IM_FONTBAKED_INDEX_PAGE_SIZE consecutive code-points.
+// Advance and glyph index for a code-point are kept in the same page so FindGlyph() + GetCharAdvance() touch a single allocation.
+#define IM_FONTBAKED_INDEX_PAGE_SHIFT       8
+#define IM_FONTBAKED_INDEX_PAGE_SIZE        (1 << IM_FONTBAKED_INDEX_PAGE_SHIFT)
+#define IM_FONTBAKED_INDEX_PAGE_MASK        (IM_FONTBAKED_INDEX_PAGE_SIZE - 1)
+struct ImFontBakedIndexPage
+{
+    float               AdvanceX[IM_FONTBAKED_INDEX_PAGE_SIZE]; // Glyphs->AdvanceX, or -1.0f when not loaded yet. Missing glyphs store FallbackAdvanceX.
+    ImU16               Lookup[IM_FONTBAKED_INDEX_PAGE_SIZE];   // Index into Glyphs[], or IM_FONTGLYPH_INDEX_UNUSED / IM_FONTGLYPH_INDEX_NOT_FOUND.
+};
+IMGUI_API ImFontBakedIndexPage* ImFontBakedIndexPage_GetEmpty();                     // Shared read-only page used for holes in ImFontBaked::IndexPages[]
+
 // Data available to potential texture post-processing functions
 struct ImFontAtlasPostProcessData
 {
@@ -3858,6 +3913,18 @@ typedef stbrp_node stbrp_node_im;
 #endif
 struct stbrp_context_opaque { char data[80]; };
 
+// Font cache counters, cumulative since the builder was created. Displayed in Metrics/Debugger->Fonts.
+struct ImFontAtlasCacheStats
+{
+    ImU64                       BakedHits;              // ImFontAtlasBakedGetOrAdd() found an existing baked size.
+    ImU64                       BakedMisses;            // A new baked size was created.
+    ImU64                       GlyphHits;              // Glyph quads emitted by RenderText()/RenderChar() (includes glyphs just loaded).
+    ImU64                       GlyphMisses;            // Glyphs requested from the font loader.
+    ImU64                       BakedEvictions;         // Baked sizes discarded to honor TexMemoryBudget.
+    ImU64                       GlyphEvictions;         // Glyphs discarded to honor TexMemoryBudget.
+    ImU64                       Compactions;            // Idle-frame repacks to honor TexMemoryBudget.
+};
+
 // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasBuilder
 {
@@ -3876,6 +3943,11 @@ struct ImFontAtlasBuilder
     ImVec2i                     MaxRectBounds;          // Bottom-right most used pixels
     bool                        LockDisableResize;      // Disable resizing texture
     bool                        PreloadedAllGlyphsRanges; // Set when missing ImGuiBackendFlags_RendererHasTextures features forces atlas to preload everything.
+    int                         LastLoadFrame;          // Last frame a baked size or glyph was loaded. Used to detect idle frames.
+    int                         EvictSkipUntilFrame;    // Last budget eviction pass freed nothing: skip it until this frame (data kept for being drawn recently can age out by then, and at least IMGUI_FONT_BUDGET_IDLE_FRAMES later). 0: none.
+    int                         EvictSkipLoadFrame;     // LastLoadFrame when that pass ran (anything loaded since cancels the skip)
+    int                         EvictSkipBudget;        // TexMemoryBudget when that pass ran (a budget change cancels the skip)
+    ImFontAtlasCacheStats       CacheStats;
 
     // Cache of all ImFontBaked
     ImStableVector<ImFontBaked,32> BakedPool;
@@ -3909,6 +3981,8 @@ IMGUI_API void              ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas*
 IMGUI_API void              ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas); // Legacy
 IMGUI_API void              ImFontAtlasBuildGetOversampleFactors(ImFontConfig* src, ImFontBaked* baked, int* out_oversample_h, int* out_oversample_v);
 IMGUI_API void              ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames);
+IMGUI_API void              ImFontAtlasBuildEvictToBudget(ImFontAtlas* atlas, int budget_bytes);
+IMGUI_API int               ImFontAtlasBuildPrebakeGlyphs(ImFontAtlas* atlas, ImFontBaked* baked, const ImWchar* glyph_ranges, int threads_count);
 
 IMGUI_API bool              ImFontAtlasFontSourceInit(ImFontAtlas* atlas, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasFontSourceAddToFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
@@ -3934,7 +4008,7 @@ IMGUI_API ImTextureRect*    ImFontAtlasPackGetRect(ImFontAtlas* atlas, ImFontAtl
 IMGUI_API ImTextureRect*    ImFontAtlasPackGetRectSafe(ImFontAtlas* atlas, ImFontAtlasRectId id);
 IMGUI_API void              ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id);
 
-IMGUI_API void              ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool renderer_has_textures);
+IMGUI_API void              ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool renderer_has_textures, bool renderer_has_sdf_text = false);
 IMGUI_API void              ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data);
 IMGUI_API void              ImFontAtlasRemoveDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data);
 IMGUI_API void              ImFontAtlasUpdateDrawListsTextures(ImFontAtlas* atlas, ImTextureRef old_tex, ImTextureRef new_tex);
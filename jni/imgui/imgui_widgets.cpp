@@ -4372,13 +4372,12 @@ void ImGui::PushPasswordFont()
 {
     ImGuiContext& g = *GImGui;
     ImFontBaked* backup = &g.InputTextPasswordFontBackupBaked;
-    IM_ASSERT(backup->IndexAdvanceX.Size == 0 && backup->IndexLookup.Size == 0);
+    IM_ASSERT(backup->IndexPages.Size == 0);
     ImFontGlyph* glyph = g.FontBaked->FindGlyph('*');
     g.InputTextPasswordFontBackupFlags = g.Font->Flags;
     backup->FallbackGlyphIndex = g.FontBaked->FallbackGlyphIndex;
     backup->FallbackAdvanceX = g.FontBaked->FallbackAdvanceX;
-    backup->IndexLookup.swap(g.FontBaked->IndexLookup);
-    backup->IndexAdvanceX.swap(g.FontBaked->IndexAdvanceX);
+    backup->IndexPages.swap(g.FontBaked->IndexPages);
     g.Font->Flags |= ImFontFlags_NoLoadGlyphs;
     g.FontBaked->FallbackGlyphIndex = g.FontBaked->Glyphs.index_from_ptr(glyph);
     g.FontBaked->FallbackAdvanceX = glyph->AdvanceX;
@@ -4391,9 +4390,8 @@ void ImGui::PopPasswordFont()
     g.Font->Flags = g.InputTextPasswordFontBackupFlags;
     g.FontBaked->FallbackGlyphIndex = backup->FallbackGlyphIndex;
     g.FontBaked->FallbackAdvanceX = backup->FallbackAdvanceX;
-    g.FontBaked->IndexLookup.swap(backup->IndexLookup);
-    g.FontBaked->IndexAdvanceX.swap(backup->IndexAdvanceX);
-    IM_ASSERT(backup->IndexAdvanceX.Size == 0 && backup->IndexLookup.Size == 0);
+    g.FontBaked->IndexPages.swap(backup->IndexPages);
+    IM_ASSERT(backup->IndexPages.Size == 0);
 }
 
 // Return false to discard a character.
@@ -4543,6 +4541,7 @@ void ImGui::InputTextDeactivateHook(ImGuiID id)
     ImGuiInputTextState* state = &g.InputTextState;
     if (id == 0 || state->ID != id)
         return;
+    g.IO.SetInputComposition(NULL); // A composition belongs to the InputText it was started in: don't carry it over to the next one
     g.InputTextDeactivatedState.ID = state->ID;
     if (state->Flags & ImGuiInputTextFlags_ReadOnly)
     {
@@ -5602,6 +5601,24 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             ime_data->InputPos = ImVec2(cursor_screen_pos.x - 1.0f, cursor_screen_pos.y - g.FontSize);
             ime_data->InputLineHeight = g.FontSize;
             ime_data->ViewportId = window->Viewport->ID;
+
+            // IME composition (io.SetInputComposition()): drawn over the text at the cursor, on the foreground draw list so the frame doesn't clip it.
+            // It only enters the buffer once committed, so composing measures the composition string alone and never re-lays out the buffer.
+            if (io.InputComposition.Size > 1 && !is_password)
+            {
+                const char* comp_begin = io.InputComposition.Data;
+                const char* comp_end = comp_begin + io.InputComposition.Size - 1;
+                ImDrawList* fg_draw_list = GetForegroundDrawList(window->Viewport);
+                const ImVec2 comp_pos(cursor_screen_pos.x, cursor_screen_pos.y - g.FontSize);
+                const float comp_width = CalcTextSize(comp_begin, comp_end).x;
+                const float comp_cursor_x = comp_pos.x + CalcTextSize(comp_begin, comp_begin + io.InputCompositionCursor).x;
+                const ImU32 comp_text_col = GetColorU32(ImGuiCol_Text);
+                fg_draw_list->AddRectFilled(comp_pos, ImVec2(comp_pos.x + comp_width + 1.0f, cursor_screen_pos.y), GetColorU32(ImGuiCol_PopupBg));
+                fg_draw_list->AddText(g.Font, g.FontSize, comp_pos, comp_text_col, comp_begin, comp_end);
+                fg_draw_list->AddLine(ImVec2(comp_pos.x, cursor_screen_pos.y - 1.0f), ImVec2(comp_pos.x + comp_width, cursor_screen_pos.y - 1.0f), comp_text_col, 1.0f);
+                if (cursor_is_visible)
+                    fg_draw_list->AddLine(ImVec2(comp_cursor_x, cursor_screen_rect.Min.y), ImVec2(comp_cursor_x, cursor_screen_rect.Max.y), GetColorU32(ImGuiCol_InputTextCursor), 1.0f);
+            }
         }
     }
 
@@ -29,18 +29,31 @@
 #include <android/native_window.h>
 #include <android/log.h>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <sys/system_properties.h>
+#include <sys/wait.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <charconv>
 #include <array>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
+#include <functional>
 #include <chrono>
 #include <climits>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+#include "DisplayChangeDetector.h"
 
 // Log system configuration
 #ifndef SURFACE_LOG_TAG
@@ -99,12 +112,19 @@
     #define SURFACE_LOG_TRACE(fmt, ...)   ((void)0)
 #endif
 
-#define ResolveMethod(ClassName, MethodName, Handle, MethodSignature)                                                                    \
-    ClassName##__##MethodName = reinterpret_cast<decltype(ClassName##__##MethodName)>(symbolMethod.Find(Handle, MethodSignature));       \
-    if (nullptr == ClassName##__##MethodName)                                                                                            \
-    {                                                                                                                                    \
-        SURFACE_LOG_ERROR("Method not found: %s -> %s::%s", MethodSignature, #ClassName, #MethodName); \
-    }
+// Persistent cache of which symbol signature variants matched on this build, "" to disable.
+// Only read back when owned by this process' user and not writable by anyone else.
+#ifndef SURFACE_SYMBOL_CACHE_PATH
+#define SURFACE_SYMBOL_CACHE_PATH "/data/local/tmp/.ANativeWindowCreator.symbols"
+#endif
+
+// Table entry for Functionals::GetSymbolTable()
+#define FunctionalsSymbol(Feature, Library, ClassName, MethodName, MinVersion, MaxVersion, MethodSignature) \
+    {Feature, Library, #ClassName "::" #MethodName, offsetof(Functionals, ClassName##__##MethodName), MinVersion, MaxVersion, MethodSignature, 0}
+
+// Variant with the exact same C++ prototype as the other variants sharing 'Prototype' (non-zero), e.g. a class moved to another namespace
+#define FunctionalsSymbolPrototype(Feature, Library, ClassName, MethodName, MinVersion, MaxVersion, MethodSignature, Prototype) \
+    {Feature, Library, #ClassName "::" #MethodName, offsetof(Functionals, ClassName##__##MethodName), MinVersion, MaxVersion, MethodSignature, Prototype}
 
 namespace android {
     namespace detail {
@@ -258,7 +278,44 @@ namespace android {
             // Surface related methods
             void (*Surface__DisConnect)(void *thiz, int32_t api) = nullptr;
 
-            Functionals(const SymbolMethod &symbolMethod)
+            // Symbols are resolved lazily, one feature at a time, on the first GetInstance() asking for it
+            enum Feature : uint32_t {
+                FeatureCore = 1u << 0,         // Reference counting, surface creation, basic transactions
+                FeatureDisplay = 1u << 1,      // Display tokens, state and info
+                FeatureMultiDisplay = 1u << 2, // Mirroring, layer stacks and layer transforms
+                FeatureAll = FeatureCore | FeatureDisplay | FeatureMultiDisplay,
+            };
+
+            enum Library : uint32_t {
+                LibraryGui,
+                LibraryUtils,
+                LibraryCount
+            };
+
+            // Consecutive entries with the same offset are signature variants of one function pointer
+            struct SymbolEntry {
+                Feature feature;
+                Library library;
+                const char *name;
+                size_t offset;
+                size_t minVersion;
+                size_t maxVersion;
+                const char *signature;
+                uint32_t prototype; // Non-zero: variants sharing it can stand in for each other. 0: only used on its own versions.
+            };
+
+            struct StartupReport {
+                bool cacheLoaded = false;
+                uint32_t resolvedFeatures = 0;
+                uint32_t symbolsResolved = 0;
+                uint32_t symbolsMissing = 0;
+                uint32_t lookups = 0;   // dlsym calls
+                uint32_t cacheHits = 0; // Symbols resolved with a single lookup thanks to the variant cache
+                std::chrono::nanoseconds openTime{0};
+                std::chrono::nanoseconds resolveTime{0};
+            };
+
+            Functionals()
             {
                 std::string systemVersionString(128, 0);
 
@@ -267,173 +324,311 @@ namespace android {
                     systemVersion = std::stoi(systemVersionString);
 
                 if (5 > systemVersion)
-                {
                     SURFACE_LOG_ERROR("Unsupported system version: %zu", systemVersion);
-                    return;
-                }
+            }
 
-#ifdef __LP64__
-                auto libgui = symbolMethod.Open("/system/lib64/libgui.so", RTLD_LAZY);
-                auto libutils = symbolMethod.Open("/system/lib64/libutils.so", RTLD_LAZY);
-#else
-                auto libgui = symbolMethod.Open("/system/lib/libgui.so", RTLD_LAZY);
-                auto libutils = symbolMethod.Open("/system/lib/libutils.so", RTLD_LAZY);
-#endif
-                //libutils
-                ResolveMethod(RefBase, IncStrong, libutils, "_ZNK7android7RefBase9incStrongEPKv");
-                ResolveMethod(RefBase, DecStrong, libutils, "_ZNK7android7RefBase9decStrongEPKv");
+            static const std::vector<SymbolEntry> &GetSymbolTable() {
+                static const std::vector<SymbolEntry> symbolTable = {
+                    // libutils
+                    FunctionalsSymbol(FeatureCore, LibraryUtils, RefBase, IncStrong, 5, SIZE_MAX, "_ZNK7android7RefBase9incStrongEPKv"),
+                    FunctionalsSymbol(FeatureCore, LibraryUtils, RefBase, DecStrong, 5, SIZE_MAX, "_ZNK7android7RefBase9decStrongEPKv"),
+                    FunctionalsSymbol(FeatureCore, LibraryUtils, String8, Constructor, 5, SIZE_MAX, "_ZN7android7String8C2EPKc"),
+                    FunctionalsSymbol(FeatureCore, LibraryUtils, String8, Destructor, 5, SIZE_MAX, "_ZN7android7String8D2Ev"),
+
+                    // libgui
+                    FunctionalsSymbolPrototype(FeatureCore, LibraryGui, LayerMetadata, Constructor, 10, 13, "_ZN7android13LayerMetadataC2Ev", 1),
+                    FunctionalsSymbolPrototype(FeatureCore, LibraryGui, LayerMetadata, Constructor, 14, SIZE_MAX, "_ZN7android3gui13LayerMetadataC2Ev", 1),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, LayerMetadata, setInt32, 10, 13, "_ZN7android13LayerMetadata8setInt32Eji"),
+
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, Constructor, 5, SIZE_MAX, "_ZN7android21SurfaceComposerClientC2Ev"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface, 5, 7, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8Ejjij"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface, 10, 10, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlENS_13LayerMetadataE"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface, 11, 11, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlENS_13LayerMetadataEPj"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface, 12, 13, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijRKNS_2spINS_7IBinderEEENS_13LayerMetadataEPj"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface, 14, SIZE_MAX, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjiiRKNS_2spINS_7IBinderEEENS_3gui13LayerMetadataEPj"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface_and8, 8, 8, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlEjj"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CreateSurface_and9, 9, 9, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlEii"),
+
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, OpenGlobalTransaction, 5, 8, "_ZN7android21SurfaceComposerClient21openGlobalTransactionEv"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient, CloseGlobalTransaction, 5, 8, "_ZN7android21SurfaceComposerClient22closeGlobalTransactionEb"),
+
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, Constructor, 12, SIZE_MAX, "_ZN7android21SurfaceComposerClient11TransactionC2Ev"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, SetLayer, 9, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction8setLayerERKNS_2spINS_14SurfaceControlEEEi"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, Show, 9, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction4showERKNS_2spINS_14SurfaceControlEEE"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, Hide, 9, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction4hideERKNS_2spINS_14SurfaceControlEEE"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, SetTrustedOverlay, 12, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction17setTrustedOverlayERKNS_2spINS_14SurfaceControlEEEb"),
+                    // Android 9-12 two-parameter version, 13+ three-parameter version
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, Apply, 9, 12, "_ZN7android21SurfaceComposerClient11Transaction5applyEb"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceComposerClient__Transaction, Apply, 13, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction5applyEbb"),
+
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, Validate, 5, SIZE_MAX, "_ZNK7android14SurfaceControl8validateEv"),
+                    // Android 5-11 const version, 12+ non-const version
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, GetSurface, 5, 11, "_ZNK7android14SurfaceControl10getSurfaceEv"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, GetSurface, 12, SIZE_MAX, "_ZN7android14SurfaceControl10getSurfaceEv"),
+                    // Android 5-6 use Surface::disconnect, 7+ SurfaceControl::disconnect
+                    FunctionalsSymbol(FeatureCore, LibraryGui, Surface, DisConnect, 5, 6, "_ZN7android7Surface10disconnectEi"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, DisConnect, 7, SIZE_MAX, "_ZN7android14SurfaceControl10disconnectEv"),
+                    // Android 5 and 8 use int version, 6-7 uint version
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, SetLayer, 5, 5, "_ZN7android14SurfaceControl8setLayerEi"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, SetLayer, 6, 7, "_ZN7android14SurfaceControl8setLayerEj"),
+                    FunctionalsSymbol(FeatureCore, LibraryGui, SurfaceControl, SetLayer, 8, 8, "_ZN7android14SurfaceControl8setLayerEi"),
+
+                    // Display related methods
+                    FunctionalsSymbol(FeatureDisplay, LibraryGui, SurfaceComposerClient, GetBuiltInDisplay, 5, 9, "_ZN7android21SurfaceComposerClient17getBuiltInDisplayEi"),
+                    FunctionalsSymbol(FeatureDisplay, LibraryGui, SurfaceComposerClient, GetInternalDisplayToken, 10, 13, "_ZN7android21SurfaceComposerClient23getInternalDisplayTokenEv"),
+                    FunctionalsSymbol(FeatureDisplay, LibraryGui, SurfaceComposerClient, GetPhysicalDisplayIds, 10, SIZE_MAX, "_ZN7android21SurfaceComposerClient21getPhysicalDisplayIdsEv"),
+                    FunctionalsSymbol(FeatureDisplay, LibraryGui, SurfaceComposerClient, GetPhysicalDisplayToken, 12, SIZE_MAX, "_ZN7android21SurfaceComposerClient23getPhysicalDisplayTokenENS_17PhysicalDisplayIdE"),
+                    FunctionalsSymbol(FeatureDisplay, LibraryGui, SurfaceComposerClient, GetDisplayInfo, 5, 11, "_ZN7android21SurfaceComposerClient14getDisplayInfoERKNS_2spINS_7IBinderEEEPNS_11DisplayInfoE"),
+                    FunctionalsSymbol(FeatureDisplay, LibraryGui, SurfaceComposerClient, GetDisplayState, 11, SIZE_MAX, "_ZN7android21SurfaceComposerClient15getDisplayStateERKNS_2spINS_7IBinderEEEPNS_2ui12DisplayStateE"),
+
+                    // Multi display methods
+                    FunctionalsSymbol(FeatureMultiDisplay, LibraryGui, SurfaceComposerClient, MirrorSurface, 11, SIZE_MAX, "_ZN7android21SurfaceComposerClient13mirrorSurfaceEPNS_14SurfaceControlE"),
+                    FunctionalsSymbol(FeatureMultiDisplay, LibraryGui, SurfaceComposerClient__Transaction, Reparent, 12, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction8reparentERKNS_2spINS_14SurfaceControlEEES6_"),
+                    FunctionalsSymbol(FeatureMultiDisplay, LibraryGui, SurfaceComposerClient__Transaction, SetMatrix, 9, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction9setMatrixERKNS_2spINS_14SurfaceControlEEEffff"),
+                    FunctionalsSymbol(FeatureMultiDisplay, LibraryGui, SurfaceComposerClient__Transaction, SetPosition, 5, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction11setPositionERKNS_2spINS_14SurfaceControlEEEff"),
+                    FunctionalsSymbol(FeatureMultiDisplay, LibraryGui, SurfaceComposerClient__Transaction, SetLayerStack, 13, SIZE_MAX, "_ZN7android21SurfaceComposerClient11Transaction13setLayerStackERKNS_2spINS_14SurfaceControlEEENS_2ui10LayerStackE"),
+                };
+                return symbolTable;
+            }
 
-                ResolveMethod(String8, Constructor, libutils, "_ZN7android7String8C2EPKc");
-                ResolveMethod(String8, Destructor, libutils, "_ZN7android7String8D2Ev");
-                
-                //libgui
-                if (10 <= systemVersion && 13 >= systemVersion) {
-                    ResolveMethod(LayerMetadata, Constructor, libgui, "_ZN7android13LayerMetadataC2Ev");
-                    ResolveMethod(LayerMetadata, setInt32, libgui, "_ZN7android13LayerMetadata8setInt32Eji");
-                } else if (14 <= systemVersion) {
-                    ResolveMethod(LayerMetadata, Constructor, libgui, "_ZN7android3gui13LayerMetadataC2Ev");
-                }
+            // Resolves features on demand. The variant expected for this Android version is probed first, then variants with the
+            // exact same C++ prototype (for ROMs with backported symbols), and the matching variant is cached per build fingerprint,
+            // so later launches do a single dlsym per symbol. Misses aren't cached: a failed dlopen/dlsym is retried on the next launch. Variants with another prototype are never bound: calling them through
+            // the slot's function pointer type would corrupt arguments, so the slot stays null and the feature reports it as missing.
+            class SymbolResolver
+            {
+            public:
+                SymbolResolver(Functionals &functionals, const SymbolMethod &symbolMethod) : m_functionals(functionals), m_symbolMethod(symbolMethod) {}
+
+                void Require(uint32_t features) {
+                    if (0 == (features & ~m_resolvedFeatures.load(std::memory_order_acquire)))
+                        return;
+
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    uint32_t pending = features & ~m_resolvedFeatures.load(std::memory_order_relaxed);
+                    if (0 == pending)
+                        return;
+
+                    if (5 <= m_functionals.systemVersion) {
+                        auto startTime = std::chrono::steady_clock::now();
+                        if (!m_opened)
+                            Open();
+
+                        auto &symbolTable = GetSymbolTable();
+                        for (size_t i = 0; i < symbolTable.size();) {
+                            size_t end = i + 1;
+                            while (end < symbolTable.size() && symbolTable[end].offset == symbolTable[i].offset)
+                                end++;
+                            if (pending & symbolTable[i].feature)
+                                ResolveSymbol(&symbolTable[i], end - i);
+                            i = end;
+                        }
+                        if (m_cacheDirty)
+                            SaveCache();
+
+                        auto resolveTime = std::chrono::steady_clock::now() - startTime;
+                        m_report.resolveTime += std::chrono::duration_cast<std::chrono::nanoseconds>(resolveTime);
+                        SURFACE_LOG_INFO("Resolved features 0x%x in %.3f ms (dlopen %.3f ms, %u symbols, %u missing, %u lookups, %u cache hits)", pending,
+                                         std::chrono::duration<double, std::milli>(resolveTime).count(), std::chrono::duration<double, std::milli>(m_report.openTime).count(),
+                                         m_report.symbolsResolved, m_report.symbolsMissing, m_report.lookups, m_report.cacheHits);
+                    }
 
-                ResolveMethod(SurfaceComposerClient, Constructor, libgui, "_ZN7android21SurfaceComposerClientC2Ev");
-
-                // Select the correct CreateSurface API based on Android version
-                if (5 <= systemVersion && 7 >= systemVersion) {
-                    // Android 5-7
-                    ResolveMethod(SurfaceComposerClient, CreateSurface, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8Ejjij");
-                } else if (8 == systemVersion) {
-                    // Android 8
-                    ResolveMethod(SurfaceComposerClient, CreateSurface_and8, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlEjj");
-                } else if (9 == systemVersion) {
-                    // Android 9
-                    ResolveMethod(SurfaceComposerClient, CreateSurface_and9, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlEii");
-                } else if (10 == systemVersion) {
-                    // Android 10
-                    ResolveMethod(SurfaceComposerClient, CreateSurface, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlENS_13LayerMetadataE");
-                } else if (11 == systemVersion) {
-                    // Android 11
-                    ResolveMethod(SurfaceComposerClient, CreateSurface, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijPNS_14SurfaceControlENS_13LayerMetadataEPj");
-                } else if (12 <= systemVersion && 13 >= systemVersion) {
-                    // Android 12-13
-                    ResolveMethod(SurfaceComposerClient, CreateSurface, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjijRKNS_2spINS_7IBinderEEENS_13LayerMetadataEPj");
-                } else if (14 <= systemVersion) {
-                    // Android 14+
-                    ResolveMethod(SurfaceComposerClient, CreateSurface, libgui, "_ZN7android21SurfaceComposerClient13createSurfaceERKNS_7String8EjjiiRKNS_2spINS_7IBinderEEENS_3gui13LayerMetadataEPj");
-                }
-                
-                // MirrorSurface method - Android 11+
-                if (11 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient, MirrorSurface, libgui, "_ZN7android21SurfaceComposerClient13mirrorSurfaceEPNS_14SurfaceControlE");
-                }
-                
-                // Display related methods - version specific selection
-                if (5 <= systemVersion && 9 >= systemVersion) {
-                    // Android 5-9 uses GetBuiltInDisplay
-                    ResolveMethod(SurfaceComposerClient, GetBuiltInDisplay, libgui, "_ZN7android21SurfaceComposerClient17getBuiltInDisplayEi");
-                }
-                if (10 <= systemVersion && 13 >= systemVersion) {
-                    // Android 10-13 uses GetInternalDisplayToken
-                    ResolveMethod(SurfaceComposerClient, GetInternalDisplayToken, libgui, "_ZN7android21SurfaceComposerClient23getInternalDisplayTokenEv");
-                }
-                if (10 <= systemVersion) {
-                    // Android 10+ uses GetPhysicalDisplayIds
-                    ResolveMethod(SurfaceComposerClient, GetPhysicalDisplayIds, libgui, "_ZN7android21SurfaceComposerClient21getPhysicalDisplayIdsEv");
-                }
-                if (12 <= systemVersion) {
-                    // Android 12+ uses GetPhysicalDisplayToken
-                    ResolveMethod(SurfaceComposerClient, GetPhysicalDisplayToken, libgui, "_ZN7android21SurfaceComposerClient23getPhysicalDisplayTokenENS_17PhysicalDisplayIdE");
-                }
-                
-                // Display state and info retrieval methods
-                if (5 <= systemVersion && 11 >= systemVersion) {
-                    // Android 5-11 uses GetDisplayInfo
-                    ResolveMethod(SurfaceComposerClient, GetDisplayInfo, libgui, "_ZN7android21SurfaceComposerClient14getDisplayInfoERKNS_2spINS_7IBinderEEEPNS_11DisplayInfoE");
-                }
-                if (11 <= systemVersion) {
-                    // Android 11+ uses GetDisplayState
-                    ResolveMethod(SurfaceComposerClient, GetDisplayState, libgui, "_ZN7android21SurfaceComposerClient15getDisplayStateERKNS_2spINS_7IBinderEEEPNS_2ui12DisplayStateE");
+                    m_report.resolvedFeatures |= pending;
+                    m_resolvedFeatures.store(m_report.resolvedFeatures, std::memory_order_release);
                 }
 
-                // GlobalTransaction methods - Android 5-8 only
-                if (5 <= systemVersion && 8 >= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient, OpenGlobalTransaction, libgui, "_ZN7android21SurfaceComposerClient21openGlobalTransactionEv");
-                    ResolveMethod(SurfaceComposerClient, CloseGlobalTransaction, libgui, "_ZN7android21SurfaceComposerClient22closeGlobalTransactionEb");
+                StartupReport GetReport() {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_report;
                 }
 
-                // Transaction related methods - Android 9+
-                if (12 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient__Transaction, Constructor, libgui, "_ZN7android21SurfaceComposerClient11TransactionC2Ev");
-                }
-                if (9 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient__Transaction, SetLayer, libgui, "_ZN7android21SurfaceComposerClient11Transaction8setLayerERKNS_2spINS_14SurfaceControlEEEi");
-                    ResolveMethod(SurfaceComposerClient__Transaction, Show, libgui, "_ZN7android21SurfaceComposerClient11Transaction4showERKNS_2spINS_14SurfaceControlEEE");
-                    ResolveMethod(SurfaceComposerClient__Transaction, Hide, libgui, "_ZN7android21SurfaceComposerClient11Transaction4hideERKNS_2spINS_14SurfaceControlEEE");
+                Functionals &GetFunctionals() {
+                    return m_functionals;
                 }
-                if (12 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient__Transaction, SetTrustedOverlay, libgui, "_ZN7android21SurfaceComposerClient11Transaction17setTrustedOverlayERKNS_2spINS_14SurfaceControlEEEb");
-                    ResolveMethod(SurfaceComposerClient__Transaction, Reparent, libgui, "_ZN7android21SurfaceComposerClient11Transaction8reparentERKNS_2spINS_14SurfaceControlEEES6_");
-                }
-                if (9 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient__Transaction, SetMatrix, libgui, "_ZN7android21SurfaceComposerClient11Transaction9setMatrixERKNS_2spINS_14SurfaceControlEEEffff");
-                }
-                if (5 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient__Transaction, SetPosition, libgui, "_ZN7android21SurfaceComposerClient11Transaction11setPositionERKNS_2spINS_14SurfaceControlEEEff");
-                }
-                if (13 <= systemVersion) {
-                    ResolveMethod(SurfaceComposerClient__Transaction, SetLayerStack, libgui, "_ZN7android21SurfaceComposerClient11Transaction13setLayerStackERKNS_2spINS_14SurfaceControlEEENS_2ui10LayerStackE");
-                }
-                
-                // Transaction Apply method - version specific selection
-                if (9 <= systemVersion && 12 >= systemVersion) {
-                    // Android 9-12 uses two-parameter version
-                    ResolveMethod(SurfaceComposerClient__Transaction, Apply, libgui, "_ZN7android21SurfaceComposerClient11Transaction5applyEb");
-                }
-                if (13 <= systemVersion) {
-                    // Android 13+ uses three-parameter version
-                    ResolveMethod(SurfaceComposerClient__Transaction, Apply, libgui, "_ZN7android21SurfaceComposerClient11Transaction5applyEbb");
+
+            private:
+                // Libraries stay loaded for the lifetime of the process, resolved pointers must remain valid
+                void Open() {
+                    auto startTime = std::chrono::steady_clock::now();
+#ifdef __LP64__
+                    m_libraries[LibraryGui] = m_symbolMethod.Open("/system/lib64/libgui.so", RTLD_LAZY);
+                    m_libraries[LibraryUtils] = m_symbolMethod.Open("/system/lib64/libutils.so", RTLD_LAZY);
+#else
+                    m_libraries[LibraryGui] = m_symbolMethod.Open("/system/lib/libgui.so", RTLD_LAZY);
+                    m_libraries[LibraryUtils] = m_symbolMethod.Open("/system/lib/libutils.so", RTLD_LAZY);
+#endif
+                    m_report.openTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+                    m_opened = true;
+                    LoadCache();
                 }
 
-                // SurfaceControl related methods
-                if (5 <= systemVersion) {
-                    ResolveMethod(SurfaceControl, Validate, libgui, "_ZNK7android14SurfaceControl8validateEv");
+                void *Lookup(const SymbolEntry &entry) {
+                    if (nullptr == m_libraries[entry.library])
+                        return nullptr;
+
+                    m_report.lookups++;
+                    return m_symbolMethod.Find(m_libraries[entry.library], entry.signature);
                 }
-                
-                // SurfaceControl GetSurface method - version specific selection
-                if (5 <= systemVersion && 11 >= systemVersion) {
-                    // Android 5-11 uses const version
-                    ResolveMethod(SurfaceControl, GetSurface, libgui, "_ZNK7android14SurfaceControl10getSurfaceEv");
+
+                bool IsExpected(const SymbolEntry &entry) const {
+                    return entry.minVersion <= m_functionals.systemVersion && m_functionals.systemVersion <= entry.maxVersion;
                 }
-                if (12 <= systemVersion) {
-                    // Android 12+ uses non-const version
-                    ResolveMethod(SurfaceControl, GetSurface, libgui, "_ZN7android14SurfaceControl10getSurfaceEv");
+
+                static bool CanStandIn(const SymbolEntry &expected, const SymbolEntry &variant) {
+                    return &expected == &variant || (0 != expected.prototype && expected.prototype == variant.prototype);
                 }
-                
-                // DisConnect method - version specific selection
-                if (5 <= systemVersion && 6 >= systemVersion) {
-                    // Android 5-6 uses Surface::disconnect
-                    ResolveMethod(Surface, DisConnect, libgui, "_ZN7android7Surface10disconnectEi");
+
+                void ResolveSymbol(const SymbolEntry *variants, size_t variantCount) {
+                    const SymbolEntry *expected = nullptr;
+                    for (size_t i = 0; i < variantCount && !expected; i++) {
+                        if (IsExpected(variants[i]))
+                            expected = &variants[i];
+                    }
+                    if (!expected)
+                        return; // Not used on this Android version
+
+                    auto &slot = *reinterpret_cast<void **>(reinterpret_cast<char *>(&m_functionals) + variants[0].offset);
+                    auto cached = m_cache.find(variants[0].name);
+                    if (cached != m_cache.end()) {
+                        // Entries written by older versions may point to a variant with another prototype: probe again then
+                        if (static_cast<size_t>(cached->second) < variantCount && CanStandIn(*expected, variants[cached->second]) && nullptr != (slot = Lookup(variants[cached->second]))) {
+                            m_report.cacheHits++;
+                            m_report.symbolsResolved++;
+                            return;
+                        }
+                    }
+
+                    int matched = -1;
+                    if (nullptr != (slot = Lookup(*expected)))
+                        matched = static_cast<int>(expected - variants);
+                    for (size_t i = 0; i < variantCount && 0 > matched; i++) {
+                        if (&variants[i] == expected || !CanStandIn(*expected, variants[i]))
+                            continue;
+                        if (nullptr != (slot = Lookup(variants[i])))
+                            matched = static_cast<int>(i);
+                    }
+
+                    if (0 > matched) {
+                        m_report.symbolsMissing++;
+                        SURFACE_LOG_ERROR("Method not found: %s -> %s", expected->signature, variants[0].name);
+                        if (cached != m_cache.end()) {
+                            m_cache.erase(cached);
+                            m_cacheDirty = true;
+                        }
+                        return;
+                    }
+
+                    m_report.symbolsResolved++;
+                    if (&variants[matched] != expected)
+                        SURFACE_LOG_INFO("Method %s resolved with same prototype variant %s", variants[0].name, variants[matched].signature);
+                    m_cache[variants[0].name] = matched;
+                    m_cacheDirty = true;
                 }
-                if (7 <= systemVersion) {
-                    // Android 7+ uses SurfaceControl::disconnect
-                    ResolveMethod(SurfaceControl, DisConnect, libgui, "_ZN7android14SurfaceControl10disconnectEv");
+
+                static std::string GetCacheKey() {
+                    char fingerprint[PROP_VALUE_MAX] = {};
+                    char buildDate[PROP_VALUE_MAX] = {};
+                    __system_property_get("ro.build.fingerprint", fingerprint);
+                    __system_property_get("ro.build.date.utc", buildDate);
+#ifdef __LP64__
+                    return std::string(fingerprint) + "|" + buildDate + "|64";
+#else
+                    return std::string(fingerprint) + "|" + buildDate + "|32";
+#endif
                 }
-                
-                // SetLayer method - version specific selection
-                if (5 == systemVersion || 8 == systemVersion) {
-                    // Android 5 and 8+ use int version
-                    ResolveMethod(SurfaceControl, SetLayer, libgui, "_ZN7android14SurfaceControl8setLayerEi");
+
+                // Line 1: build key, then one "<name> <variant index>" line per resolved symbol.
+                // The default path is in a directory other users may write to: the file is only trusted when it is a regular file
+                // owned by this user and writable by nobody else, and indices are range checked against the table when used.
+                void LoadCache() {
+                    if (0 == sizeof(SURFACE_SYMBOL_CACHE_PATH) - 1)
+                        return;
+
+                    int fd = open(SURFACE_SYMBOL_CACHE_PATH, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+                    if (0 > fd)
+                        return;
+
+                    struct stat info;
+                    if (0 != fstat(fd, &info) || !S_ISREG(info.st_mode) || geteuid() != info.st_uid || 0 != (info.st_mode & (S_IWGRP | S_IWOTH))) {
+                        SURFACE_LOG_WARN("Ignoring symbol cache not owned by this user or writable by others: %s", SURFACE_SYMBOL_CACHE_PATH);
+                        close(fd);
+                        return;
+                    }
+
+                    auto file = fdopen(fd, "r");
+                    if (!file) {
+                        close(fd);
+                        return;
+                    }
+
+                    char line[256];
+                    auto key = GetCacheKey() + "\n";
+                    if (fgets(line, sizeof(line), file) && key == line) {
+                        char name[128];
+                        int variant;
+                        while (2 == fscanf(file, "%127s %d", name, &variant)) {
+                            if (0 <= variant) // Older versions also stored misses as -1
+                                m_cache[name] = variant;
+                        }
+                        m_report.cacheLoaded = true;
+                    }
+                    fclose(file);
                 }
-                if (6 <= systemVersion && 7 >= systemVersion) {
-                    // Android 6-7 use uint version
-                    ResolveMethod(SurfaceControl, SetLayer, libgui, "_ZN7android14SurfaceControl8setLayerEj");
+
+                // Written to a fresh private file then renamed over the cache, so a link planted at either path isn't followed
+                void SaveCache() {
+                    m_cacheDirty = false;
+                    if (0 == sizeof(SURFACE_SYMBOL_CACHE_PATH) - 1)
+                        return;
+
+                    std::string temporaryPath = std::string(SURFACE_SYMBOL_CACHE_PATH) + ".tmp";
+                    unlink(temporaryPath.c_str());
+                    int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+                    if (0 > fd)
+                        return;
+
+                    auto file = fdopen(fd, "w");
+                    if (!file) {
+                        close(fd);
+                        unlink(temporaryPath.c_str());
+                        return;
+                    }
+
+                    fprintf(file, "%s\n", GetCacheKey().c_str());
+                    for (auto &[name, variant] : m_cache)
+                        fprintf(file, "%s %d\n", name.c_str(), variant);
+                    if (0 != fclose(file) || 0 != rename(temporaryPath.c_str(), SURFACE_SYMBOL_CACHE_PATH)) {
+                        SURFACE_LOG_WARN("Failed to write symbol cache: %s", SURFACE_SYMBOL_CACHE_PATH);
+                        unlink(temporaryPath.c_str());
+                    }
                 }
 
-                symbolMethod.Close(libutils);
-                symbolMethod.Close(libgui);
+                Functionals &m_functionals;
+                SymbolMethod m_symbolMethod;
+                std::array<void *, LibraryCount> m_libraries{};
+                std::unordered_map<std::string, int> m_cache;
+                std::atomic<uint32_t> m_resolvedFeatures{0};
+                std::mutex m_mutex;
+                StartupReport m_report;
+                bool m_opened = false;
+                bool m_cacheDirty = false;
+            };
+
+            // 'features': which groups of symbols the caller needs, resolved on first request
+            static const Functionals &GetInstance(uint32_t features = FeatureCore) {
+                auto &symbolResolver = GetSymbolResolver();
+                symbolResolver.Require(features);
+                return symbolResolver.GetFunctionals();
+            }
+
+            static StartupReport GetStartupReport() {
+                return GetSymbolResolver().GetReport();
             }
 
-            static const Functionals &GetInstance(const SymbolMethod &symbolMethod = {.Open = dlopen, .Find = dlsym, .Close = dlclose}) {
-                static Functionals functionals(symbolMethod);
-                return functionals;
+            static SymbolResolver &GetSymbolResolver(const SymbolMethod &symbolMethod = {.Open = dlopen, .Find = dlsym, .Close = dlclose}) {
+                static Functionals functionals;
+                static SymbolResolver symbolResolver(functionals, symbolMethod);
+                return symbolResolver;
             }
         };
 
@@ -517,6 +712,16 @@ namespace android {
                 Functionals::GetInstance().SurfaceControl__SetLayer(data, z);
             }
 
+            // Drop our strong reference, e.g. for mirror surfaces which have no Surface
+            void Release() {
+                if (nullptr == data)
+                    return;
+
+                DisConnect();
+                Functionals::GetInstance().RefBase__DecStrong(data, nullptr);
+                data = nullptr;
+            }
+
             void DestroySurface(Surface *surface) {
                 if (nullptr == data || nullptr == surface)
                     return;
@@ -543,7 +748,7 @@ namespace android {
             }
 
             void *SetLayerStack(StrongPointer<void> &surfaceControl, uint32_t layerStack) {
-                return Functionals::GetInstance().SurfaceComposerClient__Transaction__SetLayerStack(data, surfaceControl, layerStack);
+                return Functionals::GetInstance(Functionals::FeatureMultiDisplay).SurfaceComposerClient__Transaction__SetLayerStack(data, surfaceControl, layerStack);
             }
 
             void Show(StrongPointer<void> &surfaceControl) {
@@ -555,15 +760,15 @@ namespace android {
             }
 
             void Reparent(StrongPointer<void> &surfaceControl, StrongPointer<void> &newParentHandle) {
-                Functionals::GetInstance().SurfaceComposerClient__Transaction__Reparent(data, surfaceControl, newParentHandle);
+                Functionals::GetInstance(Functionals::FeatureMultiDisplay).SurfaceComposerClient__Transaction__Reparent(data, surfaceControl, newParentHandle);
             }
 
             void *SetMatrix(StrongPointer<void> &surfaceControl, float dsdx, float dtdx, float dtdy, float dsdy) {
-                return Functionals::GetInstance().SurfaceComposerClient__Transaction__SetMatrix(data, surfaceControl, dsdx, dtdx, dtdy, dsdy);
+                return Functionals::GetInstance(Functionals::FeatureMultiDisplay).SurfaceComposerClient__Transaction__SetMatrix(data, surfaceControl, dsdx, dtdx, dtdy, dsdy);
             }
 
             void SetPosition(StrongPointer<void> &surfaceControl, float x, float y) {
-                Functionals::GetInstance().SurfaceComposerClient__Transaction__SetPosition(data, surfaceControl, x, y);
+                Functionals::GetInstance(Functionals::FeatureMultiDisplay).SurfaceComposerClient__Transaction__SetPosition(data, surfaceControl, x, y);
             }
 
             int32_t Apply(bool synchronous, bool oneWay) {
@@ -574,6 +779,122 @@ namespace android {
             }
         };
 
+        // Matrix and position of a mirror layer on a secondary display (SetMatrix / SetPosition)
+        struct MirrorTransform
+        {
+            float dsdx = 1.0f, dtdx = 0.0f, dtdy = 0.0f, dsdy = 1.0f;
+            float x = 0.0f, y = 0.0f;
+
+            // 'offset': the secondary display is rotated relative to the built-in one, only honored on Android 14+
+            static MirrorTransform MakeZoom(float scaleX, float scaleY, uint32_t orientation, bool offset) {
+                MirrorTransform result;
+
+                // SetMatrix parameters: dsdx, dtdx, dtdy, dsdy
+                // For scaling: dsdx=scaleX, dtdx=0, dtdy=0, dsdy=scaleY
+                if (14 <= Functionals::GetInstance().systemVersion && offset) {
+                    switch (orientation) {
+                        case 0:
+                            result.dsdx = scaleX;
+                            result.dsdy = scaleY;
+                            break;
+                        case 1:
+                            result.dsdx = 0.0f;
+                            result.dtdx = scaleY;
+                            result.dtdy = -scaleX;
+                            result.dsdy = 0.0f;
+                            break;
+                        case 2:
+                            result.dsdx = -scaleX;
+                            result.dsdy = -scaleY;
+                            break;
+                        case 3:
+                            result.dsdx = 0.0f;
+                            result.dtdx = -scaleY;
+                            result.dtdy = scaleX;
+                            result.dsdy = 0.0f;
+                            break;
+                    }
+                } else {
+                    result.dsdx = scaleX;
+                    result.dsdy = scaleY;
+                }
+                return result;
+            }
+
+            // Fit the built-in display into the secondary one, keeping aspect ratio and centering it
+            static MirrorTransform MakeFit(int32_t builtinDisplayWidth, int32_t builtinDisplayHeight, int32_t builtinDisplayOrientation, int32_t surfaceDisplayWidth, int32_t surfaceDisplayHeight, bool offset) {
+                float scaleX = static_cast<float>(surfaceDisplayWidth) / builtinDisplayWidth, scaleY = static_cast<float>(surfaceDisplayHeight) / builtinDisplayHeight;
+                int index = 0;
+                if (scaleX <= scaleY) {
+                    scaleY = scaleX;
+                    index = 1;
+                } else {
+                    scaleX = scaleY;
+                    index = 2;
+                }
+
+                auto result = MakeZoom(scaleX, scaleY, builtinDisplayOrientation, offset);
+                float &x = result.x, &y = result.y;
+                if (14 <= Functionals::GetInstance().systemVersion && offset) {
+                    switch (builtinDisplayOrientation) {
+                        case 0: // ROT_0
+                            if (index == 1) {
+                                y = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
+                            } else if (index == 2) {
+                                x = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
+                            }
+                            break;
+                        case 1: // ROT_90
+                            if (index == 1) {
+                                x = surfaceDisplayWidth - (surfaceDisplayWidth - builtinDisplayWidth * scaleY) / 2;
+                            } else if (index == 2) {
+                                x =  surfaceDisplayWidth;
+                                y = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
+                            }
+                            break;
+                        case 2: // ROT_180
+                            if (index == 1) {
+                                x = surfaceDisplayWidth - (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
+                                y = surfaceDisplayHeight;
+                            } else if (index == 2) {
+                                x = surfaceDisplayWidth;
+                                y = surfaceDisplayHeight - (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
+                            }
+                            break;
+                        case 3: // ROT_270
+                            if (index == 1) {
+                                x = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
+                                y = surfaceDisplayHeight;
+                            } else if (index == 2) {
+                                y = builtinDisplayHeight - (surfaceDisplayHeight - builtinDisplayHeight * scaleX) / 2;
+                            }
+                            break;
+                    }
+                } else {
+                    if (index == 1) {
+                        if (builtinDisplayOrientation == 1 || builtinDisplayOrientation == 3) {
+                            x = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
+                        } else {
+                            y = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
+                        }
+                    } else if (index == 2) {
+                        if (builtinDisplayOrientation == 1 || builtinDisplayOrientation == 3) {
+                            y = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
+                        } else {
+                            x = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
+                        }
+                    }
+                }
+                return result;
+            }
+
+            bool operator==(const MirrorTransform &other) const {
+                return dsdx == other.dsdx && dtdx == other.dtdx && dtdy == other.dtdy && dsdy == other.dsdy && x == other.x && y == other.y;
+            }
+
+            bool operator!=(const MirrorTransform &other) const { return !(*this == other); }
+        };
+
         struct SurfaceComposerClient {
             char data[1024];
 
@@ -582,9 +903,26 @@ namespace android {
                 Functionals::GetInstance().RefBase__IncStrong(data, this);
             }
 
-            SurfaceControl CreateSurface(const char *name, int32_t width, int32_t height, uint32_t windowFlags = 0, bool skipScrenshot = false) {
-                static void *parentHandle = nullptr;
-                parentHandle = nullptr;
+            ~SurfaceComposerClient() {
+                for (auto &[mirror, mirrorRoot] : m_legacyMirrorSurfaces) {
+                    mirror.Release();     // Clean up mirror surface
+                    mirrorRoot.Release(); // Clean up mirror root surface
+                }
+            }
+
+            SurfaceComposerClient(const SurfaceComposerClient &) = delete;
+            SurfaceComposerClient &operator=(const SurfaceComposerClient &) = delete;
+
+            // Created on first use, Transaction is only available on Android 12+. Applied right after queueing.
+            SurfaceComposerClientTransaction &GetTransaction() {
+                if (!m_transaction)
+                    m_transaction = std::make_unique<SurfaceComposerClientTransaction>();
+                return *m_transaction;
+            }
+
+            // With 'pendingTransaction', layer setup is queued into it instead of being applied immediately
+            SurfaceControl CreateSurface(const char *name, int32_t width, int32_t height, uint32_t windowFlags = 0, bool skipScrenshot = false, SurfaceComposerClientTransaction *pendingTransaction = nullptr) {
+                void *parentHandle = nullptr;
                 
                 String8 windowName(name);
                 int32_t pixelFormat = 1; // RGBA_8888
@@ -665,10 +1003,11 @@ namespace android {
                 // Apply permission fixes
                 if (12 <= systemVersion) {
                     // Android 12+: Use Transaction mechanism to set trusted overlay and highest layer
-                    static SurfaceComposerClientTransaction transaction;
-                    transaction.SetTrustedOverlay(result, true);
-                    transaction.SetLayer(result, INT_MAX);
-                    (void)transaction.Apply(false, true);  // 用 (void) 强制忽略返回值
+                    auto &target = pendingTransaction ? *pendingTransaction : GetTransaction();
+                    target.SetTrustedOverlay(result, true);
+                    target.SetLayer(result, INT_MAX);
+                    if (!pendingTransaction)
+                        (void)target.Apply(false, true);  // 用 (void) 强制忽略返回值
                 } else if (8 >= systemVersion) {
                     // Android 8 and below: Use global transaction to set layer
                     OpenGlobalTransaction();
@@ -680,20 +1019,20 @@ namespace android {
             }
 
             bool GetDisplayInfo(ui::DisplayState *displayInfo) {
-                static StrongPointer<void> defaultDisplay;
+                auto &defaultDisplay = m_defaultDisplay;
 
                 if (nullptr == defaultDisplay.get()) {
                     if (9 >= Functionals::GetInstance().systemVersion) { // Android 9 and below
-                        defaultDisplay = Functionals::GetInstance().SurfaceComposerClient__GetBuiltInDisplay(ui::DisplayType::DisplayIdMain);
+                        defaultDisplay = Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetBuiltInDisplay(ui::DisplayType::DisplayIdMain);
                     } else {
                         if (14 > Functionals::GetInstance().systemVersion) { // Android 10-13
-                            defaultDisplay = Functionals::GetInstance().SurfaceComposerClient__GetInternalDisplayToken();
+                            defaultDisplay = Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetInternalDisplayToken();
                         } else { // Android 14 and above
-                            auto displayIds = Functionals::GetInstance().SurfaceComposerClient__GetPhysicalDisplayIds();
+                            auto displayIds = Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetPhysicalDisplayIds();
                             if (displayIds.empty())
                                 return false;
 
-                            defaultDisplay = Functionals::GetInstance().SurfaceComposerClient__GetPhysicalDisplayToken(displayIds[0]);
+                            defaultDisplay = Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetPhysicalDisplayToken(displayIds[0]);
                         }
                     }
                 }
@@ -702,10 +1041,10 @@ namespace android {
                     return false;
 
                 if (11 <= Functionals::GetInstance().systemVersion) { // Android 11 and above
-                    return 0 == Functionals::GetInstance().SurfaceComposerClient__GetDisplayState(defaultDisplay, displayInfo);
+                    return 0 == Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetDisplayState(defaultDisplay, displayInfo);
                 } else { // Android 10 and below
                     ui::DisplayInfo realDisplayInfo{};
-                    if (0 != Functionals::GetInstance().SurfaceComposerClient__GetDisplayInfo(defaultDisplay, &realDisplayInfo))
+                    if (0 != Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetDisplayInfo(defaultDisplay, &realDisplayInfo))
                         return false;
 
                     displayInfo->layerStackSpaceRect.width = realDisplayInfo.w;
@@ -724,36 +1063,17 @@ namespace android {
                 Functionals::GetInstance().SurfaceComposerClient__CloseGlobalTransaction(synchronous);
             }
 
-            SurfaceControl MirrorSurface(SurfaceControl &surface, uint32_t layerStack) {
-                using mirror_surfaces_t = std::pair<void *, void *>;
-                constexpr auto MirrorSurfacesDeleter = [](mirror_surfaces_t *pair) {
-                    SurfaceControl fakeSurface;
-
-                    // Clean up mirror surface
-                    if (pair->first) {
-                        Functionals::GetInstance().SurfaceControl__DisConnect(pair->first);
-                        Functionals::GetInstance().RefBase__DecStrong(pair->first, fakeSurface.data);
-                    }
-
-                    // Clean up mirror root surface
-                    if (pair->second) {
-                        Functionals::GetInstance().SurfaceControl__DisConnect(pair->second);
-                        Functionals::GetInstance().RefBase__DecStrong(pair->second, fakeSurface.data);
-                    }
-
-                    delete pair;
-                };
-
-                using mirror_surfaces_proxy_t = std::unique_ptr<mirror_surfaces_t, decltype(MirrorSurfacesDeleter)>;
-
+            // Queues the mirror setup into 'transaction' without applying it. Caller owns both surfaces (SurfaceControl::Release).
+            bool MirrorSurface(SurfaceControl &surface, uint32_t layerStack, SurfaceComposerClientTransaction &transaction, SurfaceControl &outMirror, SurfaceControl &outMirrorRoot) {
                 if (13 > Functionals::GetInstance().systemVersion) {
-                    return {};
+                    return false;
                 }
 
-                auto mirrorSurface = Functionals::GetInstance().SurfaceComposerClient__MirrorSurface(data, surface.data);
+                auto mirrorSurface = Functionals::GetInstance(Functionals::FeatureMultiDisplay).SurfaceComposerClient__MirrorSurface(data, surface.data);
                 if (nullptr == mirrorSurface.get()) {
-                    return {};
+                    return false;
                 }
+                SurfaceControl mirror{mirrorSurface.get()};
 
                 // Get display dimensions
                 int32_t width = -1, height = -1;
@@ -771,83 +1091,59 @@ namespace android {
 
                 // Create mirror root surface
                 auto mirrorRootName = "MirrorRoot@" + std::to_string(layerStack);
-                auto mirrorRootSurface = CreateSurface(mirrorRootName.c_str(), width, height, 0x00004000);
+                auto mirrorRootSurface = CreateSurface(mirrorRootName.c_str(), width, height, 0x00004000, false, &transaction);
                 if (!mirrorRootSurface.data) {
-                    return {};
+                    mirror.Release();
+                    return false;
                 }
 
-                // Set mirror root surface properties
-                static SurfaceComposerClientTransaction transaction;
-                static std::vector<mirror_surfaces_proxy_t> mirrorSurfaces;
-                
                 StrongPointer<void> mirrorRootPtr{mirrorRootSurface.data};
-                StrongPointer<void> mirrorPtr{mirrorSurface.get()};
-                
+                StrongPointer<void> mirrorPtr{mirror.data};
+
+                // Mirror root surface properties
                 transaction.SetLayer(mirrorRootPtr, INT_MAX);
                 transaction.SetLayerStack(mirrorRootPtr, layerStack);
-                transaction.Apply(false, true);
 
-                // Set mirror surface properties
+                // Mirror surface properties
                 transaction.SetLayerStack(mirrorPtr, layerStack);
                 transaction.Show(mirrorPtr);
                 transaction.Reparent(mirrorPtr, mirrorRootPtr);
-                transaction.Apply(false, true);
 
-                // Add mirror surface pair to management container for proper cleanup
-                mirrorSurfaces.emplace_back(
-                    new mirror_surfaces_t{mirrorSurface.get(), mirrorRootSurface.data}, 
-                    MirrorSurfacesDeleter
-                );
+                outMirror = mirror;
+                outMirrorRoot = mirrorRootSurface;
+                return true;
+            }
+
+            SurfaceControl MirrorSurface(SurfaceControl &surface, uint32_t layerStack) {
+                SurfaceControl mirror, mirrorRoot;
+                if (!MirrorSurface(surface, layerStack, GetTransaction(), mirror, mirrorRoot)) {
+                    return {};
+                }
+                GetTransaction().Apply(false, true);
+
+                // Released with this client
+                m_legacyMirrorSurfaces.emplace_back(mirror, mirrorRoot);
 
-                return {mirrorSurface.get()};
+                return mirror;
             }
 
             void ZoomSurface(SurfaceControl &surface, float scaleX, float scaleY, uint32_t orientation, bool offset = false) {
                 if (nullptr == surface.data)
                     return;
 
-                static SurfaceComposerClientTransaction transaction;
+                auto &transaction = GetTransaction();
                 StrongPointer<void> surfacePtr{surface.data};
-                
-                // Use SetMatrix to apply scaling transformation
-                // SetMatrix parameters: dsdx, dtdx, dtdy, dsdy
-                // For scaling: dsdx=scaleX, dtdx=0, dtdy=0, dsdy=scaleY
-                if (14 <= Functionals::GetInstance().systemVersion && offset) {
-                    float dsdx, dtdx, dtdy, dsdy;
-                    switch (orientation) {
-                        case 0:
-                            dsdx = scaleX;
-                            dtdx = 0.0f;
-                            dtdy = 0.0f;
-                            dsdy = scaleY;
-                            break;
-                        case 1:
-                            dsdx = 0.0f;
-                            dtdx = scaleY;
-                            dtdy = -scaleX;
-                            dsdy = 0.0f;
-                            break;
-                        case 2:
-                            dsdx = -scaleX;
-                            dtdx = 0.0f;
-                            dtdy = 0.0f;
-                            dsdy = -scaleY;
-                            break;
-                        case 3:
-                            dsdx = 0.0f;
-                            dtdx = -scaleY;
-                            dtdy = scaleX;
-                            dsdy = 0.0f;
-                            break;
-                    }
-                    transaction.SetMatrix(surfacePtr, dsdx, dtdx, dtdy, dsdy);
-                    SURFACE_LOG_DEBUG("ZoomSurface called with dsdx: %f, dtdx: %f, dtdy: %f, dsdy: %f", dsdx, dtdx, dtdy, dsdy);
-                } else {
-                    transaction.SetMatrix(surfacePtr, scaleX, 0, 0, scaleY);
-                    SURFACE_LOG_DEBUG("ZoomSurface called with scaleX: %f, scaleY: %f", scaleX, scaleY);
-                }
+
+                auto transform = MirrorTransform::MakeZoom(scaleX, scaleY, orientation, offset);
+                transaction.SetMatrix(surfacePtr, transform.dsdx, transform.dtdx, transform.dtdy, transform.dsdy);
+                SURFACE_LOG_DEBUG("ZoomSurface called with dsdx: %f, dtdx: %f, dtdy: %f, dsdy: %f", transform.dsdx, transform.dtdx, transform.dtdy, transform.dsdy);
                 transaction.Apply(false, true);
             }
+
+        private:
+            std::unique_ptr<SurfaceComposerClientTransaction> m_transaction;
+            StrongPointer<void> m_defaultDisplay{};
+            std::vector<std::pair<SurfaceControl, SurfaceControl>> m_legacyMirrorSurfaces;
         };
 
         struct DumpDisplayInfo
@@ -855,6 +1151,7 @@ namespace android {
             std::string uniqueId;
             uint32_t currentLayerStack;
             int32_t orientation = 0;
+            int32_t density = 0; // dpi, 0 if unknown
             std::string type;  // 新增 type 字段
             struct
             {
@@ -864,72 +1161,238 @@ namespace android {
                 int32_t bottom;
             } currentLayerStackRect;
 
-            static DumpDisplayInfo MakeFromRawDumpInfo(const std::string_view &uniqueId, const std::string_view &currentLayerStack, const std::string_view &currentLayerStackRect, const std::string_view &orientation = "", const std::string_view &type = "")
+            template <typename value_t>
+            static bool ParseNumber(std::string_view text, value_t &value)
+            {
+                auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+                return std::errc{} == ec && ptr == text.data() + text.size();
+            }
+
+            // "Rect(0, 0 - 1080, 2400)"
+            static bool ParseRect(std::string_view text, decltype(currentLayerStackRect) &rect)
             {
-                DumpDisplayInfo result;
+                auto pos = text.find('(');
+                if (std::string_view::npos == pos)
+                    return false;
 
-                result.uniqueId = std::string{uniqueId.begin(), uniqueId.end()};
-                result.currentLayerStack = static_cast<uint32_t>(std::stoul(std::string{currentLayerStack.begin(), currentLayerStack.end()}));
-                result.orientation = orientation.empty() ? 0 : std::stoi(std::string{orientation.begin(), orientation.end()});
-                result.type = std::string{type.begin(), type.end()};  // 设置 type 字段
+                const char *it = text.data() + pos + 1, *end = text.data() + text.size();
+                auto number = [&](int32_t &value, std::string_view separator) -> bool {
+                    auto [ptr, ec] = std::from_chars(it, end, value);
+                    if (std::errc{} != ec || std::string_view(ptr, end - ptr).substr(0, separator.size()) != separator)
+                        return false;
+                    it = ptr + separator.size();
+                    return true;
+                };
+                return number(rect.left, ", ") && number(rect.top, " - ") && number(rect.right, ", ") && number(rect.bottom, ")");
+            }
 
-                auto leftPos = currentLayerStackRect.find("(") + 1;
-                auto topPos = currentLayerStackRect.find(", ", leftPos);
-                auto rightPos = currentLayerStackRect.find(" - ", topPos + 2);
-                auto bottomPos = currentLayerStackRect.find(", ", rightPos + 3);
-                auto endPos = currentLayerStackRect.find(")", bottomPos + 2);
+            // Returns false on malformed input instead of throwing
+            bool AssignFromRawDumpInfo(std::string_view uniqueId_, std::string_view currentLayerStack_, std::string_view currentLayerStackRect_, std::string_view orientation_ = "", std::string_view type_ = "")
+            {
+                uniqueId.assign(uniqueId_.data(), uniqueId_.size());
+                type.assign(type_.data(), type_.size());
+                orientation = 0;
+                if (!orientation_.empty() && !ParseNumber(orientation_, orientation))
+                    return false;
 
-                // Don't check it, even though it might cause a crash.
-                result.currentLayerStackRect.left = std::stoi(std::string{currentLayerStackRect.begin() + leftPos, currentLayerStackRect.begin() + topPos});
-                result.currentLayerStackRect.top = std::stoi(std::string{currentLayerStackRect.begin() + topPos + 2, currentLayerStackRect.begin() + rightPos});
-                result.currentLayerStackRect.right = std::stoi(std::string{currentLayerStackRect.begin() + rightPos + 3, currentLayerStackRect.begin() + bottomPos});
-                result.currentLayerStackRect.bottom = std::stoi(std::string{currentLayerStackRect.begin() + bottomPos + 2, currentLayerStackRect.begin() + endPos});
+                return ParseNumber(currentLayerStack_, currentLayerStack) && ParseRect(currentLayerStackRect_, currentLayerStackRect);
+            }
 
+            static DumpDisplayInfo MakeFromRawDumpInfo(const std::string_view &uniqueId, const std::string_view &currentLayerStack, const std::string_view &currentLayerStackRect, const std::string_view &orientation = "", const std::string_view &type = "")
+            {
+                DumpDisplayInfo result{};
+                if (!result.AssignFromRawDumpInfo(uniqueId, currentLayerStack, currentLayerStackRect, orientation, type))
+                    SURFACE_LOG_ERROR("%s -> Malformed display info", result.uniqueId.data());
                 return result;
             }
+
+            bool operator==(const DumpDisplayInfo &other) const
+            {
+                return uniqueId == other.uniqueId && currentLayerStack == other.currentLayerStack && orientation == other.orientation && density == other.density && type == other.type &&
+                       currentLayerStackRect.left == other.currentLayerStackRect.left && currentLayerStackRect.top == other.currentLayerStackRect.top &&
+                       currentLayerStackRect.right == other.currentLayerStackRect.right && currentLayerStackRect.bottom == other.currentLayerStackRect.bottom;
+            }
+
+            bool operator!=(const DumpDisplayInfo &other) const { return !(*this == other); }
         };
 
-        inline std::vector<DumpDisplayInfo> ParseDumpDisplayInfo(const std::string_view &dumpDisplayInfo)
+        // Single pass parser for "dumpsys display" output, fed with chunks as they come out of the pipe.
+        // Each "DisplayDeviceInfo" line starts a record; a field is the first match within its record.
+        // Fields are string_view slices of the current line, records are written into a caller-owned vector
+        // whose elements (and their string capacity) are reused, so steady-state parsing does not allocate.
+        class DumpDisplayInfoParser
         {
-            constexpr auto SubStringView = [](const std::string_view &str, std::string_view start, std::string_view end, int startOffset = 0) -> std::string_view
-            {
-                auto startIt = str.find(start, startOffset);
-                if (std::string::npos == startIt)
-                    return {};
+        public:
+            explicit DumpDisplayInfoParser(std::vector<DumpDisplayInfo> &output) : m_output(output) {
+                m_line.reserve(4096);
+            }
 
-                auto endIt = str.find(end, startIt + start.size());
-                if (std::string::npos == endIt)
-                    return {};
+            void Feed(std::string_view chunk) {
+                while (!chunk.empty()) {
+                    auto lineEnd = chunk.find('\n');
+                    if (std::string_view::npos == lineEnd) {
+                        m_line.append(chunk.data(), chunk.size());
+                        return;
+                    }
+
+                    if (m_line.empty()) {
+                        ParseLine(chunk.substr(0, lineEnd));
+                    } else {
+                        m_line.append(chunk.data(), lineEnd);
+                        ParseLine(m_line);
+                        m_line.clear();
+                    }
+                    chunk.remove_prefix(lineEnd + 1);
+                }
+            }
+
+            // Returns number of displays parsed
+            size_t Finish() {
+                if (!m_line.empty()) {
+                    ParseLine(m_line);
+                    m_line.clear();
+                }
+                EndRecord();
+                m_output.resize(m_count);
+                return m_count;
+            }
 
-                return str.substr(startIt + start.size(), endIt - startIt - start.size());
+        private:
+            enum Field { FieldType, FieldUniqueId, FieldLayerStack, FieldLayerStackRect, FieldOrientation, FieldDensity, FieldCount };
+
+            struct FieldPattern {
+                std::string_view start;
+                char end; // '\0' = end of line
             };
 
-            std::vector<DumpDisplayInfo> result;
+            static constexpr FieldPattern kFieldPatterns[FieldCount] = {
+                {"type ", ','},
+                {"uniqueId=\"", '"'},
+                {"mCurrentLayerStack=", '\0'},
+                {"mCurrentLayerStackRect=", '\0'},
+                {"mCurrentOrientation=", '\0'},
+                {"density ", ','},
+            };
 
-            // DisplayDeviceInfo
-            auto dumpDisplayInfoIt = std::string_view::npos;
-            while (std::string_view::npos != (dumpDisplayInfoIt = dumpDisplayInfo.find("DisplayDeviceInfo", dumpDisplayInfoIt + 1)))
-            {
-                // 获取 type 字段
-                auto type = SubStringView(dumpDisplayInfo, "type ", ",", dumpDisplayInfoIt);
-                auto uniqueId = SubStringView(dumpDisplayInfo, "uniqueId=\"", "\"", dumpDisplayInfoIt);
-                auto currentLayerStack = SubStringView(dumpDisplayInfo, "mCurrentLayerStack=", "\n", dumpDisplayInfoIt);
-                auto currentLayerStackRect = SubStringView(dumpDisplayInfo, "mCurrentLayerStackRect=", "\n", dumpDisplayInfoIt);
-                auto orientation = SubStringView(dumpDisplayInfo, "mCurrentOrientation=", "\n", dumpDisplayInfoIt);
-
-                if ("-1" == currentLayerStack)
-                {
-                    SURFACE_LOG_ERROR("%s -> Current layer stack is -1, skipping", std::string{uniqueId.begin(), uniqueId.end()}.data());
-                    continue;
+            void ParseLine(std::string_view line) {
+                if (!line.empty() && '\r' == line.back())
+                    line.remove_suffix(1);
+
+                auto recordPos = line.find("DisplayDeviceInfo");
+                if (std::string_view::npos != recordPos) {
+                    EndRecord();
+                    m_inRecord = true;
+                    m_found = 0;
+                    line.remove_prefix(recordPos);
+                }
+                if (!m_inRecord || (1u << FieldCount) - 1 == m_found)
+                    return;
+
+                for (int field = 0; field < FieldCount; field++) {
+                    if (m_found & (1u << field))
+                        continue;
+
+                    auto &pattern = kFieldPatterns[field];
+                    auto startPos = line.find(pattern.start);
+                    if (std::string_view::npos == startPos)
+                        continue;
+
+                    auto value = line.substr(startPos + pattern.start.size());
+                    if ('\0' != pattern.end) {
+                        auto endPos = value.find(pattern.end);
+                        if (std::string_view::npos == endPos)
+                            continue;
+                        value = value.substr(0, endPos);
+                    }
+                    SetField(static_cast<Field>(field), value);
+                    m_found |= 1u << field;
+                }
+            }
+
+            void SetField(Field field, std::string_view value) {
+                if (m_count == m_output.size())
+                    m_output.emplace_back();
+
+                auto &info = m_output[m_count];
+                switch (field) {
+                case FieldType:
+                    info.type.assign(value.data(), value.size());
+                    break;
+                case FieldUniqueId:
+                    info.uniqueId.assign(value.data(), value.size());
+                    break;
+                case FieldLayerStack:
+                    m_layerStackValid = DumpDisplayInfo::ParseNumber(value, m_layerStack);
+                    break;
+                case FieldLayerStackRect:
+                    m_rectValid = DumpDisplayInfo::ParseRect(value, info.currentLayerStackRect);
+                    break;
+                case FieldOrientation:
+                    m_orientationValid = DumpDisplayInfo::ParseNumber(value, info.orientation);
+                    break;
+                case FieldDensity:
+                    if (!DumpDisplayInfo::ParseNumber(value, info.density))
+                        info.density = 0; // Optional, only used for native display rendering
+                    break;
+                default:
+                    break;
                 }
+            }
 
-                if (uniqueId.empty() || currentLayerStack.empty()) {
-                    continue;
+            void EndRecord() {
+                if (!m_inRecord)
+                    return;
+
+                bool valid = (m_found & (1u << FieldUniqueId)) && (m_found & (1u << FieldLayerStack));
+                if (valid) {
+                    auto &info = m_output[m_count];
+                    if (!(m_found & (1u << FieldType)))
+                        info.type.clear();
+                    if (!(m_found & (1u << FieldOrientation)))
+                        info.orientation = 0;
+                    if (!(m_found & (1u << FieldDensity)))
+                        info.density = 0;
+
+                    if (!m_layerStackValid || -1 == m_layerStack) {
+                        SURFACE_LOG_ERROR("%s -> Current layer stack is -1, skipping", info.uniqueId.data());
+                        valid = false;
+                    } else if (!(m_found & (1u << FieldLayerStackRect)) || !m_rectValid || ((m_found & (1u << FieldOrientation)) && !m_orientationValid)) {
+                        SURFACE_LOG_ERROR("%s -> Malformed display info, skipping", info.uniqueId.data());
+                        valid = false;
+                    } else {
+                        info.currentLayerStack = static_cast<uint32_t>(m_layerStack);
+                    }
                 }
+                if (valid)
+                    m_count++;
 
-                result.push_back(DumpDisplayInfo::MakeFromRawDumpInfo(uniqueId, currentLayerStack, currentLayerStackRect, orientation, type));
+                m_inRecord = false;
+                m_found = 0;
+                m_layerStackValid = m_rectValid = m_orientationValid = false;
             }
 
+            std::vector<DumpDisplayInfo> &m_output;
+            std::string m_line;
+            size_t m_count = 0;
+            bool m_inRecord = false;
+            uint32_t m_found = 0;
+            int64_t m_layerStack = -1;
+            bool m_layerStackValid = false;
+            bool m_rectValid = false;
+            bool m_orientationValid = false;
+        };
+
+        inline size_t ParseDumpDisplayInfo(std::string_view dumpDisplayInfo, std::vector<DumpDisplayInfo> &result)
+        {
+            DumpDisplayInfoParser parser(result);
+            parser.Feed(dumpDisplayInfo);
+            return parser.Finish();
+        }
+
+        inline std::vector<DumpDisplayInfo> ParseDumpDisplayInfo(const std::string_view &dumpDisplayInfo)
+        {
+            std::vector<DumpDisplayInfo> result;
+            ParseDumpDisplayInfo(dumpDisplayInfo, result);
             return result;
         }
 
@@ -945,9 +1408,548 @@ namespace android {
             
             return result;
         }
+
+        // Run "dumpsys display" and parse its output as it streams out of the pipe.
+        // Returns false when the command failed or no display could be parsed: 'result' is then unspecified and must not be used.
+        inline bool ReadDumpDisplayInfo(std::vector<DumpDisplayInfo> &result, const char *command = "dumpsys display")
+        {
+            auto pipe = popen(command, "r");
+            if (!pipe)
+            {
+                SURFACE_LOG_ERROR("Failed to run dumpsys command");
+                return false;
+            }
+
+            DumpDisplayInfoParser parser(result);
+            char buffer[4096];
+            size_t size;
+            while (0 < (size = fread(buffer, 1, sizeof(buffer), pipe)))
+                parser.Feed(std::string_view(buffer, size));
+            bool readError = 0 != ferror(pipe);
+            int status = pclose(pipe);
+            size_t count = parser.Finish();
+
+            if (readError || -1 == status || !WIFEXITED(status) || 0 != WEXITSTATUS(status))
+            {
+                SURFACE_LOG_ERROR("\"%s\" failed (status %d, read error: %s), keeping previous display info", command, status, readError ? "true" : "false");
+                return false;
+            }
+            if (0 == count)
+            {
+                SURFACE_LOG_ERROR("\"%s\" reported no usable display, keeping previous display info", command);
+                return false;
+            }
+            return true;
+        }
+
+        // Single producer / single consumer triple buffer. The producer always owns a back slot to write into and the
+        // consumer a front slot to read from; the third slot is swapped atomically, so neither side ever waits for the other.
+        template <typename value_t>
+        class TripleBuffer
+        {
+        public:
+            // Producer side
+            value_t &Back() { return m_slots[m_back]; }
+
+            void Publish() {
+                m_back = m_middle.exchange(m_back | kFreshBit, std::memory_order_acq_rel) & kIndexMask;
+            }
+
+            // Consumer side, returns true when Front() was replaced by a newer value
+            bool Consume() {
+                if (0 == (m_middle.load(std::memory_order_relaxed) & kFreshBit))
+                    return false;
+
+                m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndexMask;
+                return true;
+            }
+
+            const value_t &Front() const { return m_slots[m_front]; }
+
+        private:
+            static constexpr uint8_t kIndexMask = 0x3;
+            static constexpr uint8_t kFreshBit = 0x4;
+
+            std::array<value_t, 3> m_slots{};
+            std::atomic<uint8_t> m_middle{1};
+            uint8_t m_back = 0;
+            uint8_t m_front = 2;
+        };
+
+        // Queries "dumpsys display" on its own thread and publishes the parsed topology whenever it changes,
+        // so the render thread never pays for the fork/exec or for a slow dumpsys on some ROMs.
+        // Queries run when the DisplayChangeDetector reports a change, and every fallback interval otherwise.
+        class DisplayWatcher
+        {
+        public:
+            struct Topology
+            {
+                uint64_t generation = 0;
+                std::vector<DumpDisplayInfo> displays;
+            };
+
+            ~DisplayWatcher() {
+                Stop();
+            }
+
+            // 'detector' nullptr: kernel uevents + SurfaceFlinger physical display IDs when available, plain polling otherwise.
+            // 'fallbackInterval' 0: 10 s with an event driven detector (catches virtual/cast displays), 1 s when polling.
+            void Start(std::unique_ptr<DisplayChangeDetector> detector = nullptr, std::chrono::milliseconds fallbackInterval = std::chrono::milliseconds(0)) {
+                if (m_thread.joinable())
+                    return;
+
+                m_detector = detector ? std::move(detector) : CreateDefaultDetector();
+                if (0 < fallbackInterval.count())
+                    m_fallbackInterval = fallbackInterval;
+                else
+                    m_fallbackInterval = m_detector->IsEventDriven() ? std::chrono::seconds(10) : std::chrono::seconds(1);
+                m_running = true;
+                m_thread = std::thread(&DisplayWatcher::Run, this);
+                SURFACE_LOG_INFO("Display watcher started, event driven: %s, fallback interval: %lld ms", m_detector->IsEventDriven() ? "true" : "false", static_cast<long long>(m_fallbackInterval.count()));
+            }
+
+            void Stop() {
+                if (!m_thread.joinable())
+                    return;
+
+                m_running = false;
+                m_detector->Interrupt();
+                m_thread.join();
+                m_detector.reset();
+                SURFACE_LOG_INFO("Display watcher stopped");
+            }
+
+            bool IsRunning() const {
+                return m_thread.joinable();
+            }
+
+            // Command printing "dumpsys display" output, e.g. "cat <capture>" to replay a topology in tests. Call before Start().
+            void SetQueryCommand(std::string command) {
+                m_queryCommand = std::move(command);
+            }
+
+            // Render thread: never blocks. Returns true when GetTopology() changed since the previous call.
+            bool ConsumeChanges() {
+                return m_topology.Consume();
+            }
+
+            // Render thread: last consumed topology, valid until the next ConsumeChanges()
+            const Topology &GetTopology() const {
+                return m_topology.Front();
+            }
+
+        private:
+            void Run() {
+                std::vector<DumpDisplayInfo> lastDisplays;
+                uint64_t generation = 0;
+
+                while (m_running) {
+                    // Parse straight into the back slot, only publish it when the topology changed.
+                    // A failed query publishes nothing, so readers keep the last good topology.
+                    auto &topology = m_topology.Back();
+                    if (ReadDumpDisplayInfo(topology.displays, m_queryCommand.c_str()) && (0 == generation || topology.displays != lastDisplays)) {
+                        topology.generation = ++generation;
+                        lastDisplays = topology.displays;
+                        m_topology.Publish();
+                        SURFACE_LOG_DEBUG("Display topology changed, generation %llu: %zu displays", static_cast<unsigned long long>(generation), lastDisplays.size());
+                    }
+
+                    // Hotplug events come in bursts and dumpsys lags behind them: let things settle before querying
+                    bool changed = m_detector->WaitForChange(m_fallbackInterval);
+                    for (int settle = 0; changed && 5 > settle && m_detector->WaitForChange(std::chrono::milliseconds(100)); settle++) {
+                    }
+                }
+            }
+
+            static std::unique_ptr<DisplayChangeDetector> CreateDefaultDetector() {
+                auto detector = std::make_unique<UeventDisplayChangeDetector>();
+
+                // Android 10+: SurfaceFlinger's physical display list, one binder call instead of a fork/exec
+                auto getPhysicalDisplayIds = Functionals::GetInstance(Functionals::FeatureDisplay).SurfaceComposerClient__GetPhysicalDisplayIds;
+                if (nullptr != getPhysicalDisplayIds) {
+                    detector->SetProbe(std::chrono::milliseconds(250), [getPhysicalDisplayIds, lastDisplayIds = std::vector<uint64_t>{}, initialized = false]() mutable {
+                        auto displayIds = getPhysicalDisplayIds();
+                        bool changed = !initialized || displayIds.size() != lastDisplayIds.size();
+                        for (size_t i = 0; !changed && i < displayIds.size(); i++)
+                            changed = displayIds[i].value != lastDisplayIds[i];
+                        if (!changed)
+                            return false;
+
+                        lastDisplayIds.resize(displayIds.size());
+                        for (size_t i = 0; i < displayIds.size(); i++)
+                            lastDisplayIds[i] = displayIds[i].value;
+                        bool report = initialized; // First probe only records the current list
+                        initialized = true;
+                        return report;
+                    });
+                }
+
+                SURFACE_LOG_INFO("Display change detection: uevent %s, physical display ids %s", detector->HasUeventSource() ? "yes" : "no", nullptr != getPhysicalDisplayIds ? "yes" : "no");
+                if (!detector->IsEventDriven())
+                    return std::make_unique<PollingDisplayChangeDetector>();
+                return detector;
+            }
+
+            TripleBuffer<Topology> m_topology;
+            std::unique_ptr<DisplayChangeDetector> m_detector;
+            std::thread m_thread;
+            std::chrono::milliseconds m_fallbackInterval{1000};
+            std::atomic<bool> m_running{false};
+            std::string m_queryCommand = "dumpsys display";
+        };
+
+        // Mirror layers of secondary displays. Each Update() diffs the new topology against the mirrors in place
+        // and sends every resulting change (add, remove, rotate, resize) in a single transaction.
+        class MirrorDisplayTracker
+        {
+        public:
+            // Returns false when some mirror could not be created yet and Update() should be retried later
+            bool Update(const std::vector<DumpDisplayInfo> &displays, SurfaceComposerClient &composer, std::unordered_map<ANativeWindow *, SurfaceControl> &sources) {
+                // Built-in display, keep last known values if missing from this topology
+                for (auto &displayInfo : displays) {
+                    if (0 != displayInfo.currentLayerStack)
+                        continue;
+
+                    m_builtinDisplayOrientation = displayInfo.orientation;
+                    if (displayInfo.orientation == 1 || displayInfo.orientation == 3) {
+                        m_builtinDisplayWidth = displayInfo.currentLayerStackRect.bottom;
+                        m_builtinDisplayHeight = displayInfo.currentLayerStackRect.right;
+                    } else {
+                        m_builtinDisplayWidth = displayInfo.currentLayerStackRect.right;
+                        m_builtinDisplayHeight = displayInfo.currentLayerStackRect.bottom;
+                    }
+                }
+
+                bool pendingApply = false;
+                std::vector<MirrorDisplay> removedMirrors;
+
+                // Removed displays
+                for (auto it = m_mirrors.begin(); it != m_mirrors.end();) {
+                    bool present = false;
+                    for (auto &displayInfo : displays)
+                        present |= (displayInfo.currentLayerStack == it->first);
+
+                    if (present) {
+                        ++it;
+                        continue;
+                    }
+
+                    SURFACE_LOG_INFO("Display layerstack removed: %u", it->first);
+                    StrongPointer<void> mirrorRootPtr{it->second.mirrorRoot.data};
+                    GetTransaction().Hide(mirrorRootPtr);
+                    removedMirrors.push_back(it->second);
+                    it = m_mirrors.erase(it);
+                    pendingApply = true;
+                }
+
+                // New and changed displays
+                bool complete = true;
+                for (auto &displayInfo : displays) {
+                    if (0 == displayInfo.currentLayerStack)
+                        continue;
+
+                    auto it = m_mirrors.find(displayInfo.currentLayerStack);
+                    if (it == m_mirrors.end()) {
+                        SURFACE_LOG_INFO("New display layerstack detected: [%s] -> %u", displayInfo.uniqueId.data(), displayInfo.currentLayerStack);
+
+                        MirrorDisplay mirror{};
+                        for (auto &[_, surfaceControl] : sources) {
+                            if (composer.MirrorSurface(surfaceControl, displayInfo.currentLayerStack, GetTransaction(), mirror.mirror, mirror.mirrorRoot))
+                                break; // Only create one mirror per layerStack
+                        }
+                        if (!mirror.mirror.data) {
+                            complete = false;
+                            continue;
+                        }
+
+                        SURFACE_LOG_INFO("Mirror layer created: %p", mirror.mirror.data);
+                        it = m_mirrors.emplace(displayInfo.currentLayerStack, mirror).first;
+                        pendingApply = true;
+                    }
+                    auto &mirror = it->second;
+
+                    int32_t surfaceDisplayWidth = -1, surfaceDisplayHeight = -1;
+                    surfaceDisplayWidth = displayInfo.currentLayerStackRect.bottom < displayInfo.currentLayerStackRect.right ? displayInfo.currentLayerStackRect.bottom : displayInfo.currentLayerStackRect.right;
+                    surfaceDisplayHeight = displayInfo.currentLayerStackRect.bottom > displayInfo.currentLayerStackRect.right ? displayInfo.currentLayerStackRect.bottom : displayInfo.currentLayerStackRect.right;
+
+                    // Decided the first time the built-in display is seen in landscape
+                    if (!mirror.offsetKnown && (m_builtinDisplayOrientation == 1 || m_builtinDisplayOrientation == 3)) {
+                        mirror.offset = (surfaceDisplayHeight != displayInfo.currentLayerStackRect.right);
+                        mirror.offsetKnown = true;
+                    }
+
+                    if (-1 == m_builtinDisplayWidth || -1 == m_builtinDisplayHeight)
+                        continue;
+
+                    auto transform = MirrorTransform::MakeFit(m_builtinDisplayWidth, m_builtinDisplayHeight, m_builtinDisplayOrientation, surfaceDisplayWidth, surfaceDisplayHeight, mirror.offset);
+                    if (mirror.transformApplied && transform == mirror.transform)
+                        continue;
+
+                    StrongPointer<void> mirrorPtr{mirror.mirror.data};
+                    GetTransaction().SetMatrix(mirrorPtr, transform.dsdx, transform.dtdx, transform.dtdy, transform.dsdy);
+                    GetTransaction().SetPosition(mirrorPtr, transform.x, transform.y);
+                    mirror.transform = transform;
+                    mirror.transformApplied = true;
+                    pendingApply = true;
+                    SURFACE_LOG_INFO("Update mirror layer transform: %p [%f %f %f %f] %f %f", mirror.mirror.data, transform.dsdx, transform.dtdx, transform.dtdy, transform.dsdy, transform.x, transform.y);
+                }
+
+                if (pendingApply)
+                    GetTransaction().Apply(false, true);
+
+                // Only after the hide went through
+                for (auto &mirror : removedMirrors)
+                    mirror.Release();
+
+                return complete;
+            }
+
+            bool Remove(uint32_t layerStack) {
+                auto it = m_mirrors.find(layerStack);
+                if (it == m_mirrors.end())
+                    return false;
+
+                StrongPointer<void> mirrorRootPtr{it->second.mirrorRoot.data};
+                GetTransaction().Hide(mirrorRootPtr);
+                GetTransaction().Apply(false, true);
+                it->second.Release();
+                m_mirrors.erase(it);
+                return true;
+            }
+
+            void Clear() {
+                if (m_mirrors.empty())
+                    return;
+
+                for (auto &[_, mirror] : m_mirrors) {
+                    StrongPointer<void> mirrorRootPtr{mirror.mirrorRoot.data};
+                    GetTransaction().Hide(mirrorRootPtr);
+                }
+                GetTransaction().Apply(false, true);
+                for (auto &[_, mirror] : m_mirrors)
+                    mirror.Release();
+                m_mirrors.clear();
+            }
+
+            size_t GetCount() const {
+                return m_mirrors.size();
+            }
+
+            bool Has(uint32_t layerStack) const {
+                return m_mirrors.find(layerStack) != m_mirrors.end();
+            }
+
+        private:
+            struct MirrorDisplay {
+                SurfaceControl mirror;
+                SurfaceControl mirrorRoot;
+                bool offsetKnown = false;
+                bool offset = false;
+                bool transformApplied = false;
+                MirrorTransform transform;
+
+                void Release() {
+                    mirror.Release();
+                    mirrorRoot.Release();
+                }
+            };
+
+            // Created on first use, Transaction is only available on Android 12+
+            SurfaceComposerClientTransaction &GetTransaction() {
+                if (!m_transaction)
+                    m_transaction = std::make_unique<SurfaceComposerClientTransaction>();
+                return *m_transaction;
+            }
+
+            std::unordered_map<uint32_t, MirrorDisplay> m_mirrors;
+            std::unique_ptr<SurfaceComposerClientTransaction> m_transaction;
+            int32_t m_builtinDisplayWidth = -1;
+            int32_t m_builtinDisplayHeight = -1;
+            int32_t m_builtinDisplayOrientation = 0;
+        };
+        // Alternative to MirrorDisplayTracker: a dedicated surface per secondary layer stack, sized to that display,
+        // which the caller renders into at native resolution instead of the primary overlay being scaled onto it.
+        class NativeDisplayTracker
+        {
+        public:
+            struct DisplaySurface {
+                uint32_t layerStack = 0;
+                ANativeWindow *nativeWindow = nullptr;
+                int32_t width = 0;
+                int32_t height = 0;
+                int32_t density = 0; // dpi, 0 if unknown
+                int32_t orientation = 0;
+            };
+
+            using Callback = std::function<void(const DisplaySurface &)>;
+
+            // Both run inside Update()/Remove()/Clear(); 'onDetached' runs before the window is destroyed
+            void SetCallbacks(Callback onAttached, Callback onDetached) {
+                m_onAttached = std::move(onAttached);
+                m_onDetached = std::move(onDetached);
+            }
+
+            // Returns false when some surface could not be created yet and Update() should be retried later
+            bool Update(const std::vector<DumpDisplayInfo> &displays, SurfaceComposerClient &composer, bool skipScreenshot) {
+                bool pendingApply = false;
+                std::vector<NativeDisplay> removedDisplays;
+
+                // Removed displays, and displays whose size or density changed (recreated below)
+                for (auto it = m_displays.begin(); it != m_displays.end();) {
+                    const DumpDisplayInfo *current = nullptr;
+                    for (auto &displayInfo : displays) {
+                        if (displayInfo.currentLayerStack == it->first)
+                            current = &displayInfo;
+                    }
+
+                    if (current && !NeedsRecreate(it->second.surface, *current)) {
+                        ++it;
+                        continue;
+                    }
+
+                    SURFACE_LOG_INFO("Native display surface removed: %u", it->first);
+                    if (m_onDetached)
+                        m_onDetached(it->second.surface);
+                    StrongPointer<void> surfacePtr{it->second.surfaceControl.data};
+                    GetTransaction().Hide(surfacePtr);
+                    removedDisplays.push_back(it->second);
+                    it = m_displays.erase(it);
+                    pendingApply = true;
+                }
+
+                // New displays
+                bool complete = true;
+                std::vector<uint32_t> attachedLayerStacks;
+                for (auto &displayInfo : displays) {
+                    if (0 == displayInfo.currentLayerStack || m_displays.end() != m_displays.find(displayInfo.currentLayerStack))
+                        continue;
+
+                    NativeDisplay display{};
+                    display.surface.layerStack = displayInfo.currentLayerStack;
+                    display.surface.width = displayInfo.currentLayerStackRect.right - displayInfo.currentLayerStackRect.left;
+                    display.surface.height = displayInfo.currentLayerStackRect.bottom - displayInfo.currentLayerStackRect.top;
+                    display.surface.density = displayInfo.density;
+                    display.surface.orientation = displayInfo.orientation;
+                    if (0 >= display.surface.width || 0 >= display.surface.height)
+                        continue;
+
+                    auto surfaceName = "NativeDisplay@" + std::to_string(displayInfo.currentLayerStack);
+                    display.surfaceControl = composer.CreateSurface(surfaceName.c_str(), display.surface.width, display.surface.height, 0, skipScreenshot, &GetTransaction());
+                    display.surface.nativeWindow = reinterpret_cast<ANativeWindow *>(display.surfaceControl.GetSurface());
+                    if (!display.surface.nativeWindow) {
+                        display.surfaceControl.Release();
+                        complete = false;
+                        continue;
+                    }
+
+                    StrongPointer<void> surfacePtr{display.surfaceControl.data};
+                    GetTransaction().SetLayerStack(surfacePtr, displayInfo.currentLayerStack);
+                    GetTransaction().Show(surfacePtr);
+
+                    SURFACE_LOG_INFO("Native display surface created: [%s] -> %u, %d x %d, %d dpi", displayInfo.uniqueId.data(), displayInfo.currentLayerStack, display.surface.width, display.surface.height, display.surface.density);
+                    m_displays.emplace(displayInfo.currentLayerStack, display);
+                    attachedLayerStacks.push_back(displayInfo.currentLayerStack);
+                    pendingApply = true;
+                }
+
+                if (pendingApply)
+                    GetTransaction().Apply(false, true);
+
+                // Only after the hide went through
+                for (auto &display : removedDisplays)
+                    display.Destroy();
+
+                if (m_onAttached) {
+                    for (auto layerStack : attachedLayerStacks)
+                        m_onAttached(m_displays[layerStack].surface);
+                }
+
+                return complete;
+            }
+
+            bool Remove(uint32_t layerStack) {
+                auto it = m_displays.find(layerStack);
+                if (it == m_displays.end())
+                    return false;
+
+                if (m_onDetached)
+                    m_onDetached(it->second.surface);
+                StrongPointer<void> surfacePtr{it->second.surfaceControl.data};
+                GetTransaction().Hide(surfacePtr);
+                GetTransaction().Apply(false, true);
+                it->second.Destroy();
+                m_displays.erase(it);
+                return true;
+            }
+
+            void Clear() {
+                if (m_displays.empty())
+                    return;
+
+                for (auto &[_, display] : m_displays) {
+                    if (m_onDetached)
+                        m_onDetached(display.surface);
+                    StrongPointer<void> surfacePtr{display.surfaceControl.data};
+                    GetTransaction().Hide(surfacePtr);
+                }
+                GetTransaction().Apply(false, true);
+                for (auto &[_, display] : m_displays)
+                    display.Destroy();
+                m_displays.clear();
+            }
+
+            std::vector<DisplaySurface> GetSurfaces() const {
+                std::vector<DisplaySurface> result;
+                result.reserve(m_displays.size());
+                for (auto &[_, display] : m_displays)
+                    result.push_back(display.surface);
+                return result;
+            }
+
+            size_t GetCount() const {
+                return m_displays.size();
+            }
+
+            bool Has(uint32_t layerStack) const {
+                return m_displays.find(layerStack) != m_displays.end();
+            }
+
+        private:
+            struct NativeDisplay {
+                SurfaceControl surfaceControl;
+                DisplaySurface surface;
+
+                void Destroy() {
+                    surfaceControl.DestroySurface(reinterpret_cast<Surface *>(surface.nativeWindow));
+                    surfaceControl.data = nullptr;
+                }
+            };
+
+            static bool NeedsRecreate(const DisplaySurface &surface, const DumpDisplayInfo &displayInfo) {
+                return surface.width != displayInfo.currentLayerStackRect.right - displayInfo.currentLayerStackRect.left ||
+                       surface.height != displayInfo.currentLayerStackRect.bottom - displayInfo.currentLayerStackRect.top ||
+                       surface.density != displayInfo.density;
+            }
+
+            // Created on first use, Transaction is only available on Android 12+
+            SurfaceComposerClientTransaction &GetTransaction() {
+                if (!m_transaction)
+                    m_transaction = std::make_unique<SurfaceComposerClientTransaction>();
+                return *m_transaction;
+            }
+
+            std::unordered_map<uint32_t, NativeDisplay> m_displays;
+            std::unique_ptr<SurfaceComposerClientTransaction> m_transaction;
+            Callback m_onAttached;
+            Callback m_onDetached;
+        };
     }
 
-    class ANativeWindowCreator {
+    // Owns surfaces, mirrors and the display watcher with an explicit lifetime (destruction cleans everything up).
+    // Single owner: every method must be called from the owner thread (the constructing thread by default, see
+    // SetOwnerThread), so the render thread never takes a lock. Other threads hand work over with Post(), which the
+    // owner runs from ProcessMessages() / ProcessMirrorDisplay(). The display watcher runs on its own thread.
+    class SurfaceManager {
     public:
         struct DisplayInfo {
             int32_t orientation;
@@ -955,20 +1957,73 @@ namespace android {
             int32_t height;
         };
 
+        using DisplaySurface = detail::NativeDisplayTracker::DisplaySurface;
+
+        struct LayeredWindow {
+            ANativeWindow *staticWindow = nullptr;  // Bottom layer: content that rarely changes, redrawn on change only
+            ANativeWindow *dynamicWindow = nullptr; // Top layer: redrawn every frame
+        };
+
     public:
-        static detail::SurfaceComposerClient &GetComposerInstance() {
-            static detail::SurfaceComposerClient surfaceComposerClient;
-            return surfaceComposerClient;
+        SurfaceManager() : m_ownerThread(std::this_thread::get_id()) {}
+
+        ~SurfaceManager() {
+            Cleanup();
         }
 
-        static DisplayInfo GetDisplayInfo() {
-            auto &surfaceComposerClient = GetComposerInstance();
+        SurfaceManager(const SurfaceManager &) = delete;
+        SurfaceManager &operator=(const SurfaceManager &) = delete;
+
+        // Hand ownership to another thread, e.g. create on the main thread and render on a dedicated one
+        void SetOwnerThread(std::thread::id ownerThread = std::this_thread::get_id()) {
+            m_ownerThread = ownerThread;
+        }
+
+        bool IsOwnerThread() const {
+            return std::this_thread::get_id() == m_ownerThread;
+        }
+
+        // Thread-safe: queue 'message' to run on the owner thread
+        void Post(std::function<void(SurfaceManager &)> message) {
+            {
+                std::lock_guard<std::mutex> lock(m_messageMutex);
+                m_messages.push_back(std::move(message));
+            }
+            m_hasMessages.store(true, std::memory_order_release);
+        }
+
+        // Owner thread: run queued messages, returns how many ran. Lock-free when the queue is empty.
+        size_t ProcessMessages() {
+            if (!m_hasMessages.load(std::memory_order_acquire))
+                return 0;
+            if (!CheckOwnerThread("ProcessMessages"))
+                return 0;
+
+            {
+                std::lock_guard<std::mutex> lock(m_messageMutex);
+                m_processingMessages.swap(m_messages);
+                m_hasMessages.store(false, std::memory_order_relaxed);
+            }
+            for (auto &message : m_processingMessages)
+                message(*this);
+
+            auto count = m_processingMessages.size();
+            m_processingMessages.clear();
+            return count;
+        }
+
+        detail::SurfaceComposerClient &GetComposerInstance() {
+            return m_composer;
+        }
+
+        DisplayInfo GetDisplayInfo() {
+            auto &surfaceComposerClient = m_composer;
             detail::ui::DisplayState displayInfo{};
 
             if (!surfaceComposerClient.GetDisplayInfo(&displayInfo))
                 return {};
             
-            DisplayInfo local_displayInfo{0};   
+            DisplayInfo local_displayInfo{};
             int32_t local_orientation = static_cast<int32_t>(displayInfo.orientation);  
             int32_t local_abs_x = (displayInfo.layerStackSpaceRect.width > displayInfo.layerStackSpaceRect.height ? displayInfo.layerStackSpaceRect.width : displayInfo.layerStackSpaceRect.height);
             int32_t local_abs_y = (displayInfo.layerStackSpaceRect.width < displayInfo.layerStackSpaceRect.height ? displayInfo.layerStackSpaceRect.width : displayInfo.layerStackSpaceRect.height);          
@@ -983,8 +2038,11 @@ namespace android {
             return local_displayInfo;
         }
 
-        static ANativeWindow *Create(const char *name, int32_t width = -1, int32_t height = -1, bool skipScrenshot_ = false) {
-            auto &surfaceComposerClient = GetComposerInstance();
+        ANativeWindow *Create(const char *name, int32_t width = -1, int32_t height = -1, bool skipScrenshot_ = false) {
+            if (!CheckOwnerThread("Create"))
+                return nullptr;
+
+            auto &surfaceComposerClient = m_composer;
             
             // Auto-retrieve display dimensions
             while (-1 == width || -1 == height) {
@@ -1018,7 +2076,79 @@ namespace android {
             return nativeWindow;
         }
 
-        static void Destroy(ANativeWindow *nativeWindow) {
+        // Multi-layer mode: two stacked surfaces of the same size, composited by SurfaceFlinger/HWC, so a mostly static
+        // overlay only re-renders the dynamic layer each frame. Destroy both windows with Destroy().
+        // Note that mirrored displays only follow one source surface.
+        LayeredWindow CreateLayered(const char *name, int32_t width = -1, int32_t height = -1, bool skipScrenshot_ = false) {
+            if (!CheckOwnerThread("CreateLayered"))
+                return {};
+
+            std::string layerName(name);
+
+            LayeredWindow result;
+            result.staticWindow = Create((layerName + "-static").c_str(), width, height, skipScrenshot_);
+            if (!result.staticWindow)
+                return {};
+
+            result.dynamicWindow = Create((layerName + "-dynamic").c_str(), width, height, skipScrenshot_);
+            if (!result.dynamicWindow) {
+                Destroy(result.staticWindow);
+                return {};
+            }
+
+            // Android 9-11 have no standalone transaction; layers with the same z stack in creation order there
+            if (!SetWindowLayer(result.staticWindow, INT_MAX - 1))
+                SURFACE_LOG_WARN("SetWindowLayer unavailable, relying on creation order for %s", name);
+
+            SURFACE_LOG_INFO("Layered window created: static %p, dynamic %p", result.staticWindow, result.dynamicWindow);
+            return result;
+        }
+
+        // Z order of a window created by Create(), which puts windows at INT_MAX
+        bool SetWindowLayer(ANativeWindow *nativeWindow, int32_t z) {
+            if (!CheckOwnerThread("SetWindowLayer"))
+                return false;
+
+            auto it = m_cachedSurfaceControl.find(nativeWindow);
+            if (it == m_cachedSurfaceControl.end())
+                return false;
+
+            auto systemVersion = detail::Functionals::GetInstance().systemVersion;
+            if (12 <= systemVersion) {
+                auto &transaction = m_composer.GetTransaction();
+                detail::StrongPointer<void> surfacePtr{it->second.data};
+                transaction.SetLayer(surfacePtr, z);
+                (void)transaction.Apply(false, true);
+            } else if (8 >= systemVersion) {
+                auto &surfaceComposerClient = m_composer;
+                surfaceComposerClient.OpenGlobalTransaction();
+                it->second.SetLayer(z);
+                surfaceComposerClient.CloseGlobalTransaction(false);
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        // How SurfaceFlinger rotates/flips the buffers of a window (ANATIVEWINDOW_TRANSFORM_*), without reallocating them.
+        // With the renderer pre-rotating by the inverse, a fixed-size window follows display rotation. Android 8+.
+        bool SetBuffersTransform(ANativeWindow *nativeWindow, int32_t transform) {
+            if (!CheckOwnerThread("SetBuffersTransform"))
+                return false;
+
+            using SetBuffersTransformFunction = int32_t (*)(ANativeWindow *window, int32_t transform);
+            static auto setBuffersTransform = reinterpret_cast<SetBuffersTransformFunction>(dlsym(RTLD_DEFAULT, "ANativeWindow_setBuffersTransform"));
+            if (nullptr == setBuffersTransform) {
+                SURFACE_LOG_WARN("ANativeWindow_setBuffersTransform unavailable");
+                return false;
+            }
+            return 0 == setBuffersTransform(nativeWindow, transform);
+        }
+
+        void Destroy(ANativeWindow *nativeWindow) {
+            if (!CheckOwnerThread("Destroy"))
+                return;
+
             auto it = m_cachedSurfaceControl.find(nativeWindow);
             if (it == m_cachedSurfaceControl.end())
                 return;
@@ -1029,262 +2159,153 @@ namespace android {
             m_cachedSurfaceControl[nativeWindow].DestroySurface(reinterpret_cast<detail::Surface *>(nativeWindow));
             m_cachedSurfaceControl.erase(nativeWindow);
             
-            // If this is the last Surface, clear all mirror surfaces
+            // Mirrors show the primary surfaces: drop them with the last one. Native display surfaces don't depend on them and stay.
             if (m_cachedSurfaceControl.empty()) {
-                SURFACE_LOG_INFO("Last surface destroyed, clearing all mirror surfaces");
-                ClearAllMirrorSurfaces();
+                SURFACE_LOG_INFO("Last surface destroyed, clearing mirror surfaces");
+                m_mirrorDisplayTracker.Clear();
+                m_pendingMirrors = true;
             }
         }
 
         // Handle multi-display mirroring, this is the key feature for solving permission issues
-        static void ProcessMirrorDisplay() {
-            static std::chrono::steady_clock::time_point lastTime{};
-
-            if (13 > detail::Functionals::GetInstance().systemVersion)
+        // Cheap enough to call every frame: dumpsys runs on the display watcher thread and only topology changes are applied here.
+        void ProcessMirrorDisplay() {
+            if (!CheckOwnerThread("ProcessMirrorDisplay"))
                 return;
 
-            if (std::chrono::steady_clock::now() - lastTime < std::chrono::seconds(1))
+            ProcessMessages();
+            if (13 > detail::Functionals::GetInstance().systemVersion || !m_autoMirrorDisplay)
                 return;
 
-            // Run "dumpsys display" and get result
-            auto pipe = popen("dumpsys display", "r");
-            if (!pipe)
-            {
-                SURFACE_LOG_ERROR("Failed to run dumpsys command");
-                return;
-            }
-
-            char buffer[512]{};
-            std::string dumpDisplayResult;
-            while (fgets(buffer, sizeof(buffer), pipe) != nullptr)
-                dumpDisplayResult += buffer;
-            pclose(pipe);
-
-            static std::unordered_map<uint32_t, detail::SurfaceControl> cachedLayerStackMirrorSurfaces;
-            static std::unordered_map<uint32_t, bool> cachedLayerStackIsOffset;
-            static std::unordered_set<uint32_t> cachedLayerStackScales;
-            static std::unordered_set<uint32_t> cachedLayerStackPosition;
+            if (!m_displayWatcher.IsRunning())
+                m_displayWatcher.Start();
 
-            auto dumpDisplayInfos = detail::ParseDumpDisplayInfo(dumpDisplayResult);
-            for (auto &displayInfo : dumpDisplayInfos)
-            {
-                // Update multi display layer scale
-                static int32_t builtinDisplayWidth = -1, builtinDisplayHeight = -1, builtinDisplayOrientation = 0;
-                if (0 == displayInfo.currentLayerStack)
-                {
-                    builtinDisplayOrientation = displayInfo.orientation;
-                    if (displayInfo.orientation == 1 || displayInfo.orientation == 3) {
-                        builtinDisplayWidth = displayInfo.currentLayerStackRect.bottom;
-                        builtinDisplayHeight = displayInfo.currentLayerStackRect.right;
-                    } else {
-                        builtinDisplayWidth = displayInfo.currentLayerStackRect.right;
-                        builtinDisplayHeight = displayInfo.currentLayerStackRect.bottom;
-                    }
-                }
+            // Retry mirrors that could not be created yet (e.g. display seen before the first Create()) once a second
+            if (!m_displayWatcher.ConsumeChanges()) {
+                if (!m_pendingMirrors || (m_cachedSurfaceControl.empty() && !m_nativeDisplayRendering) || std::chrono::steady_clock::now() - m_lastMirrorRetryTime < std::chrono::seconds(1))
+                    return;
+                m_lastMirrorRetryTime = std::chrono::steady_clock::now();
+            }
 
-                // Process mirror display
-                if (0 == displayInfo.currentLayerStack)
-                    continue;
+            auto &displays = m_displayWatcher.GetTopology().displays;
+            if (m_nativeDisplayRendering)
+                m_pendingMirrors = !m_nativeDisplayTracker.Update(displays, m_composer, m_nativeDisplaySkipScreenshot);
+            else
+                m_pendingMirrors = !m_mirrorDisplayTracker.Update(displays, m_composer, m_cachedSurfaceControl);
+        }
 
-                int32_t surfaceDisplayWidth = -1, surfaceDisplayHeight = -1;
-                surfaceDisplayWidth = displayInfo.currentLayerStackRect.bottom < displayInfo.currentLayerStackRect.right ? displayInfo.currentLayerStackRect.bottom : displayInfo.currentLayerStackRect.right;
-                surfaceDisplayHeight = displayInfo.currentLayerStackRect.bottom > displayInfo.currentLayerStackRect.right ? displayInfo.currentLayerStackRect.bottom : displayInfo.currentLayerStackRect.right;
+        // Render secondary displays at their native resolution instead of mirroring the primary overlay onto them.
+        // ProcessMirrorDisplay then creates one surface per secondary layer stack and reports it through the callbacks,
+        // which run on the thread calling ProcessMirrorDisplay; 'onDetached' runs before the window is destroyed.
+        void EnableNativeDisplayRendering(bool enable, std::function<void(const DisplaySurface &)> onAttached = nullptr, std::function<void(const DisplaySurface &)> onDetached = nullptr, bool skipScreenshot = false) {
+            if (!CheckOwnerThread("EnableNativeDisplayRendering"))
+                return;
 
-                bool offset = false;
-                if (cachedLayerStackIsOffset.find(displayInfo.currentLayerStack) == cachedLayerStackIsOffset.end())
-                {
-                    if (builtinDisplayOrientation == 1 || builtinDisplayOrientation == 3)
-                    {
-                        if (surfaceDisplayHeight == displayInfo.currentLayerStackRect.right)
-                        {
-                            cachedLayerStackIsOffset.emplace(displayInfo.currentLayerStack, false);
-                        } else {
-                            cachedLayerStackIsOffset.emplace(displayInfo.currentLayerStack, true);
-                        }
-                        offset = cachedLayerStackIsOffset[displayInfo.currentLayerStack];
-                    }
-                } else {
-                    offset = cachedLayerStackIsOffset[displayInfo.currentLayerStack];
-                }
-                
+            SURFACE_LOG_INFO("EnableNativeDisplayRendering called with enable=%s", enable ? "true" : "false");
 
-                if (cachedLayerStackMirrorSurfaces.find(displayInfo.currentLayerStack) == cachedLayerStackMirrorSurfaces.end())
-                {
-                    SURFACE_LOG_INFO("New display layerstack detected: [%s] -> %u", displayInfo.uniqueId.data(), displayInfo.currentLayerStack);
-
-                    for (auto &[_, surfaceControl] : m_cachedSurfaceControl)
-                    {
-                        auto mirrorLayer = GetComposerInstance().MirrorSurface(surfaceControl, displayInfo.currentLayerStack);
-                        if (mirrorLayer.data) {
-                            SURFACE_LOG_INFO("Mirror layer created: %p", mirrorLayer.data);
-                            cachedLayerStackMirrorSurfaces.emplace(displayInfo.currentLayerStack, std::move(mirrorLayer));
-                            break; // Only create one mirror per layerStack
-                        }
-                    }
-                }
+            if (enable == m_nativeDisplayRendering) {
+                if (enable)
+                    m_nativeDisplayTracker.SetCallbacks(std::move(onAttached), std::move(onDetached));
+                return;
+            }
 
-                // Handle scaling for different display sizes
-                if (-1 != builtinDisplayWidth && -1 != builtinDisplayHeight && cachedLayerStackMirrorSurfaces.find(displayInfo.currentLayerStack) != cachedLayerStackMirrorSurfaces.end())
-                {
-                    static int32_t lastOrientation = -1;
-                    if (cachedLayerStackScales.find(displayInfo.currentLayerStack) == cachedLayerStackScales.end() || 
-                        lastOrientation != builtinDisplayOrientation)
-                    {
-                        auto &mirrorLayer = cachedLayerStackMirrorSurfaces.at(displayInfo.currentLayerStack);
-
-                        float scaleX = static_cast<float>(surfaceDisplayWidth) / builtinDisplayWidth, scaleY = static_cast<float>(surfaceDisplayHeight) / builtinDisplayHeight;
-                        if (scaleY < scaleX)
-                        {
-                            scaleX = scaleY;
-                        } else {
-                            scaleY = scaleX;
-                        }
-                        
-                        GetComposerInstance().ZoomSurface(mirrorLayer, scaleX, scaleY, builtinDisplayOrientation, offset);
-                        cachedLayerStackScales.emplace(displayInfo.currentLayerStack);
-                        lastOrientation = builtinDisplayOrientation;
-                        SURFACE_LOG_INFO("Update mirror layer scale: %p %f %f", mirrorLayer.data, scaleX, scaleY);
-                    }
-                }
-                // Apply transform to all cached surfaces if needed
-                if (cachedLayerStackMirrorSurfaces.find(displayInfo.currentLayerStack) != cachedLayerStackMirrorSurfaces.end()) {
-                    auto &mirrorLayer = cachedLayerStackMirrorSurfaces.at(displayInfo.currentLayerStack);
-                    if (mirrorLayer.data) {
-                        // Apply position transform based on orientation
-                        static int32_t lastOrientation = -1;
-                        if (builtinDisplayOrientation != lastOrientation || cachedLayerStackPosition.find(displayInfo.currentLayerStack) == cachedLayerStackPosition.end()) {
-                            static detail::SurfaceComposerClientTransaction transaction;
-                            detail::StrongPointer<void> surfacePtr{mirrorLayer.data};
-                            float x = 0, y = 0;
-                            float scaleX = static_cast<float>(surfaceDisplayWidth) / builtinDisplayWidth, scaleY = static_cast<float>(surfaceDisplayHeight) / builtinDisplayHeight;
-                            int index = 0;
-                            if (scaleX <= scaleY) {
-                                scaleY = scaleX;
-                                index = 1;
-                            } else if (scaleY <= scaleX) {
-                                scaleX = scaleY;
-                                index = 2;
-                            }
-                            if (14 <= detail::Functionals::GetInstance().systemVersion && offset) {
-                                switch (builtinDisplayOrientation) {
-                                    case 0: // ROT_0
-                                        if (index == 1) {
-                                            y = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
-                                        } else if (index == 2) {
-                                            x = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
-                                        }
-                                        break;
-                                    case 1: // ROT_90
-                                        if (index == 1) {
-                                            x = surfaceDisplayWidth - (surfaceDisplayWidth - builtinDisplayWidth * scaleY) / 2;
-                                        } else if (index == 2) {
-                                            x =  surfaceDisplayWidth;
-                                            y = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
-                                        }
-                                        break;
-                                    case 2: // ROT_180
-                                        if (index == 1) {
-                                            x = surfaceDisplayWidth - (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
-                                            y = surfaceDisplayHeight;
-                                        } else if (index == 2) {
-                                            x = surfaceDisplayWidth;
-                                            y = surfaceDisplayHeight - (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
-                                        }
-                                        break;
-                                    case 3: // ROT_270
-                                        if (index == 1) {
-                                            x = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
-                                            y = surfaceDisplayHeight;
-                                        } else if (index == 2) {
-                                            y = builtinDisplayHeight - (surfaceDisplayHeight - builtinDisplayHeight * scaleX) / 2;
-                                        }
-                                        break;
-                                }
-                            } else {
-                                if (index == 1) {
-                                    if (builtinDisplayOrientation == 1 || builtinDisplayOrientation == 3) {
-                                        x = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
-                                    } else {
-                                        y = (surfaceDisplayHeight - builtinDisplayHeight * scaleY) / 2;
-                                    }
-                                } else if (index == 2) {
-                                    if (builtinDisplayOrientation == 1 || builtinDisplayOrientation == 3) {
-                                        y = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
-                                    } else {
-                                        x = (surfaceDisplayWidth - builtinDisplayWidth * scaleX) / 2;
-                                    }
-                                }
-                            }
-                            transaction.SetPosition(surfacePtr, x, y);
-                            transaction.Apply(false, true);
-                            lastOrientation = builtinDisplayOrientation;
-                            cachedLayerStackPosition.emplace(displayInfo.currentLayerStack);
-                            SURFACE_LOG_INFO("Update mirror layer position: %d %f %p %f %f", index, scaleX, mirrorLayer.data, x, y);
-                        }
-                    }
-                }
+            if (enable) {
+                m_mirrorDisplayTracker.Clear();
+                m_nativeDisplayTracker.SetCallbacks(std::move(onAttached), std::move(onDetached));
+            } else {
+                m_nativeDisplayTracker.Clear();
+                m_nativeDisplayTracker.SetCallbacks(nullptr, nullptr);
             }
+            m_nativeDisplayRendering = enable;
+            m_nativeDisplaySkipScreenshot = skipScreenshot;
+            m_pendingMirrors = true; // Apply the current topology in the new mode on the next ProcessMirrorDisplay
+        }
+
+        bool IsNativeDisplayRendering() {
+            return m_nativeDisplayRendering;
+        }
 
-            lastTime = std::chrono::steady_clock::now();
+        // Current native display surfaces (native display rendering only)
+        std::vector<DisplaySurface> GetNativeDisplaySurfaces() {
+            return m_nativeDisplayTracker.GetSurfaces();
         }
 
-        // Enable automatic mirror display handling (recommended to call periodically in main loop)
-        static void EnableAutoMirrorDisplay(bool enable = true) {
-            static bool autoMirrorEnabled = false;
+        // Enable automatic mirror display handling (then call ProcessMirrorDisplay in main loop). Enabled by default; once disabled,
+        // ProcessMirrorDisplay only runs posted messages and leaves the display watcher stopped until it is enabled again.
+        // 'detector' overrides the default display change detection, e.g. detail::FakeDisplayChangeDetector in tests.
+        void EnableAutoMirrorDisplay(bool enable = true, std::unique_ptr<detail::DisplayChangeDetector> detector = nullptr) {
+            if (!CheckOwnerThread("EnableAutoMirrorDisplay"))
+                return;
+
             SURFACE_LOG_INFO("EnableAutoMirrorDisplay called with enable=%s", enable ? "true" : "false");
-            autoMirrorEnabled = enable;
             
+            m_autoMirrorDisplay = enable;
             if (enable) {
-                SURFACE_LOG_INFO("Auto mirror display enabled, calling ProcessMirrorDisplay immediately");
-                ProcessMirrorDisplay(); // Execute immediately once
+                SURFACE_LOG_INFO("Auto mirror display enabled, starting display watcher");
+                if (detector) {
+                    m_displayWatcher.Stop();
+                    m_displayWatcher.Start(std::move(detector));
+                }
+                ProcessMirrorDisplay(); // Starts the watcher, first topology is applied on a later call
             } else {
+                m_displayWatcher.Stop();
                 SURFACE_LOG_INFO("Auto mirror display disabled");
             }
         }
 
         // Get current cached Surface count
-        static size_t GetCachedSurfaceCount() {
+        size_t GetCachedSurfaceCount() {
             return m_cachedSurfaceControl.size();
         }
 
         // Clear all mirror surfaces
-        static void ClearAllMirrorSurfaces() {
+        void ClearAllMirrorSurfaces() {
+            if (!CheckOwnerThread("ClearAllMirrorSurfaces"))
+                return;
+
             SURFACE_LOG_INFO("Clearing all mirror surfaces...");
             
-            // Clear cached mirrors from ProcessMirrorDisplay
-            ClearLayerStackMirrorSurfaces();
+            // Clear cached mirrors from ProcessMirrorDisplay, they get recreated once a surface exists again
+            m_mirrorDisplayTracker.Clear();
+            m_nativeDisplayTracker.Clear();
+            m_pendingMirrors = true;
             
             SURFACE_LOG_INFO("All mirror surfaces cleared");
         }
 
         // Clear mirror surface for specific LayerStack
-        static void ClearMirrorSurfaceForLayerStack(const std::string& layerStack) {
+        void ClearMirrorSurfaceForLayerStack(const std::string& layerStack) {
+            if (!CheckOwnerThread("ClearMirrorSurfaceForLayerStack"))
+                return;
+
             SURFACE_LOG_INFO("Clearing mirror surface for layerStack: %s", layerStack.c_str());
             
-            auto& cachedMirrors = GetLayerStackMirrorSurfaces();
-            auto it = cachedMirrors.find(layerStack);
-            if (it != cachedMirrors.end()) {
-                // SurfaceControl destructor will automatically handle cleanup
-                cachedMirrors.erase(it);
+            uint32_t layerStackId = 0;
+            if (!detail::DumpDisplayInfo::ParseNumber(layerStack, layerStackId))
+                return;
+
+            if (m_mirrorDisplayTracker.Remove(layerStackId) || m_nativeDisplayTracker.Remove(layerStackId)) {
                 SURFACE_LOG_INFO("Mirror surface for layerStack %s cleared", layerStack.c_str());
             }
         }
 
         // Get current mirror surface count
-        static size_t GetMirrorSurfaceCount() {
-            return GetLayerStackMirrorSurfaces().size();
+        size_t GetMirrorSurfaceCount() {
+            return m_mirrorDisplayTracker.GetCount() + m_nativeDisplayTracker.GetCount();
         }
 
         // Check if mirror exists for specific LayerStack
-        static bool HasMirrorForLayerStack(const std::string& layerStack) {
-            auto& cachedMirrors = GetLayerStackMirrorSurfaces();
-            return cachedMirrors.find(layerStack) != cachedMirrors.end();
+        bool HasMirrorForLayerStack(const std::string& layerStack) {
+            uint32_t layerStackId = 0;
+            return detail::DumpDisplayInfo::ParseNumber(layerStack, layerStackId) && (m_mirrorDisplayTracker.Has(layerStackId) || m_nativeDisplayTracker.Has(layerStackId));
         }
 
-        // Complete cleanup when application exits
-        static void Cleanup() {
+        // Complete cleanup when application exits, also run by the destructor. Owner thread, or once no other thread uses the manager.
+        void Cleanup() {
             SURFACE_LOG_INFO("Performing complete cleanup...");
             
+            m_displayWatcher.Stop();
+
             // Clean up all main surfaces
             for (auto& [nativeWindow, surfaceControl] : m_cachedSurfaceControl) {
                 SURFACE_LOG_DEBUG("Cleaning up surface: %p", nativeWindow);
@@ -1293,30 +2314,127 @@ namespace android {
             m_cachedSurfaceControl.clear();
             
             // Clear all mirror surfaces
-            ClearAllMirrorSurfaces();
+            m_mirrorDisplayTracker.Clear();
+            m_nativeDisplayTracker.Clear();
+            m_pendingMirrors = true;
             
             SURFACE_LOG_INFO("Complete cleanup finished");
         }
 
     private:
-        inline static std::unordered_map<ANativeWindow *, detail::SurfaceControl> m_cachedSurfaceControl;
+        bool CheckOwnerThread(const char *function) const {
+            if (IsOwnerThread())
+                return true;
+
+            SURFACE_LOG_ERROR("SurfaceManager::%s called off the owner thread, use Post()", function);
+            return false;
+        }
+
+        std::thread::id m_ownerThread;
+        detail::SurfaceComposerClient m_composer;
+        std::unordered_map<ANativeWindow *, detail::SurfaceControl> m_cachedSurfaceControl;
+        detail::DisplayWatcher m_displayWatcher;
+        detail::MirrorDisplayTracker m_mirrorDisplayTracker;
+        detail::NativeDisplayTracker m_nativeDisplayTracker;
+        std::chrono::steady_clock::time_point m_lastMirrorRetryTime{};
+        bool m_pendingMirrors = false;
+        bool m_autoMirrorDisplay = true;
+        bool m_nativeDisplayRendering = false;
+        bool m_nativeDisplaySkipScreenshot = false;
+
+        std::mutex m_messageMutex;
+        std::vector<std::function<void(SurfaceManager &)>> m_messages;
+        std::vector<std::function<void(SurfaceManager &)>> m_processingMessages;
+        std::atomic<bool> m_hasMessages{false};
+    };
+
+    // Static facade over a process-wide SurfaceManager, kept for existing callers.
+    // Same single owner rule: the first thread using it owns it.
+    class ANativeWindowCreator {
+    public:
+        using DisplayInfo = SurfaceManager::DisplayInfo;
+        using DisplaySurface = SurfaceManager::DisplaySurface;
+        using LayeredWindow = SurfaceManager::LayeredWindow;
+
+        static SurfaceManager &GetDefault() {
+            static SurfaceManager surfaceManager;
+            return surfaceManager;
+        }
+
+        static detail::SurfaceComposerClient &GetComposerInstance() {
+            return GetDefault().GetComposerInstance();
+        }
+
+        static DisplayInfo GetDisplayInfo() {
+            return GetDefault().GetDisplayInfo();
+        }
+
+        static ANativeWindow *Create(const char *name, int32_t width = -1, int32_t height = -1, bool skipScrenshot_ = false) {
+            return GetDefault().Create(name, width, height, skipScrenshot_);
+        }
+
+        static LayeredWindow CreateLayered(const char *name, int32_t width = -1, int32_t height = -1, bool skipScrenshot_ = false) {
+            return GetDefault().CreateLayered(name, width, height, skipScrenshot_);
+        }
+
+        static bool SetWindowLayer(ANativeWindow *nativeWindow, int32_t z) {
+            return GetDefault().SetWindowLayer(nativeWindow, z);
+        }
+
+        static bool SetBuffersTransform(ANativeWindow *nativeWindow, int32_t transform) {
+            return GetDefault().SetBuffersTransform(nativeWindow, transform);
+        }
+
+        static void Destroy(ANativeWindow *nativeWindow) {
+            GetDefault().Destroy(nativeWindow);
+        }
+
+        static void ProcessMirrorDisplay() {
+            GetDefault().ProcessMirrorDisplay();
+        }
+
+        static void EnableNativeDisplayRendering(bool enable, std::function<void(const DisplaySurface &)> onAttached = nullptr, std::function<void(const DisplaySurface &)> onDetached = nullptr, bool skipScreenshot = false) {
+            GetDefault().EnableNativeDisplayRendering(enable, std::move(onAttached), std::move(onDetached), skipScreenshot);
+        }
 
-        // Get reference to LayerStack mirror surface cache
-        static std::unordered_map<std::string, detail::SurfaceControl>& GetLayerStackMirrorSurfaces() {
-            static std::unordered_map<std::string, detail::SurfaceControl> cachedLayerStackMirrorSurfaces;
-            return cachedLayerStackMirrorSurfaces;
+        static bool IsNativeDisplayRendering() {
+            return GetDefault().IsNativeDisplayRendering();
         }
 
-        // Clear LayerStack mirror surface cache
-        static void ClearLayerStackMirrorSurfaces() {
-            auto& cachedMirrors = GetLayerStackMirrorSurfaces();
-            size_t count = cachedMirrors.size();
-            cachedMirrors.clear();
-            SURFACE_LOG_INFO("Cleared %zu layerStack mirror surfaces", count);
+        static std::vector<DisplaySurface> GetNativeDisplaySurfaces() {
+            return GetDefault().GetNativeDisplaySurfaces();
+        }
+
+        static void EnableAutoMirrorDisplay(bool enable = true, std::unique_ptr<detail::DisplayChangeDetector> detector = nullptr) {
+            GetDefault().EnableAutoMirrorDisplay(enable, std::move(detector));
+        }
+
+        static size_t GetCachedSurfaceCount() {
+            return GetDefault().GetCachedSurfaceCount();
+        }
+
+        static void ClearAllMirrorSurfaces() {
+            GetDefault().ClearAllMirrorSurfaces();
+        }
+
+        static void ClearMirrorSurfaceForLayerStack(const std::string& layerStack) {
+            GetDefault().ClearMirrorSurfaceForLayerStack(layerStack);
+        }
+
+        static size_t GetMirrorSurfaceCount() {
+            return GetDefault().GetMirrorSurfaceCount();
+        }
+
+        static bool HasMirrorForLayerStack(const std::string& layerStack) {
+            return GetDefault().HasMirrorForLayerStack(layerStack);
+        }
+
+        static void Cleanup() {
+            GetDefault().Cleanup();
         }
     };
 }
 
-#undef ResolveMethod
+#undef FunctionalsSymbol
 
 #endif // !A_NATIVE_WINDOW_CREATOR_H
@@ -0,0 +1,271 @@
+#ifndef DISPLAY_CHANGE_DETECTOR_H
+#define DISPLAY_CHANGE_DETECTOR_H
+
+// Display change detection for ANativeWindowCreator's display watcher.
+// Only depends on Linux headers, so detectors can be exercised on a plain Linux host.
+
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+namespace android {
+    namespace detail {
+        // Tells the display watcher when it is worth running a full (and expensive) display query
+        class DisplayChangeDetector
+        {
+        public:
+            virtual ~DisplayChangeDetector() = default;
+
+            // Blocks for at most 'timeout'. Returns true when the display topology may have changed,
+            // false on timeout or after Interrupt().
+            virtual bool WaitForChange(std::chrono::milliseconds timeout) = 0;
+
+            // Thread-safe: makes a pending or the next WaitForChange() return false immediately
+            virtual void Interrupt() = 0;
+
+            // False when no real event source is available and the watcher must poll
+            virtual bool IsEventDriven() const = 0;
+        };
+
+        // Pure timer: never reports a change, the watcher falls back to periodic queries
+        class PollingDisplayChangeDetector : public DisplayChangeDetector
+        {
+        public:
+            bool WaitForChange(std::chrono::milliseconds timeout) override {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeup.wait_for(lock, timeout, [this] { return m_interrupted; });
+                m_interrupted = false;
+                return false;
+            }
+
+            void Interrupt() override {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_interrupted = true;
+                }
+                m_wakeup.notify_all();
+            }
+
+            bool IsEventDriven() const override {
+                return false;
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_wakeup;
+            bool m_interrupted = false;
+        };
+
+        // Manually triggered detector, for driving the display watcher from tests
+        class FakeDisplayChangeDetector : public DisplayChangeDetector
+        {
+        public:
+            void Trigger() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_pendingChanges++;
+                }
+                m_wakeup.notify_all();
+            }
+
+            bool WaitForChange(std::chrono::milliseconds timeout) override {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_waitCount++;
+                m_wakeup.wait_for(lock, timeout, [this] { return m_interrupted || 0 < m_pendingChanges; });
+                if (m_interrupted) {
+                    m_interrupted = false;
+                    return false;
+                }
+                if (0 == m_pendingChanges)
+                    return false;
+
+                m_pendingChanges--;
+                return true;
+            }
+
+            void Interrupt() override {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_interrupted = true;
+                }
+                m_wakeup.notify_all();
+            }
+
+            bool IsEventDriven() const override {
+                return true;
+            }
+
+            int GetWaitCount() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_waitCount;
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_wakeup;
+            int m_pendingChanges = 0;
+            int m_waitCount = 0;
+            bool m_interrupted = false;
+        };
+
+        // Kernel uevents (NETLINK_KOBJECT_UEVENT) from display related subsystems (DRM hotplug, HDMI/DP switches),
+        // plus an optional cheap probe run every 'probeInterval' (e.g. comparing SurfaceFlinger's physical display IDs).
+        class UeventDisplayChangeDetector : public DisplayChangeDetector
+        {
+        public:
+            UeventDisplayChangeDetector() {
+                m_wakeupFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+                m_socketFd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+                if (0 > m_socketFd)
+                    return;
+
+                sockaddr_nl address{};
+                address.nl_family = AF_NETLINK;
+                address.nl_groups = 1; // Kernel broadcast group
+                if (0 != bind(m_socketFd, reinterpret_cast<sockaddr *>(&address), sizeof(address))) {
+                    close(m_socketFd);
+                    m_socketFd = -1;
+                }
+            }
+
+            ~UeventDisplayChangeDetector() override {
+                if (0 <= m_socketFd)
+                    close(m_socketFd);
+                if (0 <= m_wakeupFd)
+                    close(m_wakeupFd);
+            }
+
+            UeventDisplayChangeDetector(const UeventDisplayChangeDetector &) = delete;
+            UeventDisplayChangeDetector &operator=(const UeventDisplayChangeDetector &) = delete;
+
+            // 'probe' returns true when it noticed a change. Called from the watcher thread only.
+            void SetProbe(std::chrono::milliseconds probeInterval, std::function<bool()> probe) {
+                m_probeInterval = probeInterval;
+                m_probe = std::move(probe);
+            }
+
+            bool HasUeventSource() const {
+                return 0 <= m_socketFd;
+            }
+
+            // False when eventfd() failed and Interrupt() goes through a condition variable
+            bool HasWakeupFd() const {
+                return 0 <= m_wakeupFd;
+            }
+
+            bool WaitForChange(std::chrono::milliseconds timeout) override {
+                auto deadline = std::chrono::steady_clock::now() + timeout;
+                while (true) {
+                    auto now = std::chrono::steady_clock::now();
+                    if (m_probe && now >= m_nextProbeTime) {
+                        m_nextProbeTime = now + m_probeInterval;
+                        if (m_probe())
+                            return true;
+                    }
+                    if (now >= deadline)
+                        return false;
+
+                    auto wakeupTime = (m_probe && m_nextProbeTime < deadline) ? m_nextProbeTime : deadline;
+                    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(wakeupTime - now) + std::chrono::milliseconds(1);
+
+                    if (0 > m_wakeupFd) {
+                        // No eventfd to poll alongside the socket: sleep on the condition variable instead, in short
+                        // slices when the socket has to be checked too, so Interrupt() never waits for the timeout.
+                        if (0 <= m_socketFd)
+                            wait = std::min(wait, std::chrono::milliseconds(50));
+                        {
+                            std::unique_lock<std::mutex> lock(m_mutex);
+                            if (m_wakeup.wait_for(lock, wait, [this] { return m_interrupted; })) {
+                                m_interrupted = false;
+                                return false;
+                            }
+                        }
+                        if (0 <= m_socketFd && DrainUevents())
+                            return true;
+                        continue;
+                    }
+
+                    pollfd fds[2] = {{m_wakeupFd, POLLIN, 0}, {m_socketFd, POLLIN, 0}};
+                    int result = poll(fds, 0 <= m_socketFd ? 2 : 1, static_cast<int>(wait.count()));
+                    if (0 > result)
+                        continue; // EINTR
+
+                    if (fds[0].revents & POLLIN) {
+                        uint64_t value;
+                        (void)read(m_wakeupFd, &value, sizeof(value));
+                        return false;
+                    }
+
+                    if (0 <= m_socketFd && (fds[1].revents & POLLIN) && DrainUevents())
+                        return true;
+                }
+            }
+
+            void Interrupt() override {
+                if (0 <= m_wakeupFd) {
+                    uint64_t value = 1;
+                    (void)write(m_wakeupFd, &value, sizeof(value));
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_interrupted = true;
+                }
+                m_wakeup.notify_all();
+            }
+
+            bool IsEventDriven() const override {
+                return 0 <= m_socketFd || static_cast<bool>(m_probe);
+            }
+
+            // A uevent message is "action@devpath" followed by NUL separated KEY=VALUE pairs
+            static bool IsDisplayUevent(std::string_view message) {
+                bool display = false;
+                while (!message.empty()) {
+                    auto entry = message.substr(0, message.find('\0'));
+                    if (entry == "SUBSYSTEM=drm" || entry == "SUBSYSTEM=graphics" ||
+                        (0 == entry.rfind("SWITCH_NAME=", 0) && (std::string_view::npos != entry.find("hdmi") || std::string_view::npos != entry.find("dp"))))
+                        display = true;
+                    message.remove_prefix(entry.size() < message.size() ? entry.size() + 1 : message.size());
+                }
+                return display;
+            }
+
+        private:
+            // Read every queued message, true if one of them is display related
+            bool DrainUevents() {
+                bool changed = false;
+                char buffer[8192];
+                ssize_t size;
+                while (0 < (size = recv(m_socketFd, buffer, sizeof(buffer), 0)))
+                    changed |= IsDisplayUevent(std::string_view(buffer, static_cast<size_t>(size)));
+                return changed;
+            }
+
+            int m_socketFd = -1;
+            int m_wakeupFd = -1;
+            std::chrono::milliseconds m_probeInterval{250};
+            std::chrono::steady_clock::time_point m_nextProbeTime{};
+            std::function<bool()> m_probe;
+
+            // Interrupt() fallback when eventfd() failed
+            std::mutex m_mutex;
+            std::condition_variable m_wakeup;
+            bool m_interrupted = false;
+        };
+    }
+}
+
+#endif // !DISPLAY_CHANGE_DETECTOR_H
@@ -0,0 +1,243 @@
+#ifndef EVDEV_TOUCH_DECODER_H
+#define EVDEV_TOUCH_DECODER_H
+
+// Multi-touch protocol B decoder for raw evdev touchscreens (imgui_impl_android's evdev thread).
+// Only depends on Linux headers, so captures can be replayed through it on a plain Linux host.
+
+#include <linux/input.h>
+#include <sys/ioctl.h>
+
+#include <cstdint>
+#include <functional>
+
+namespace android {
+    namespace detail {
+        // One pointer transition or position, in the order an AMotionEvent stream would carry them
+        struct EvdevTouchEvent
+        {
+            enum class Kind
+            {
+                Down,           // First contact
+                PointerDown,    // Further contact
+                Move,
+                PointerUp,      // Contact lifted, others remain
+                Up              // Last contact lifted
+            };
+
+            Kind Action;
+            int Slot;
+            bool Stylus;            // ABS_MT_TOOL_TYPE == MT_TOOL_PEN
+            bool Continuation;      // Further contact of the same Move
+            int32_t RawX, RawY;     // Panel coordinates. Lifted contacts keep their last reported position.
+            int64_t TimeNs;
+        };
+
+        // Slot state machine of the kernel's multi-touch protocol B. Events are accumulated per slot and every SYN_REPORT turns the
+        // differences with the last report into: lifted contacts, then one Move with every remaining contact if any moved, then new contacts.
+        // After SYN_DROPPED, events are ignored until the next SYN_REPORT, where the slots are reloaded from the kernel state and reported.
+        class EvdevTouchDecoder
+        {
+        public:
+            static constexpr int MaxSlots = 16;
+
+            // Fills 'values' (one per slot) with the current kernel value of an ABS_MT_* 'code', like EVIOCGMTSLOTS.
+            // ABS_MT_SLOT asks for the current slot, in values[0]. Returns false when the state can't be read.
+            using SlotQuery = std::function<bool(uint32_t code, int32_t *values, int count)>;
+
+            explicit EvdevTouchDecoder(int slotCount = MaxSlots, SlotQuery query = nullptr) {
+                m_slotCount = 0 < slotCount && slotCount < MaxSlots ? slotCount : MaxSlots;
+                m_query = std::move(query);
+            }
+
+            // Kernel state of an evdev device, for SYN_DROPPED recovery
+            static SlotQuery DeviceSlotQuery(int fd) {
+                return [fd](uint32_t code, int32_t *values, int count) {
+                    if (ABS_MT_SLOT == code) {
+                        input_absinfo slotInfo{};
+                        if (0 > ioctl(fd, EVIOCGABS(ABS_MT_SLOT), &slotInfo))
+                            return false;
+                        values[0] = slotInfo.value;
+                        return true;
+                    }
+                    struct { uint32_t Code; int32_t Values[MaxSlots]; } request{};
+                    request.Code = code;
+                    if (0 > ioctl(fd, EVIOCGMTSLOTS(sizeof(request)), &request))
+                        return false;
+                    for (int i = 0; i < count && i < MaxSlots; i++)
+                        values[i] = request.Values[i];
+                    return true;
+                };
+            }
+
+            int GetSlotCount() const {
+                return m_slotCount;
+            }
+
+            bool IsSyncDropped() const {
+                return m_syncDropped;
+            }
+
+            // Reload every slot from the kernel state (after open or SYN_DROPPED). Differences come out at the next Report().
+            bool Resync() {
+                if (!m_query)
+                    return false;
+                static const uint32_t codes[] = {ABS_MT_TRACKING_ID, ABS_MT_POSITION_X, ABS_MT_POSITION_Y};
+                int32_t values[MaxSlots];
+                for (uint32_t code : codes) {
+                    if (!m_query(code, values, m_slotCount))
+                        return false;
+                    for (int i = 0; i < m_slotCount; i++) {
+                        Slot &slot = m_slots[i];
+                        if (ABS_MT_TRACKING_ID == code) {
+                            if (0 <= values[i] && slot.TrackingId != values[i])
+                                slot.Stylus = false;
+                            slot.TrackingId = values[i];
+                        } else if (ABS_MT_POSITION_X == code && slot.RawX != values[i]) {
+                            slot.RawX = values[i];
+                            slot.Moved = true;
+                        } else if (ABS_MT_POSITION_Y == code && slot.RawY != values[i]) {
+                            slot.RawY = values[i];
+                            slot.Moved = true;
+                        }
+                    }
+                }
+                if (m_query(ABS_MT_SLOT, values, 1))
+                    m_slot = values[0];
+                return true;
+            }
+
+            // The device is gone (unplugged, read error): lift every contact still down, then forget pending partial frames.
+            template <typename Sink>
+            void ReleaseAll(int64_t timeNs, Sink &&sink) {
+                for (int i = 0; i < m_slotCount; i++)
+                    m_slots[i].TrackingId = -1;
+                m_syncDropped = false;
+                Report(timeNs, sink);
+            }
+
+            // Feed one event. 'timeNs' is the event time on the caller's clock; 'sink' gets every EvdevTouchEvent of a SYN_REPORT.
+            template <typename Sink>
+            void Process(const input_event &event, int64_t timeNs, Sink &&sink) {
+                if (EV_SYN == event.type) {
+                    if (SYN_DROPPED == event.code) {
+                        m_syncDropped = true;
+                    } else if (SYN_REPORT == event.code) {
+                        if (m_syncDropped) {
+                            m_syncDropped = false;
+                            Resync();
+                        }
+                        Report(timeNs, sink);
+                    }
+                    return;
+                }
+                if (EV_ABS != event.type || m_syncDropped)
+                    return;
+
+                if (ABS_MT_SLOT == event.code) {
+                    m_slot = event.value;
+                    return;
+                }
+                if (0 > m_slot || m_slot >= m_slotCount)
+                    return;
+                Slot &slot = m_slots[m_slot];
+                switch (event.code) {
+                    case ABS_MT_TRACKING_ID:
+                        if (0 <= event.value)
+                            slot.Stylus = false; // New contact, until ABS_MT_TOOL_TYPE says otherwise. A lift keeps its tool.
+                        slot.TrackingId = event.value;
+                        break;
+                    case ABS_MT_POSITION_X:
+                        slot.RawX = event.value;
+                        slot.Moved = true;
+                        break;
+                    case ABS_MT_POSITION_Y:
+                        slot.RawY = event.value;
+                        slot.Moved = true;
+                        break;
+                    case ABS_MT_TOOL_TYPE:
+                        slot.Stylus = MT_TOOL_PEN == event.value;
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            // Emit the differences with the last report (also used once after open, for contacts already down)
+            template <typename Sink>
+            void Report(int64_t timeNs, Sink &&sink) {
+                EvdevTouchEvent out{};
+                out.TimeNs = timeNs;
+                int downCount = 0;
+                for (int i = 0; i < m_slotCount; i++)
+                    if (0 <= m_slots[i].ReportedId)
+                        downCount++;
+
+                for (int i = 0; i < m_slotCount; i++) {
+                    Slot &slot = m_slots[i];
+                    if (0 > slot.ReportedId || slot.ReportedId == slot.TrackingId)
+                        continue;
+                    out.Action = 0 == --downCount ? EvdevTouchEvent::Kind::Up : EvdevTouchEvent::Kind::PointerUp;
+                    Fill(&out, i, slot.Stylus, slot.ReportedX, slot.ReportedY);
+                    sink(out);
+                    slot.ReportedId = -1;
+                }
+
+                bool moved = false;
+                for (int i = 0; i < m_slotCount; i++)
+                    moved |= 0 <= m_slots[i].ReportedId && m_slots[i].Moved;
+                out.Action = EvdevTouchEvent::Kind::Move;
+                for (int i = 0; moved && i < m_slotCount; i++) {
+                    Slot &slot = m_slots[i];
+                    if (0 > slot.ReportedId)
+                        continue;
+                    Fill(&out, i, slot.Stylus, slot.RawX, slot.RawY);
+                    sink(out);
+                    out.Continuation = true;
+                    slot.ReportedX = slot.RawX;
+                    slot.ReportedY = slot.RawY;
+                    slot.Moved = false;
+                }
+
+                out.Continuation = false;
+                for (int i = 0; i < m_slotCount; i++) {
+                    Slot &slot = m_slots[i];
+                    if (0 > slot.TrackingId || slot.ReportedId == slot.TrackingId)
+                        continue;
+                    out.Action = 0 == downCount++ ? EvdevTouchEvent::Kind::Down : EvdevTouchEvent::Kind::PointerDown;
+                    Fill(&out, i, slot.Stylus, slot.RawX, slot.RawY);
+                    sink(out);
+                    slot.ReportedId = slot.TrackingId;
+                    slot.ReportedX = slot.RawX;
+                    slot.ReportedY = slot.RawY;
+                    slot.Moved = false;
+                }
+            }
+
+        private:
+            struct Slot
+            {
+                int32_t TrackingId = -1;    // -1: no contact
+                int32_t ReportedId = -1;    // TrackingId as of the last SYN_REPORT
+                int32_t RawX = 0, RawY = 0;
+                int32_t ReportedX = 0, ReportedY = 0;
+                bool Stylus = false;
+                bool Moved = false;
+            };
+
+            static void Fill(EvdevTouchEvent *out, int slot, bool stylus, int32_t x, int32_t y) {
+                out->Slot = slot;
+                out->Stylus = stylus;
+                out->RawX = x;
+                out->RawY = y;
+            }
+
+            Slot m_slots[MaxSlots];
+            int m_slotCount = MaxSlots;
+            int m_slot = 0;
+            bool m_syncDropped = false;
+            SlotQuery m_query;
+        };
+    }
+}
+
+#endif // !EVDEV_TOUCH_DECODER_H
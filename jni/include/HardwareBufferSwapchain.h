@@ -0,0 +1,423 @@
+#ifndef HARDWARE_BUFFER_SWAPCHAIN_H
+#define HARDWARE_BUFFER_SWAPCHAIN_H
+
+// Renders into a small pool of AHardwareBuffers (EGLImage FBO attachments) and presents them to a child
+// ASurfaceControl with ASurfaceTransaction_setBuffer, instead of going through an EGL window surface / BufferQueue.
+// The buffer count (2: lowest latency, 3: throughput under load) is explicit and dequeue never blocks inside the driver.
+// NDK entry points are resolved at runtime (AHardwareBuffer: Android 8, ASurfaceControl: Android 10).
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES3/gl3.h>
+#include <android/hardware_buffer.h>
+#include <android/native_window.h>
+#include <android/rect.h>
+#include <dlfcn.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "ANativeWindowCreator.h"
+
+struct ASurfaceControl;
+struct ASurfaceTransaction;
+struct ASurfaceTransactionStats;
+
+namespace android {
+    namespace detail {
+        struct HardwareBufferFunctionals
+        {
+            static constexpr int8_t kVisibilityShow = 1;            // ASURFACE_TRANSACTION_VISIBILITY_SHOW
+            static constexpr int8_t kTransparencyTranslucent = 1;   // ASURFACE_TRANSACTION_TRANSPARENCY_TRANSLUCENT
+            static constexpr int32_t kTransformMirrorVertical = 2;  // ANATIVEWINDOW_TRANSFORM_MIRROR_VERTICAL
+
+            int (*AHardwareBuffer_allocate)(const AHardwareBuffer_Desc *desc, AHardwareBuffer **outBuffer) = nullptr;
+            void (*AHardwareBuffer_release)(AHardwareBuffer *buffer) = nullptr;
+
+            ASurfaceControl *(*ASurfaceControl_createFromWindow)(ANativeWindow *parent, const char *debugName) = nullptr;
+            void (*ASurfaceControl_release)(ASurfaceControl *surfaceControl) = nullptr;
+
+            ASurfaceTransaction *(*ASurfaceTransaction_create)() = nullptr;
+            void (*ASurfaceTransaction_delete)(ASurfaceTransaction *transaction) = nullptr;
+            void (*ASurfaceTransaction_apply)(ASurfaceTransaction *transaction) = nullptr;
+            void (*ASurfaceTransaction_setBuffer)(ASurfaceTransaction *transaction, ASurfaceControl *surfaceControl, AHardwareBuffer *buffer, int acquireFenceFd) = nullptr;
+            void (*ASurfaceTransaction_setVisibility)(ASurfaceTransaction *transaction, ASurfaceControl *surfaceControl, int8_t visibility) = nullptr;
+            void (*ASurfaceTransaction_setBufferTransparency)(ASurfaceTransaction *transaction, ASurfaceControl *surfaceControl, int8_t transparency) = nullptr;
+            void (*ASurfaceTransaction_setGeometry)(ASurfaceTransaction *transaction, ASurfaceControl *surfaceControl, const ARect &source, const ARect &destination, int32_t transform) = nullptr;
+            void (*ASurfaceTransaction_setOnComplete)(ASurfaceTransaction *transaction, void *context, void (*func)(void *context, ASurfaceTransactionStats *stats)) = nullptr;
+            int (*ASurfaceTransactionStats_getPreviousReleaseFenceFd)(ASurfaceTransactionStats *stats, ASurfaceControl *surfaceControl) = nullptr;
+
+            PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC eglGetNativeClientBufferANDROID = nullptr;
+            PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHR = nullptr;
+            PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHR = nullptr;
+            PFNEGLCREATESYNCKHRPROC eglCreateSyncKHR = nullptr;
+            PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR = nullptr;
+            PFNEGLDUPNATIVEFENCEFDANDROIDPROC eglDupNativeFenceFDANDROID = nullptr;
+            void (*glEGLImageTargetRenderbufferStorageOES)(GLenum target, void *image) = nullptr;
+
+            bool supported = false;
+
+            HardwareBufferFunctionals() {
+                if (10 > Functionals::GetInstance().systemVersion) {
+                    SURFACE_LOG_INFO("Hardware buffer swapchain needs Android 10+");
+                    return;
+                }
+
+                auto libandroid = dlopen("libandroid.so", RTLD_NOW);
+                if (nullptr == libandroid) {
+                    SURFACE_LOG_ERROR("Failed to open libandroid.so");
+                    return;
+                }
+
+                bool resolved = true;
+                auto resolve = [&](auto &function, const char *symbol) {
+                    function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(dlsym(libandroid, symbol));
+                    if (nullptr == function) {
+                        SURFACE_LOG_ERROR("Method not found: %s", symbol);
+                        resolved = false;
+                    }
+                };
+                resolve(AHardwareBuffer_allocate, "AHardwareBuffer_allocate");
+                resolve(AHardwareBuffer_release, "AHardwareBuffer_release");
+                resolve(ASurfaceControl_createFromWindow, "ASurfaceControl_createFromWindow");
+                resolve(ASurfaceControl_release, "ASurfaceControl_release");
+                resolve(ASurfaceTransaction_create, "ASurfaceTransaction_create");
+                resolve(ASurfaceTransaction_delete, "ASurfaceTransaction_delete");
+                resolve(ASurfaceTransaction_apply, "ASurfaceTransaction_apply");
+                resolve(ASurfaceTransaction_setBuffer, "ASurfaceTransaction_setBuffer");
+                resolve(ASurfaceTransaction_setVisibility, "ASurfaceTransaction_setVisibility");
+                resolve(ASurfaceTransaction_setBufferTransparency, "ASurfaceTransaction_setBufferTransparency");
+                resolve(ASurfaceTransaction_setGeometry, "ASurfaceTransaction_setGeometry");
+                resolve(ASurfaceTransaction_setOnComplete, "ASurfaceTransaction_setOnComplete");
+                resolve(ASurfaceTransactionStats_getPreviousReleaseFenceFd, "ASurfaceTransactionStats_getPreviousReleaseFenceFd");
+
+                auto resolveEgl = [&](auto &function, const char *symbol) {
+                    function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(eglGetProcAddress(symbol));
+                    if (nullptr == function) {
+                        SURFACE_LOG_ERROR("EGL/GL extension not found: %s", symbol);
+                        resolved = false;
+                    }
+                };
+                resolveEgl(eglGetNativeClientBufferANDROID, "eglGetNativeClientBufferANDROID");
+                resolveEgl(eglCreateImageKHR, "eglCreateImageKHR");
+                resolveEgl(eglDestroyImageKHR, "eglDestroyImageKHR");
+                resolveEgl(glEGLImageTargetRenderbufferStorageOES, "glEGLImageTargetRenderbufferStorageOES");
+
+                // Optional: without native fences Present() falls back to glFinish()
+                eglCreateSyncKHR = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+                eglDestroySyncKHR = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+                eglDupNativeFenceFDANDROID = reinterpret_cast<PFNEGLDUPNATIVEFENCEFDANDROIDPROC>(eglGetProcAddress("eglDupNativeFenceFDANDROID"));
+
+                supported = resolved;
+            }
+
+            static const HardwareBufferFunctionals &GetInstance() {
+                static HardwareBufferFunctionals functionals;
+                return functionals;
+            }
+        };
+    }
+
+    // Owner thread only (the thread with the EGL context current), like SurfaceManager.
+    // Buffer release notifications arrive on a binder thread and are handed over under a mutex.
+    class HardwareBufferSwapchain
+    {
+    public:
+        static constexpr uint32_t kMaxBufferCount = 4;
+
+        HardwareBufferSwapchain() = default;
+
+        ~HardwareBufferSwapchain() {
+            Destroy();
+        }
+
+        HardwareBufferSwapchain(const HardwareBufferSwapchain &) = delete;
+        HardwareBufferSwapchain &operator=(const HardwareBufferSwapchain &) = delete;
+
+        static bool IsSupported() {
+            return detail::HardwareBufferFunctionals::GetInstance().supported;
+        }
+
+        // 'parentWindow' e.g. from SurfaceManager::Create(): buffers are presented on a child layer of it, so nothing
+        // else may render into the parent. Requires a current EGL context.
+        bool Create(ANativeWindow *parentWindow, int32_t width, int32_t height, uint32_t bufferCount = 2, const char *name = "HardwareBufferSwapchain") {
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+            if (!functionals.supported || nullptr == parentWindow || 0 >= width || 0 >= height)
+                return false;
+
+            Destroy();
+            m_display = eglGetCurrentDisplay();
+            m_width = width;
+            m_height = height;
+            m_bufferCount = 2 > bufferCount ? 2 : (kMaxBufferCount < bufferCount ? kMaxBufferCount : bufferCount);
+            m_state = std::make_shared<SharedState>();
+
+            m_surfaceControl = functionals.ASurfaceControl_createFromWindow(parentWindow, name);
+            if (nullptr == m_surfaceControl) {
+                SURFACE_LOG_ERROR("ASurfaceControl_createFromWindow failed: %s", name);
+                Destroy();
+                return false;
+            }
+
+            for (uint32_t i = 0; i < m_bufferCount; i++) {
+                if (!CreateBuffer(m_buffers[i])) {
+                    Destroy();
+                    return false;
+                }
+            }
+
+            auto transaction = functionals.ASurfaceTransaction_create();
+            functionals.ASurfaceTransaction_setVisibility(transaction, m_surfaceControl, detail::HardwareBufferFunctionals::kVisibilityShow);
+            functionals.ASurfaceTransaction_setBufferTransparency(transaction, m_surfaceControl, detail::HardwareBufferFunctionals::kTransparencyTranslucent);
+            functionals.ASurfaceTransaction_apply(transaction);
+            functionals.ASurfaceTransaction_delete(transaction);
+            SetTransform(0);
+
+            SURFACE_LOG_INFO("Hardware buffer swapchain created: %s, %d x %d, %u buffers", name, width, height, m_bufferCount);
+            return true;
+        }
+
+        void Destroy() {
+            if (!m_state)
+                return;
+
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+            for (uint32_t i = 0; i < m_bufferCount; i++)
+                DestroyBuffer(m_buffers[i]);
+
+            {
+                std::lock_guard<std::mutex> lock(m_state->mutex);
+                for (auto &fence : m_state->releaseFences) {
+                    if (0 <= fence)
+                        close(fence);
+                    fence = -1;
+                }
+            }
+
+            // Pending completion callbacks only touch the shared state, which they keep alive
+            if (nullptr != m_surfaceControl)
+                functionals.ASurfaceControl_release(m_surfaceControl);
+            m_surfaceControl = nullptr;
+            m_state.reset();
+            m_currentBuffer = -1;
+            m_presentedBuffer = -1;
+        }
+
+        bool IsValid() const {
+            return nullptr != m_state;
+        }
+
+        // Wait (at most 'timeout') for a released buffer and bind its framebuffer. False: nothing to render into this frame.
+        bool BeginFrame(std::chrono::milliseconds timeout = std::chrono::milliseconds(100)) {
+            if (!m_state)
+                return false;
+
+            int releaseFence = -1;
+            {
+                std::unique_lock<std::mutex> lock(m_state->mutex);
+                auto acquire = [&] {
+                    for (uint32_t i = 0; i < m_bufferCount; i++) {
+                        if (m_state->free[i]) {
+                            m_currentBuffer = static_cast<int>(i);
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+                if (!m_state->cv.wait_for(lock, timeout, acquire))
+                    return false;
+
+                m_state->free[m_currentBuffer] = false;
+                releaseFence = m_state->releaseFences[m_currentBuffer];
+                m_state->releaseFences[m_currentBuffer] = -1;
+            }
+
+            // The compositor may still be reading the buffer
+            if (0 <= releaseFence) {
+                pollfd fd{releaseFence, POLLIN, 0};
+                (void)poll(&fd, 1, static_cast<int>(timeout.count()));
+                close(releaseFence);
+            }
+
+            auto &buffer = m_buffers[m_currentBuffer];
+            glBindFramebuffer(GL_FRAMEBUFFER, buffer.framebuffer);
+            glViewport(0, 0, m_width, m_height);
+            return true;
+        }
+
+        void Present() {
+            if (!m_state || 0 > m_currentBuffer)
+                return;
+
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+            auto acquireFence = CreateAcquireFence();
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            // The buffer shown so far is released once this one is latched
+            auto context = new CompletionContext{m_state, m_surfaceControl, m_presentedBuffer};
+            auto transaction = functionals.ASurfaceTransaction_create();
+            functionals.ASurfaceTransaction_setBuffer(transaction, m_surfaceControl, m_buffers[m_currentBuffer].hardwareBuffer, acquireFence);
+            functionals.ASurfaceTransaction_setOnComplete(transaction, context, OnTransactionComplete);
+            functionals.ASurfaceTransaction_apply(transaction);
+            functionals.ASurfaceTransaction_delete(transaction);
+
+            m_presentedBuffer = m_currentBuffer;
+            m_currentBuffer = -1;
+        }
+
+        // Display transform of the buffers (ANATIVEWINDOW_TRANSFORM_*), like SurfaceManager::SetBuffersTransform()
+        void SetTransform(int32_t transform) {
+            if (!m_state)
+                return;
+
+            // GL renders bottom-up into the buffer, the compositor flips it back first (flips apply before the 90 degree rotation)
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+            int32_t combined = ((transform & 3) ^ detail::HardwareBufferFunctionals::kTransformMirrorVertical) | (transform & 4);
+            ARect source{0, 0, m_width, m_height};
+            ARect destination = (transform & 4) ? ARect{0, 0, m_height, m_width} : source;
+            auto transaction = functionals.ASurfaceTransaction_create();
+            functionals.ASurfaceTransaction_setGeometry(transaction, m_surfaceControl, source, destination, combined);
+            functionals.ASurfaceTransaction_apply(transaction);
+            functionals.ASurfaceTransaction_delete(transaction);
+        }
+
+        GLuint GetFramebuffer() const {
+            return 0 <= m_currentBuffer ? m_buffers[m_currentBuffer].framebuffer : 0;
+        }
+
+        uint32_t GetBufferCount() const {
+            return m_bufferCount;
+        }
+
+        int32_t GetWidth() const {
+            return m_width;
+        }
+
+        int32_t GetHeight() const {
+            return m_height;
+        }
+
+    private:
+        struct Buffer {
+            AHardwareBuffer *hardwareBuffer = nullptr;
+            EGLImageKHR image = EGL_NO_IMAGE_KHR;
+            GLuint renderbuffer = 0;
+            GLuint framebuffer = 0;
+        };
+
+        struct SharedState {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::array<bool, kMaxBufferCount> free{true, true, true, true};
+            std::array<int, kMaxBufferCount> releaseFences{-1, -1, -1, -1};
+        };
+
+        struct CompletionContext {
+            std::shared_ptr<SharedState> state;
+            ASurfaceControl *surfaceControl;
+            int releasedBuffer;
+        };
+
+        static void OnTransactionComplete(void *context, ASurfaceTransactionStats *stats) {
+            std::unique_ptr<CompletionContext> completion(static_cast<CompletionContext *>(context));
+            if (0 > completion->releasedBuffer)
+                return;
+
+            int releaseFence = detail::HardwareBufferFunctionals::GetInstance().ASurfaceTransactionStats_getPreviousReleaseFenceFd(stats, completion->surfaceControl);
+            {
+                std::lock_guard<std::mutex> lock(completion->state->mutex);
+                auto &fence = completion->state->releaseFences[completion->releasedBuffer];
+                if (0 <= fence)
+                    close(fence);
+                fence = releaseFence;
+                completion->state->free[completion->releasedBuffer] = true;
+            }
+            completion->state->cv.notify_one();
+        }
+
+        bool CreateBuffer(Buffer &buffer) {
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+
+            AHardwareBuffer_Desc desc{};
+            desc.width = static_cast<uint32_t>(m_width);
+            desc.height = static_cast<uint32_t>(m_height);
+            desc.layers = 1;
+            desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+            desc.usage = AHARDWAREBUFFER_USAGE_GPU_FRAMEBUFFER | AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE | AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY;
+            if (0 != functionals.AHardwareBuffer_allocate(&desc, &buffer.hardwareBuffer)) {
+                SURFACE_LOG_ERROR("AHardwareBuffer_allocate failed: %d x %d", m_width, m_height);
+                return false;
+            }
+
+            const EGLint imageAttributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+            auto clientBuffer = functionals.eglGetNativeClientBufferANDROID(buffer.hardwareBuffer);
+            buffer.image = functionals.eglCreateImageKHR(m_display, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID, clientBuffer, imageAttributes);
+            if (EGL_NO_IMAGE_KHR == buffer.image) {
+                SURFACE_LOG_ERROR("eglCreateImageKHR failed: 0x%x", eglGetError());
+                return false;
+            }
+
+            glGenRenderbuffers(1, &buffer.renderbuffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, buffer.renderbuffer);
+            functionals.glEGLImageTargetRenderbufferStorageOES(GL_RENDERBUFFER, buffer.image);
+            glGenFramebuffers(1, &buffer.framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, buffer.framebuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, buffer.renderbuffer);
+            auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+            if (GL_FRAMEBUFFER_COMPLETE != status) {
+                SURFACE_LOG_ERROR("Hardware buffer framebuffer incomplete: 0x%x", status);
+                return false;
+            }
+            return true;
+        }
+
+        void DestroyBuffer(Buffer &buffer) {
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+            if (0 != buffer.framebuffer)
+                glDeleteFramebuffers(1, &buffer.framebuffer);
+            if (0 != buffer.renderbuffer)
+                glDeleteRenderbuffers(1, &buffer.renderbuffer);
+            if (EGL_NO_IMAGE_KHR != buffer.image)
+                functionals.eglDestroyImageKHR(m_display, buffer.image);
+            if (nullptr != buffer.hardwareBuffer)
+                functionals.AHardwareBuffer_release(buffer.hardwareBuffer);
+            buffer = {};
+        }
+
+        // Native fence signalled when the GPU finished this frame, -1 (after glFinish) without EGL_ANDROID_native_fence_sync
+        int CreateAcquireFence() {
+            auto &functionals = detail::HardwareBufferFunctionals::GetInstance();
+            if (nullptr != functionals.eglCreateSyncKHR && nullptr != functionals.eglDupNativeFenceFDANDROID) {
+                auto sync = functionals.eglCreateSyncKHR(m_display, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
+                if (EGL_NO_SYNC_KHR != sync) {
+                    glFlush();
+                    int fence = functionals.eglDupNativeFenceFDANDROID(m_display, sync);
+                    functionals.eglDestroySyncKHR(m_display, sync);
+                    if (EGL_NO_NATIVE_FENCE_FD_ANDROID != fence)
+                        return fence;
+                }
+            }
+            glFinish();
+            return -1;
+        }
+
+        EGLDisplay m_display = EGL_NO_DISPLAY;
+        ASurfaceControl *m_surfaceControl = nullptr;
+        std::shared_ptr<SharedState> m_state;
+        std::array<Buffer, kMaxBufferCount> m_buffers{};
+        uint32_t m_bufferCount = 0;
+        int32_t m_width = 0;
+        int32_t m_height = 0;
+        int m_currentBuffer = -1;   // Being rendered
+        int m_presentedBuffer = -1; // On screen (or about to be)
+    };
+}
+
+#endif // !HARDWARE_BUFFER_SWAPCHAIN_H
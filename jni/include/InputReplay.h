@@ -0,0 +1,355 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+// Input record/replay: InputRecorder serializes every event queued into ImGuiIO (mouse, keys, characters, focus) together with
+// io.DeltaTime, io.DisplaySize and the frame in which the event was first seen queued, i.e. the first NewFrame() after it was added.
+// Events ImGui trickles over several frames (io.ConfigInputTrickleEventQueue) are still tagged with that first frame: queued again
+// at the same frame, they trickle identically on replay. InputReplayer feeds them back frame by frame, so an interaction
+// sequence can be replayed headlessly at full speed as a frame time benchmark of the UI code.
+//
+// File layout (native endianness): header { 'IMIR', version, ini size, ini settings text },
+// then per frame { frame, delta time, display width, display height, event count, events }.
+// Version 1 files (16-bit event counts) are still read.
+
+#include <android/log.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#ifndef INPUT_REPLAY_LOG_TAG
+#define INPUT_REPLAY_LOG_TAG "AImGui"
+#endif
+#define INPUT_REPLAY_LOG_INFO(fmt, ...) __android_log_print(ANDROID_LOG_INFO, INPUT_REPLAY_LOG_TAG, "[+] " fmt, ##__VA_ARGS__)
+#define INPUT_REPLAY_LOG_ERROR(fmt, ...) __android_log_print(ANDROID_LOG_ERROR, INPUT_REPLAY_LOG_TAG, "[-] " fmt, ##__VA_ARGS__)
+
+namespace android {
+    namespace detail {
+        constexpr uint32_t kInputReplayMagic = 0x52494D49; // "IMIR"
+        constexpr uint32_t kInputReplayVersion = 2;    // 2: 32-bit event counts
+
+        // Packed little records instead of raw ImGuiInputEvent (40 bytes, unions and padding)
+        class InputReplayWriter
+        {
+        public:
+            template<typename T>
+            void Put(T value) {
+                auto bytes = reinterpret_cast<const uint8_t *>(&value);
+                m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+            }
+
+            void PutBytes(const void *data, size_t size) {
+                auto bytes = static_cast<const uint8_t *>(data);
+                m_data.insert(m_data.end(), bytes, bytes + size);
+            }
+
+            std::vector<uint8_t> &GetData() {
+                return m_data;
+            }
+
+        private:
+            std::vector<uint8_t> m_data;
+        };
+
+        class InputReplayReader
+        {
+        public:
+            InputReplayReader(const std::vector<uint8_t> &data, size_t offset) : m_data(data), m_offset(offset) {}
+
+            template<typename T>
+            bool Get(T *value) {
+                if (m_data.size() - m_offset < sizeof(T))
+                    return false;
+                memcpy(value, m_data.data() + m_offset, sizeof(T));
+                m_offset += sizeof(T);
+                return true;
+            }
+
+            size_t GetOffset() const {
+                return m_offset;
+            }
+
+        private:
+            const std::vector<uint8_t> &m_data;
+            size_t m_offset;
+        };
+    }
+
+    class InputRecorder
+    {
+    public:
+        ~InputRecorder() {
+            Stop();
+        }
+
+        // Start before a NewFrame(), ideally the first one: window placement comes from the ini settings saved here
+        bool Start(const char *path) {
+            Stop();
+            m_file = fopen(path, "wb");
+            if (nullptr == m_file) {
+                INPUT_REPLAY_LOG_ERROR("Cannot create input recording %s", path);
+                return false;
+            }
+
+            ImGuiContext &g = *GImGui;
+            if (!g.SettingsLoaded && nullptr != g.IO.IniFilename)
+                ImGui::LoadIniSettingsFromDisk(g.IO.IniFilename);
+            g.SettingsLoaded = true;
+            size_t iniSize = 0;
+            const char *ini = ImGui::SaveIniSettingsToMemory(&iniSize);
+
+            detail::InputReplayWriter writer;
+            writer.Put(detail::kInputReplayMagic);
+            writer.Put(detail::kInputReplayVersion);
+            writer.Put(static_cast<uint32_t>(iniSize));
+            writer.PutBytes(ini, iniSize);
+            fwrite(writer.GetData().data(), 1, writer.GetData().size(), m_file);
+
+            // Events still queued belong to the upcoming frame
+            m_nextEventId = g.InputEventsQueue.empty() ? g.InputEventsNextEventId : g.InputEventsQueue[0].EventId;
+            m_frame = 0;
+            INPUT_REPLAY_LOG_INFO("Recording input to %s", path);
+            return true;
+        }
+
+        void Stop() {
+            if (nullptr == m_file)
+                return;
+            fclose(m_file);
+            m_file = nullptr;
+            INPUT_REPLAY_LOG_INFO("Input recording stopped after %u frames", m_frame);
+        }
+
+        bool IsRecording() const {
+            return nullptr != m_file;
+        }
+
+        uint32_t GetFrameCount() const {
+            return m_frame;
+        }
+
+        // Right before ImGui::NewFrame(), once the platform backend queued its events and io.DeltaTime/io.DisplaySize are final
+        void RecordFrame() {
+            if (nullptr == m_file)
+                return;
+
+            ImGuiContext &g = *GImGui;
+            detail::InputReplayWriter events;
+            uint32_t eventCount = 0;
+            for (const ImGuiInputEvent &event : g.InputEventsQueue) {
+                if (event.EventId < m_nextEventId || ImGuiInputEventType_None == event.Type)
+                    continue;
+                events.Put(static_cast<uint8_t>(event.Type));
+                switch (event.Type) {
+                    case ImGuiInputEventType_MousePos:
+                        events.Put(static_cast<uint8_t>(event.MousePos.MouseSource));
+                        events.Put(event.MousePos.PosX);
+                        events.Put(event.MousePos.PosY);
+                        break;
+                    case ImGuiInputEventType_MouseWheel:
+                        events.Put(static_cast<uint8_t>(event.MouseWheel.MouseSource));
+                        events.Put(event.MouseWheel.WheelX);
+                        events.Put(event.MouseWheel.WheelY);
+                        break;
+                    case ImGuiInputEventType_MouseButton:
+                        events.Put(static_cast<uint8_t>(event.MouseButton.MouseSource));
+                        events.Put(static_cast<uint8_t>(event.MouseButton.Button));
+                        events.Put(static_cast<uint8_t>(event.MouseButton.Down));
+                        break;
+                    case ImGuiInputEventType_Key:
+                        events.Put(static_cast<uint32_t>(event.Key.Key));
+                        events.Put(static_cast<uint8_t>(event.Key.Down));
+                        events.Put(event.Key.AnalogValue);
+                        break;
+                    case ImGuiInputEventType_Text:
+                        events.Put(static_cast<uint32_t>(event.Text.Char));
+                        break;
+                    case ImGuiInputEventType_Focus:
+                        events.Put(static_cast<uint8_t>(event.AppFocused.Focused));
+                        break;
+                    default:
+                        break;
+                }
+                eventCount++;
+            }
+            m_nextEventId = g.InputEventsNextEventId;
+
+            detail::InputReplayWriter frame;
+            frame.Put(m_frame++);
+            frame.Put(g.IO.DeltaTime);
+            frame.Put(g.IO.DisplaySize.x);
+            frame.Put(g.IO.DisplaySize.y);
+            frame.Put(eventCount);
+            fwrite(frame.GetData().data(), 1, frame.GetData().size(), m_file);
+            fwrite(events.GetData().data(), 1, events.GetData().size(), m_file);
+        }
+
+    private:
+        FILE *m_file = nullptr;
+        uint32_t m_frame = 0;
+        ImU32 m_nextEventId = 0;
+    };
+
+    class InputReplayer
+    {
+    public:
+        struct Stats {
+            uint32_t frames = 0;
+            double totalMs = 0.0;
+            double meanMs = 0.0;
+            double p50Ms = 0.0;
+            double p99Ms = 0.0;
+            double maxMs = 0.0;
+        };
+
+        bool Open(const char *path) {
+            m_data.clear();
+            FILE *file = fopen(path, "rb");
+            if (nullptr == file) {
+                INPUT_REPLAY_LOG_ERROR("Cannot open input recording %s", path);
+                return false;
+            }
+            uint8_t chunk[16384];
+            size_t size;
+            while ((size = fread(chunk, 1, sizeof(chunk), file)) > 0)
+                m_data.insert(m_data.end(), chunk, chunk + size);
+            fclose(file);
+
+            detail::InputReplayReader reader(m_data, 0);
+            uint32_t magic = 0, version = 0, iniSize = 0;
+            if (!reader.Get(&magic) || !reader.Get(&version) || !reader.Get(&iniSize) || detail::kInputReplayMagic != magic ||
+                1 > version || detail::kInputReplayVersion < version || m_data.size() - reader.GetOffset() < iniSize) {
+                INPUT_REPLAY_LOG_ERROR("%s is not an input recording", path);
+                m_data.clear();
+                return false;
+            }
+            m_version = version;
+            m_iniOffset = reader.GetOffset();
+            m_iniSize = iniSize;
+            m_firstFrameOffset = m_offset = m_iniOffset + iniSize;
+            return true;
+        }
+
+        // Back to the first frame, with the window settings the recording started with
+        void Rewind() {
+            m_offset = m_firstFrameOffset;
+            ImGui::LoadIniSettingsFromMemory(reinterpret_cast<const char *>(m_data.data() + m_iniOffset), m_iniSize);
+        }
+
+        // Queue the next frame's events and set its delta time and display size. False at the end (or on a truncated file).
+        bool ApplyNextFrame() {
+            ImGuiIO &io = ImGui::GetIO();
+            detail::InputReplayReader reader(m_data, m_offset);
+            uint32_t frame = 0;
+            uint32_t eventCount = 0;
+            uint16_t shortEventCount = 0;
+            ImVec2 displaySize;
+            float deltaTime = 0.0f;
+            if (!reader.Get(&frame) || !reader.Get(&deltaTime) || !reader.Get(&displaySize.x) || !reader.Get(&displaySize.y))
+                return false;
+            if (1 == m_version ? !reader.Get(&shortEventCount) : !reader.Get(&eventCount))
+                return false;
+            if (1 == m_version)
+                eventCount = shortEventCount;
+            io.DeltaTime = deltaTime > 0.0f ? deltaTime : 1.0f / 60.0f;
+            io.DisplaySize = displaySize;
+
+            for (uint32_t i = 0; i < eventCount; i++) {
+                uint8_t type = 0, source = 0, button = 0, down = 0;
+                uint32_t value = 0;
+                ImVec2 pos;
+                float analog = 0.0f;
+                if (!reader.Get(&type))
+                    return false;
+                switch (type) {
+                    case ImGuiInputEventType_MousePos:
+                        if (!reader.Get(&source) || !reader.Get(&pos.x) || !reader.Get(&pos.y))
+                            return false;
+                        io.AddMouseSourceEvent(static_cast<ImGuiMouseSource>(source));
+                        io.AddMousePosEvent(pos.x, pos.y);
+                        break;
+                    case ImGuiInputEventType_MouseWheel:
+                        if (!reader.Get(&source) || !reader.Get(&pos.x) || !reader.Get(&pos.y))
+                            return false;
+                        io.AddMouseSourceEvent(static_cast<ImGuiMouseSource>(source));
+                        io.AddMouseWheelEvent(pos.x, pos.y);
+                        break;
+                    case ImGuiInputEventType_MouseButton:
+                        if (!reader.Get(&source) || !reader.Get(&button) || !reader.Get(&down))
+                            return false;
+                        io.AddMouseSourceEvent(static_cast<ImGuiMouseSource>(source));
+                        io.AddMouseButtonEvent(button, 0 != down);
+                        break;
+                    case ImGuiInputEventType_Key:
+                        if (!reader.Get(&value) || !reader.Get(&down) || !reader.Get(&analog))
+                            return false;
+                        io.AddKeyAnalogEvent(static_cast<ImGuiKey>(value), 0 != down, analog);
+                        break;
+                    case ImGuiInputEventType_Text:
+                        if (!reader.Get(&value))
+                            return false;
+                        io.AddInputCharacter(value);
+                        break;
+                    case ImGuiInputEventType_Focus:
+                        if (!reader.Get(&down))
+                            return false;
+                        io.AddFocusEvent(0 != down);
+                        break;
+                    default:
+                        INPUT_REPLAY_LOG_ERROR("Corrupted input recording at frame %u", frame);
+                        return false;
+                }
+            }
+            m_offset = reader.GetOffset();
+            return true;
+        }
+
+        // Replay every frame as fast as possible: ApplyNextFrame(), NewFrame(), 'buildUi', Render(). Only NewFrame() to Render()
+        // is timed; 'consumeDrawData' (e.g. texture uploads for the renderer backend) runs outside the measurement.
+        Stats Run(const std::function<void()> &buildUi, const std::function<void(ImDrawData *)> &consumeDrawData = nullptr) {
+            Stats stats;
+            std::vector<double> frameMs;
+            Rewind();
+            while (ApplyNextFrame()) {
+                auto start = std::chrono::steady_clock::now();
+                ImGui::NewFrame();
+                buildUi();
+                ImGui::Render();
+                frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                if (consumeDrawData)
+                    consumeDrawData(ImGui::GetDrawData());
+            }
+            if (frameMs.empty())
+                return stats;
+
+            stats.frames = static_cast<uint32_t>(frameMs.size());
+            for (double ms : frameMs)
+                stats.totalMs += ms;
+            stats.meanMs = stats.totalMs / static_cast<double>(frameMs.size());
+            std::sort(frameMs.begin(), frameMs.end());
+            stats.p50Ms = frameMs[(frameMs.size() - 1) / 2];
+            stats.p99Ms = frameMs[(frameMs.size() - 1) * 99 / 100];
+            stats.maxMs = frameMs.back();
+            INPUT_REPLAY_LOG_INFO("Input replay: %u frames in %.1f ms, mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms", stats.frames,
+                             stats.totalMs, stats.meanMs, stats.p50Ms, stats.p99Ms, stats.maxMs);
+            return stats;
+        }
+
+    private:
+        std::vector<uint8_t> m_data;
+        uint32_t m_version = detail::kInputReplayVersion;
+        size_t m_iniOffset = 0;
+        size_t m_iniSize = 0;
+        size_t m_firstFrameOffset = 0;
+        size_t m_offset = 0;
+    };
+}
+
+#endif // !INPUT_REPLAY_H
@@ -0,0 +1,235 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+// Input-to-photon latency: follows the oldest input event consumed by a frame (kernel timestamp, CLOCK_MONOTONIC)
+// through ImGuiIO, NewFrame, Render and eglSwapBuffers, and when EGL_ANDROID_get_frame_timestamps is available,
+// up to the time the frame was actually presented on the display.
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <time.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "ANativeWindowCreator.h"
+
+namespace android {
+    namespace detail {
+        // Fixed 1 ms buckets up to kBucketCount - 1 ms, the last bucket collects everything slower
+        class LatencyHistogram
+        {
+        public:
+            static constexpr int kBucketCount = 100;
+
+            void Add(int64_t latencyNs) {
+                if (0 > latencyNs)
+                    return;
+                int64_t bucket = latencyNs / 1000000;
+                m_buckets[kBucketCount - 1 < bucket ? kBucketCount - 1 : bucket]++;
+                m_count++;
+                m_sumNs += latencyNs;
+                if (latencyNs > m_maxNs)
+                    m_maxNs = latencyNs;
+            }
+
+            void Reset() {
+                *this = {};
+            }
+
+            // Upper bound (ms) of the bucket holding the given percentile (0-100), 0 when empty
+            double Percentile(double percentile) const {
+                if (0 == m_count)
+                    return 0.0;
+                auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+                if (0 == target)
+                    target = 1;
+                uint64_t seen = 0;
+                for (int i = 0; i < kBucketCount; i++) {
+                    seen += m_buckets[i];
+                    if (seen >= target)
+                        return kBucketCount - 1 == i ? static_cast<double>(m_maxNs) / 1e6 : static_cast<double>(i + 1);
+                }
+                return static_cast<double>(m_maxNs) / 1e6;
+            }
+
+            double MeanMs() const {
+                return 0 == m_count ? 0.0 : static_cast<double>(m_sumNs) / static_cast<double>(m_count) / 1e6;
+            }
+
+            double MaxMs() const {
+                return static_cast<double>(m_maxNs) / 1e6;
+            }
+
+            uint64_t GetCount() const {
+                return m_count;
+            }
+
+            const std::array<uint32_t, kBucketCount> &GetBuckets() const {
+                return m_buckets;
+            }
+
+        private:
+            std::array<uint32_t, kBucketCount> m_buckets{};
+            uint64_t m_count = 0;
+            int64_t m_sumNs = 0;
+            int64_t m_maxNs = 0;
+        };
+    }
+
+    // Owner thread only. Per frame: BeginFrame() once input has been applied to ImGuiIO, then MarkNewFrame(), MarkRendered(),
+    // MarkSwapped() around eglSwapBuffers(); PollPresentTimes() collects present times of earlier frames.
+    class LatencyTracker
+    {
+    public:
+        enum Metric {
+            MetricInputToApplied,   // Event time -> io.AddXXXEvent() (queueing, frame pacing)
+            MetricInputToNewFrame,
+            MetricInputToRendered,  // GPU commands submitted
+            MetricInputToSwapped,
+            MetricInputToPresent,   // EGL_DISPLAY_PRESENT_TIME_ANDROID
+            MetricCount
+        };
+
+        static int64_t Now() {
+            timespec time{};
+            clock_gettime(CLOCK_MONOTONIC, &time);
+            return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+        }
+
+        // Enable present timestamps on 'surface' (the EGL window surface frames are swapped to). False: swap times only.
+        bool AttachSurface(EGLDisplay display, EGLSurface surface) {
+            m_display = display;
+            m_surface = surface;
+            m_presentSupported = false;
+            m_pendingCount = 0;
+            if (EGL_NO_SURFACE == surface)
+                return false;
+
+            m_getNextFrameId = reinterpret_cast<PFNEGLGETNEXTFRAMEIDANDROIDPROC>(eglGetProcAddress("eglGetNextFrameIdANDROID"));
+            m_getFrameTimestamps = reinterpret_cast<PFNEGLGETFRAMETIMESTAMPSANDROIDPROC>(eglGetProcAddress("eglGetFrameTimestampsANDROID"));
+            auto getFrameTimestampSupported = reinterpret_cast<PFNEGLGETFRAMETIMESTAMPSUPPORTEDANDROIDPROC>(eglGetProcAddress("eglGetFrameTimestampSupportedANDROID"));
+            if (nullptr == m_getNextFrameId || nullptr == m_getFrameTimestamps || nullptr == getFrameTimestampSupported) {
+                SURFACE_LOG_INFO("EGL_ANDROID_get_frame_timestamps unavailable, measuring up to eglSwapBuffers");
+                return false;
+            }
+            if (!getFrameTimestampSupported(display, surface, EGL_DISPLAY_PRESENT_TIME_ANDROID) || !eglSurfaceAttrib(display, surface, EGL_TIMESTAMPS_ANDROID, EGL_TRUE)) {
+                SURFACE_LOG_INFO("Display present timestamps not supported on this surface");
+                return false;
+            }
+            m_presentSupported = true;
+            return true;
+        }
+
+        void DetachSurface() {
+            m_surface = EGL_NO_SURFACE;
+            m_presentSupported = false;
+            m_pendingCount = 0;
+        }
+
+        // 'inputTimeNs': oldest input event applied for this frame, 0 when the frame consumed no input
+        void BeginFrame(int64_t inputTimeNs) {
+            m_frame = {};
+            m_frame.inputTime = inputTimeNs;
+            if (0 != inputTimeNs)
+                Record(MetricInputToApplied, Now());
+        }
+
+        void MarkNewFrame() {
+            Record(MetricInputToNewFrame, Now());
+        }
+
+        void MarkRendered() {
+            Record(MetricInputToRendered, Now());
+        }
+
+        // Call right before eglSwapBuffers() on the attached surface
+        void PrepareSwap() {
+            m_frame.frameId = 0;
+            m_frame.hasFrameId = m_presentSupported && 0 != m_frame.inputTime && m_getNextFrameId(m_display, m_surface, &m_frame.frameId);
+        }
+
+        void MarkSwapped() {
+            Record(MetricInputToSwapped, Now());
+            if (!m_frame.hasFrameId)
+                return;
+
+            // Oldest pending frame is given up when the queue is full (present time never arrived)
+            if (kMaxPendingFrames == m_pendingCount) {
+                for (int i = 1; i < m_pendingCount; i++)
+                    m_pending[i - 1] = m_pending[i];
+                m_pendingCount--;
+            }
+            m_pending[m_pendingCount++] = m_frame;
+        }
+
+        // Present times are only known a few frames later
+        void PollPresentTimes() {
+            int kept = 0;
+            for (int i = 0; i < m_pendingCount; i++) {
+                const EGLint name = EGL_DISPLAY_PRESENT_TIME_ANDROID;
+                EGLnsecsANDROID presentTime = EGL_TIMESTAMP_INVALID_ANDROID;
+                if (!m_getFrameTimestamps(m_display, m_surface, m_pending[i].frameId, 1, &name, &presentTime))
+                    continue; // Frame id too old or surface gone
+
+                if (EGL_TIMESTAMP_PENDING_ANDROID == presentTime)
+                    m_pending[kept++] = m_pending[i];
+                else if (0 < presentTime)
+                    m_histograms[MetricInputToPresent].Add(presentTime - m_pending[i].inputTime);
+            }
+            m_pendingCount = kept;
+        }
+
+        const detail::LatencyHistogram &GetHistogram(Metric metric) const {
+            return m_histograms[metric];
+        }
+
+        bool IsPresentTimeSupported() const {
+            return m_presentSupported;
+        }
+
+        void Reset() {
+            for (auto &histogram : m_histograms)
+                histogram.Reset();
+        }
+
+        void LogSummary() const {
+            static const char *names[MetricCount] = {"applied", "new frame", "rendered", "swapped", "present"};
+            for (int i = 0; i < MetricCount; i++) {
+                auto &histogram = m_histograms[i];
+                if (0 == histogram.GetCount())
+                    continue;
+                SURFACE_LOG_INFO("Input -> %s: n=%llu mean %.1f ms, p50 %.0f ms, p90 %.0f ms, p99 %.0f ms, max %.1f ms", names[i],
+                                 static_cast<unsigned long long>(histogram.GetCount()), histogram.MeanMs(), histogram.Percentile(50.0), histogram.Percentile(90.0), histogram.Percentile(99.0), histogram.MaxMs());
+            }
+        }
+
+    private:
+        static constexpr int kMaxPendingFrames = 8;
+
+        struct Frame {
+            int64_t inputTime = 0;
+            EGLuint64KHR frameId = 0;
+            bool hasFrameId = false;
+        };
+
+        void Record(Metric metric, int64_t now) {
+            if (0 != m_frame.inputTime)
+                m_histograms[metric].Add(now - m_frame.inputTime);
+        }
+
+        EGLDisplay m_display = EGL_NO_DISPLAY;
+        EGLSurface m_surface = EGL_NO_SURFACE;
+        bool m_presentSupported = false;
+        PFNEGLGETNEXTFRAMEIDANDROIDPROC m_getNextFrameId = nullptr;
+        PFNEGLGETFRAMETIMESTAMPSANDROIDPROC m_getFrameTimestamps = nullptr;
+
+        Frame m_frame;
+        std::array<Frame, kMaxPendingFrames> m_pending{};
+        int m_pendingCount = 0;
+        std::array<detail::LatencyHistogram, MetricCount> m_histograms{};
+    };
+}
+
+#endif // !LATENCY_TRACKER_H
@@ -3,11 +3,20 @@
 #include <android/log.h>
 #include <android_native_app_glue.h>
 #include <android/input.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <memory>
+#include <vector>
 
 #include "imgui.h"
+#include "imgui_internal.h"
 #include "backends/imgui_impl_android.h"
 #include "backends/imgui_impl_opengl3.h"
+#include "ANativeWindowCreator.h"
+#include "HardwareBufferSwapchain.h"
+#include "LatencyTracker.h"
+#include "InputReplay.h"
 
 #define LOG_TAG "PureElf"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
@@ -16,8 +25,66 @@
 static EGLDisplay  g_EglDisplay     = EGL_NO_DISPLAY;
 static EGLSurface  g_EglSurface     = EGL_NO_SURFACE;
 static EGLContext  g_EglContext     = EGL_NO_CONTEXT;
+static EGLConfig   g_EglConfig      = nullptr;
 static ANativeWindow* g_NativeWindow = nullptr;
 
+// Surface 管理器归渲染线程 (android_main) 所有, 其他线程通过 Post() 投递操作; 析构时释放所有 Surface
+static std::unique_ptr<android::SurfaceManager> g_SurfaceManager;
+
+// 副屏原生分辨率渲染: 每个副屏一个独立 Surface, 各自的 EGLSurface 和 ImGui 上下文 (共享字体图集和 GL 上下文),
+// 代替把主屏画面缩放镜像到副屏 (大屏模糊, 小屏浪费填充率)
+struct DisplayViewport {
+    ANativeWindow* window;
+    EGLSurface     surface;
+    ImGuiContext*  context;
+    int            width;
+    int            height;
+    uint32_t       layer_stack;
+};
+static std::vector<DisplayViewport> g_DisplayViewports;
+
+// 静态/动态分层: 标记为静态的窗口画到下层 Surface, 仅在其绘制内容变化时重绘;
+// 其余窗口 (包括弹窗和提示) 画到上层 Surface 每帧重绘, 两层由 SurfaceFlinger/HWC 合成.
+// 静态窗口整体位于动态窗口之下
+static android::SurfaceManager::LayeredWindow g_OverlayWindows;
+static EGLSurface  g_StaticEglSurface  = EGL_NO_SURFACE;
+static EGLSurface  g_DynamicEglSurface = EGL_NO_SURFACE;
+// 动态层可选 AHardwareBuffer 交换链 (Android 10+): 直接把缓冲区交给 SurfaceControl 合成, 不经过 BufferQueue.
+// 环境变量 PUREELF_BUFFER_COUNT=2 (双缓冲, 延迟最低) 或 3 (三缓冲) 开启, 不支持时退回 EGL 窗口 Surface
+static android::HardwareBufferSwapchain g_DynamicSwapchain;
+static ImVector<ImGuiID> g_StaticWindowIds;
+
+// 屏幕旋转: 叠加层 Surface 保持创建时的尺寸不重建, 由 SurfaceFlinger 按缓冲区变换旋转显示,
+// 渲染时投影矩阵反向预旋转. 横屏/竖屏各缓存一份窗口布局, 旋转时直接恢复而不是重新排布
+struct WindowLayout {
+    ImGuiID id;
+    ImVec2  pos;
+    ImVec2  size;
+};
+static ImVector<WindowLayout> g_WindowLayouts[2];   // [0] 竖屏, [1] 横屏 (相对创建时方向)
+static int         g_BaseOrientation    = 0;        // 叠加层创建时的屏幕方向
+static int         g_OverlayRotation    = 0;        // 相对创建时顺时针旋转的 90° 次数
+static int         g_OverlayWidth       = 0;        // 叠加层缓冲区尺寸 (不随旋转变化)
+static int         g_OverlayHeight      = 0;
+static bool        g_OrientationDirty   = false;
+
+// 直接读取 /dev/input 触摸屏 (环境变量 PUREELF_EVDEV=1 自动查找, 或指定设备/录制文件路径), 不经过系统输入分发;
+// 面板坐标按当前屏幕方向映射到屏幕坐标
+static bool        g_EvdevInput         = false;
+
+// 输入录制/回放: PUREELF_RECORD_INPUT=<文件> 录制每帧送入 ImGuiIO 的输入事件;
+// PUREELF_REPLAY_INPUT=<文件> 不创建叠加层, 全速无头回放并统计每帧 CPU 耗时 (NewFrame 到 Render), 作为帧耗时回归基准
+static android::InputRecorder g_InputRecorder;
+
+// 输入到上屏延迟: 每帧最早输入事件的内核时间戳 -> 应用到 io -> NewFrame -> Render -> eglSwapBuffers -> 实际显示时间
+static android::LatencyTracker g_LatencyTracker;
+
+// 空闲降频: 环境变量 PUREELF_IDLE_FPS=<n> 开启. 界面连续两帧静止 (无输入, 无按下/激活/拖动, 悬停不变, 见 ImGuiContext::QuiescentFrames)
+// 时主循环在 looper 上最多等待 1/n 秒再出下一帧, 输入线程收到输入立即唤醒; 界面自身的动画 (如 Demo 窗口的曲线) 静止时按 n fps 刷新
+static int         g_IdleFrameMs       = 0;
+static ImU32       g_StaticLayerHash   = 0;
+static bool        g_StaticLayerValid  = false;
+
 static bool InitEGL() {
     LOGI("InitEGL: starting...");
 
@@ -33,7 +100,7 @@ static bool InitEGL() {
     }
 
     const EGLint attribs[] = {
-        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT | EGL_WINDOW_BIT,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
         EGL_BLUE_SIZE, 8,
         EGL_GREEN_SIZE, 8,
@@ -49,6 +116,7 @@ static bool InitEGL() {
         LOGE("eglChooseConfig failed");
         return false;
     }
+    g_EglConfig = config;
 
     // 用 pbuffer 代替窗口表面
     const EGLint pbufferAttribs[] = {
@@ -78,6 +146,366 @@ static bool InitEGL() {
     return true;
 }
 
+static bool InitOverlayWindows() {
+    g_OverlayWindows = g_SurfaceManager->CreateLayered("PureElf");
+    if (!g_OverlayWindows.dynamicWindow)
+        return false;
+
+    g_BaseOrientation = g_SurfaceManager->GetDisplayInfo().orientation;
+    g_OverlayRotation = 0;
+    g_OverlayWidth = ANativeWindow_getWidth(g_OverlayWindows.dynamicWindow);
+    g_OverlayHeight = ANativeWindow_getHeight(g_OverlayWindows.dynamicWindow);
+
+    const char* buffer_count = getenv("PUREELF_BUFFER_COUNT");
+    if (buffer_count != nullptr && android::HardwareBufferSwapchain::IsSupported()) {
+        ANativeWindow* window = g_OverlayWindows.dynamicWindow;
+        if (!g_DynamicSwapchain.Create(window, ANativeWindow_getWidth(window), ANativeWindow_getHeight(window), (uint32_t)atoi(buffer_count), "PureElf-dynamic-buffers"))
+            LOGE("Hardware buffer swapchain unavailable, using EGL window surface");
+    }
+
+    g_StaticEglSurface = eglCreateWindowSurface(g_EglDisplay, g_EglConfig, g_OverlayWindows.staticWindow, nullptr);
+    if (!g_DynamicSwapchain.IsValid())
+        g_DynamicEglSurface = eglCreateWindowSurface(g_EglDisplay, g_EglConfig, g_OverlayWindows.dynamicWindow, nullptr);
+    if (g_StaticEglSurface == EGL_NO_SURFACE || (g_DynamicEglSurface == EGL_NO_SURFACE && !g_DynamicSwapchain.IsValid())) {
+        LOGE("eglCreateWindowSurface failed for overlay layers");
+        return false;
+    }
+    // 交换链路径没有 EGL 窗口表面, 只统计到提交为止
+    g_LatencyTracker.AttachSurface(g_EglDisplay, g_DynamicEglSurface);
+    return true;
+}
+
+static void ShutdownOverlayWindows() {
+    eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+    g_LatencyTracker.DetachSurface();
+    g_DynamicSwapchain.Destroy();
+    if (g_StaticEglSurface != EGL_NO_SURFACE)
+        eglDestroySurface(g_EglDisplay, g_StaticEglSurface);
+    if (g_DynamicEglSurface != EGL_NO_SURFACE)
+        eglDestroySurface(g_EglDisplay, g_DynamicEglSurface);
+    g_StaticEglSurface = g_DynamicEglSurface = EGL_NO_SURFACE;
+    if (g_OverlayWindows.staticWindow)
+        g_SurfaceManager->Destroy(g_OverlayWindows.staticWindow);
+    if (g_OverlayWindows.dynamicWindow)
+        g_SurfaceManager->Destroy(g_OverlayWindows.dynamicWindow);
+    g_OverlayWindows = {};
+}
+
+// 按窗口名标记为静态 (子窗口跟随其根窗口)
+static void MarkStaticWindow(const char* name) {
+    ImGuiID id = ImHashStr(name);
+    if (!g_StaticWindowIds.contains(id))
+        g_StaticWindowIds.push_back(id);
+}
+
+static bool IsStaticDrawList(const ImDrawList* draw_list) {
+    if (draw_list->_OwnerName == nullptr)
+        return false;
+    ImGuiWindow* window = ImGui::FindWindowByName(draw_list->_OwnerName);
+    return window != nullptr && g_StaticWindowIds.contains(window->RootWindow->ID);
+}
+
+// 需在纹理上传之后调用 (GetTexID)
+static ImU32 HashDrawData(const ImDrawData* draw_data) {
+    ImU32 hash = ImHashData(&draw_data->DisplaySize, sizeof(draw_data->DisplaySize));
+    for (const ImDrawList* draw_list : draw_data->CmdLists) {
+        hash = ImHashData(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), hash);
+        hash = ImHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), hash);
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer) {
+            ImTextureID tex_id = cmd.UserCallback == nullptr ? cmd.GetTexID() : ImTextureID_Invalid;
+            hash = ImHashData(&cmd.ClipRect, sizeof(cmd.ClipRect), hash);
+            hash = ImHashData(&tex_id, sizeof(tex_id), hash);
+            hash = ImHashData(&cmd.VtxOffset, sizeof(cmd.VtxOffset), hash);
+            hash = ImHashData(&cmd.IdxOffset, sizeof(cmd.IdxOffset), hash);
+            hash = ImHashData(&cmd.ElemCount, sizeof(cmd.ElemCount), hash);
+        }
+    }
+    return hash;
+}
+
+static void RenderToSurface(EGLSurface surface, ImDrawData* draw_data, android::LatencyTracker* tracker = nullptr) {
+    EGLint width = 0, height = 0;
+    eglMakeCurrent(g_EglDisplay, surface, surface, g_EglContext);
+    eglQuerySurface(g_EglDisplay, surface, EGL_WIDTH, &width);
+    eglQuerySurface(g_EglDisplay, surface, EGL_HEIGHT, &height);
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    if (tracker != nullptr) {
+        tracker->MarkRendered();
+        tracker->PrepareSwap();
+    }
+    eglSwapBuffers(g_EglDisplay, surface);
+    if (tracker != nullptr)
+        tracker->MarkSwapped();
+}
+
+// 没有空闲缓冲区 (合成器仍持有全部缓冲) 时跳过本帧, 不阻塞主循环
+static void RenderToSwapchain(android::HardwareBufferSwapchain& swapchain, ImDrawData* draw_data) {
+    eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+    if (!swapchain.BeginFrame(std::chrono::milliseconds(16)))
+        return;
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    g_LatencyTracker.MarkRendered();
+    swapchain.Present();
+    g_LatencyTracker.MarkSwapped();
+}
+
+static void RenderOverlayLayers(ImDrawData* draw_data) {
+    static ImDrawData static_data, dynamic_data;
+    for (ImDrawData* layer_data : { &static_data, &dynamic_data }) {
+        layer_data->Clear();
+        layer_data->Valid = true;
+        layer_data->DisplayPos = draw_data->DisplayPos;
+        layer_data->DisplaySize = draw_data->DisplaySize;
+        layer_data->FramebufferScale = draw_data->FramebufferScale;
+        layer_data->OwnerViewport = draw_data->OwnerViewport;
+        layer_data->Textures = draw_data->Textures;
+    }
+    for (ImDrawList* draw_list : draw_data->CmdLists)
+        (IsStaticDrawList(draw_list) ? static_data : dynamic_data).AddDrawList(draw_list);
+
+    // 动态层先画, 同时完成纹理上传
+    if (g_DynamicSwapchain.IsValid())
+        RenderToSwapchain(g_DynamicSwapchain, &dynamic_data);
+    else
+        RenderToSurface(g_DynamicEglSurface, &dynamic_data, &g_LatencyTracker);
+
+    ImU32 static_hash = HashDrawData(&static_data);
+    if (!g_StaticLayerValid || static_hash != g_StaticLayerHash) {
+        RenderToSurface(g_StaticEglSurface, &static_data);
+        g_StaticLayerHash = static_hash;
+        g_StaticLayerValid = true;
+    }
+    eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+}
+
+static void SaveWindowLayout(ImVector<WindowLayout>& layout) {
+    layout.resize(0);
+    for (ImGuiWindow* window : ImGui::GetCurrentContext()->Windows) {
+        if (window->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip))
+            continue;
+        layout.push_back({ window->ID, window->Pos, window->Size });
+    }
+}
+
+// 有缓存的窗口恢复到该方向上次的位置和大小; 首次进入该方向的窗口按比例平移并限制在屏幕内, 大小不变
+static void RestoreWindowLayout(const ImVector<WindowLayout>& layout, ImVec2 old_size, ImVec2 new_size) {
+    for (ImGuiWindow* window : ImGui::GetCurrentContext()->Windows) {
+        if (window->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip))
+            continue;
+        const WindowLayout* cached = nullptr;
+        for (const WindowLayout& entry : layout)
+            if (entry.id == window->ID)
+                cached = &entry;
+        if (cached != nullptr) {
+            ImGui::SetWindowPos(window, cached->pos, ImGuiCond_Always);
+            ImGui::SetWindowSize(window, cached->size, ImGuiCond_Always);
+        } else if (old_size.x > 0.0f && old_size.y > 0.0f) {
+            ImVec2 pos(window->Pos.x * new_size.x / old_size.x, window->Pos.y * new_size.y / old_size.y);
+            pos.x = ImClamp(pos.x, 0.0f, ImMax(new_size.x - window->Size.x, 0.0f));
+            pos.y = ImClamp(pos.y, 0.0f, ImMax(new_size.y - window->Size.y, 0.0f));
+            ImGui::SetWindowPos(window, pos, ImGuiCond_Always);
+        }
+    }
+}
+
+// 叠加层在当前方向下的逻辑尺寸
+static ImVec2 GetOverlayDisplaySize() {
+    if (g_OverlayRotation & 1)
+        return ImVec2((float)g_OverlayHeight, (float)g_OverlayWidth);
+    return ImVec2((float)g_OverlayWidth, (float)g_OverlayHeight);
+}
+
+// 查询屏幕方向 (一次 binder 调用), 变化时只更新缓冲区变换和投影矩阵, 不重建 Surface
+static void UpdateOverlayOrientation() {
+    android::SurfaceManager::DisplayInfo display = g_SurfaceManager->GetDisplayInfo();
+    if (display.width <= 0)
+        return;
+    int rotation = ((display.orientation - g_BaseOrientation) % 4 + 4) % 4;
+    if (rotation == g_OverlayRotation)
+        return;
+
+    // 180° 翻转时逻辑尺寸不变, 布局无需调整
+    ImVec2 old_size = GetOverlayDisplaySize();
+    int old_rotation = g_OverlayRotation;
+    g_OverlayRotation = rotation;
+    ImVec2 new_size = GetOverlayDisplaySize();
+    if ((rotation & 1) != (old_rotation & 1)) {
+        SaveWindowLayout(g_WindowLayouts[old_rotation & 1]);
+        RestoreWindowLayout(g_WindowLayouts[rotation & 1], old_size, new_size);
+    }
+
+    // ANATIVEWINDOW_TRANSFORM_*: 0, ROT_90, ROT_180, ROT_270
+    static const int32_t transforms[4] = { 0, 4, 3, 7 };
+    g_SurfaceManager->SetBuffersTransform(g_OverlayWindows.staticWindow, transforms[rotation]);
+    if (g_DynamicSwapchain.IsValid())
+        g_DynamicSwapchain.SetTransform(transforms[rotation]);
+    else
+        g_SurfaceManager->SetBuffersTransform(g_OverlayWindows.dynamicWindow, transforms[rotation]);
+    ImGui_ImplOpenGL3_SetDisplayRotation(4 - rotation);
+    g_StaticLayerValid = false;
+    LOGI("Overlay rotated: orientation %d, %.0f x %.0f", display.orientation, new_size.x, new_size.y);
+}
+
+static void UpdateEvdevDisplay() {
+    if (!g_EvdevInput)
+        return;
+    android::SurfaceManager::DisplayInfo display = g_SurfaceManager->GetDisplayInfo();
+    if (display.width > 0)
+        ImGui_ImplAndroid_SetEvdevDisplay(display.width, display.height, display.orientation);
+}
+
+static void OnDisplayAttached(const android::SurfaceManager::DisplaySurface& display) {
+    DisplayViewport viewport = {};
+    viewport.window = display.nativeWindow;
+    viewport.width = display.width;
+    viewport.height = display.height;
+    viewport.layer_stack = display.layerStack;
+    viewport.surface = eglCreateWindowSurface(g_EglDisplay, g_EglConfig, display.nativeWindow, nullptr);
+    if (viewport.surface == EGL_NO_SURFACE) {
+        LOGE("eglCreateWindowSurface failed for layer stack %u", display.layerStack);
+        return;
+    }
+
+    // 与主上下文共享字体图集, 字形只烘焙一次; GL 上下文相同, 纹理也是同一份
+    ImGuiContext* main_context = ImGui::GetCurrentContext();
+    viewport.context = ImGui::CreateContext(ImGui::GetIO().Fonts);
+    ImGui::SetCurrentContext(viewport.context);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2((float)display.width, (float)display.height);
+
+    // 按副屏自身 DPI 缩放 (Android 以 160 dpi 为 1.0), 字体以目标字号重新光栅化而不是拉伸
+    float dpi_scale = display.density > 0 ? display.density / 160.0f : 1.0f;
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.ScaleAllSizes(dpi_scale);
+    style.FontScaleDpi = dpi_scale;
+
+    ImGui_ImplOpenGL3_Init("#version 300 es");
+    ImGui::SetCurrentContext(main_context);
+
+    // 副屏不等待各自的 vsync, 避免多个屏幕串行阻塞主循环
+    eglMakeCurrent(g_EglDisplay, viewport.surface, viewport.surface, g_EglContext);
+    eglSwapInterval(g_EglDisplay, 0);
+    eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+
+    LOGI("Display viewport attached: layer stack %u, %d x %d, scale %.2f", display.layerStack, display.width, display.height, dpi_scale);
+    g_DisplayViewports.push_back(viewport);
+}
+
+static void OnDisplayDetached(const android::SurfaceManager::DisplaySurface& display) {
+    for (size_t i = 0; i < g_DisplayViewports.size(); i++) {
+        DisplayViewport& viewport = g_DisplayViewports[i];
+        if (viewport.window != display.nativeWindow)
+            continue;
+
+        ImGuiContext* main_context = ImGui::GetCurrentContext();
+        ImGui::SetCurrentContext(viewport.context);
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui::DestroyContext(viewport.context);
+        ImGui::SetCurrentContext(main_context);
+
+        // EGLSurface 持有窗口引用, 必须在窗口销毁前释放
+        eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+        eglDestroySurface(g_EglDisplay, viewport.surface);
+        LOGI("Display viewport detached: layer stack %u", viewport.layer_stack);
+        g_DisplayViewports.erase(g_DisplayViewports.begin() + i);
+        return;
+    }
+}
+
+static void RenderDisplayViewports(float delta_time) {
+    ImGuiContext* main_context = ImGui::GetCurrentContext();
+    for (DisplayViewport& viewport : g_DisplayViewports) {
+        eglMakeCurrent(g_EglDisplay, viewport.surface, viewport.surface, g_EglContext);
+        ImGui::SetCurrentContext(viewport.context);
+        ImGui::GetIO().DeltaTime = delta_time;
+
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui::NewFrame();
+
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Display");
+        ImGui::Text("Layer stack %u: %d x %d", viewport.layer_stack, viewport.width, viewport.height);
+        ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+        ImGui::End();
+
+        ImGui::Render();
+        glViewport(0, 0, viewport.width, viewport.height);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        eglSwapBuffers(g_EglDisplay, viewport.surface);
+    }
+    ImGui::SetCurrentContext(main_context);
+    eglMakeCurrent(g_EglDisplay, g_EglSurface, g_EglSurface, g_EglContext);
+}
+
+// 每帧的界面, 实时渲染和输入回放共用
+static void ShowWindows() {
+    // 静态窗口: 内容不随帧变化, 只在移动/交互时重绘
+    ImGui::Begin("Info");
+    ImGui::Text("Dear ImGui %s", ImGui::GetVersion());
+    ImGui::Text("Display: %.0f x %.0f", ImGui::GetIO().DisplaySize.x, ImGui::GetIO().DisplaySize.y);
+    ImGui::End();
+
+    // 多点触控: 双指缩放直接使用每帧手势增量, 无需对内容重新做命中测试
+    static float touch_zoom = 1.0f;
+    const ImGui_ImplAndroid_Gestures& gestures = ImGui_ImplAndroid_GetGestures();
+    int touch_count = 0;
+    ImGui_ImplAndroid_GetTouches(&touch_count);
+    ImGui::Begin("Touch");
+    if (gestures.Active && ImGui::IsWindowHovered())
+        touch_zoom = ImClamp(touch_zoom * gestures.PinchScale, 0.25f, 8.0f);
+    ImGui::Text("Touches: %d, zoom: %.2f", touch_count, touch_zoom);
+    ImGui::End();
+
+    ImGui::ShowDemoWindow();
+}
+
+// 无头回放录制的输入, 只统计 CPU 耗时; 纹理更新交给渲染后端 (不计时), 不呈现
+static void RunInputReplay(const char* path) {
+    android::InputReplayer replayer;
+    if (!replayer.Open(path))
+        return;
+    ImGui::GetIO().IniFilename = nullptr; // 回放不改写界面布局
+    replayer.Run(ShowWindows, [](ImDrawData* draw_data) {
+        if (draw_data->Textures != nullptr)
+            for (ImTextureData* tex : *draw_data->Textures)
+                if (tex->Status != ImTextureStatus_OK)
+                    ImGui_ImplOpenGL3_UpdateTexture(tex);
+    });
+}
+
+static void handle_app_cmd(struct android_app* app, int32_t cmd) {
+    if (cmd == APP_CMD_CONFIG_CHANGED)
+        g_OrientationDirty = true;
+    // 输入线程已在 process_app_cmd() 中停止; glue 已把新的输入队列挂到主 looper 上, 转交给输入线程
+    if (cmd == APP_CMD_INPUT_CHANGED && ImGui::GetCurrentContext() != nullptr && !g_EvdevInput && app->inputQueue != nullptr)
+        ImGui_ImplAndroid_StartInputThread(app->inputQueue);
+}
+
+// 替代 glue 的 process_cmd: APP_CMD_INPUT_CHANGED 时旧输入队列在 android_app_pre_exec_cmd() 之后随时可能被销毁,
+// 必须在那之前停止输入线程 (它会把队列从自己的 looper 上摘下来)
+static void process_app_cmd(struct android_app* app, struct android_poll_source* source) {
+    (void)source;
+    int8_t cmd = android_app_read_cmd(app);
+    if (cmd == APP_CMD_INPUT_CHANGED && ImGui::GetCurrentContext() != nullptr && !g_EvdevInput)
+        ImGui_ImplAndroid_StopInputThread();
+    android_app_pre_exec_cmd(app, cmd);
+    if (app->onAppCmd != nullptr)
+        app->onAppCmd(app, cmd);
+    android_app_post_exec_cmd(app, cmd);
+}
+
+// 输入法 (IME) 的文字不会出现在 AInputQueue 里: 需要由 Java 侧的 InputConnection 通过 JNI 转交给
+// ImGui_ImplAndroid_AddImeText() / ImGui_ImplAndroid_SetImeComposition(), 并按 io.WantTextInput 显示/隐藏软键盘
+// (做法见 imgui_impl_android.h 的 IME 部分)。本示例只处理按键和触摸事件
 static int32_t handle_input_event(struct android_app* app, AInputEvent* event) {
     if (ImGui_ImplAndroid_HandleInputEvent(event)) {
         return 1;
@@ -89,6 +517,8 @@ void android_main(struct android_app* app) {
     LOGI("android_main started");
     LOGI("Setting input event callback");
     app->onInputEvent = handle_input_event;
+    app->onAppCmd = handle_app_cmd;
+    app->cmdPollSource.process = process_app_cmd;
 
     LOGI("Waiting for window...");
     while (app->window == nullptr) {
@@ -112,46 +542,143 @@ void android_main(struct android_app* app) {
     io.IniFilename = nullptr;
     io.LogFilename = nullptr;
 
-    io.Fonts->AddFontDefault();
+    // 字体图集只需要 alpha 通道, 以 GL_R8 上传可节省 3/4 显存和上传带宽
+    io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+    // 限制字体纹理显存 (低内存设备), 超出时淘汰最久未用的字号/字形而不是继续扩大纹理
+    io.Fonts->TexMemoryBudget = 4 * 1024 * 1024;
+    ImFont* font = io.Fonts->AddFontDefault();
+    // 合并系统中文字体 (存在时). ttc 内字体顺序: JP, KR, SC, TC
+    const char* cjk_font_path = "/system/fonts/NotoSansCJK-Regular.ttc";
+    bool has_cjk_font = false;
+    if (access(cjk_font_path, R_OK) == 0) {
+        ImFontConfig cjk_cfg;
+        cjk_cfg.MergeMode = true;
+        cjk_cfg.FontNo = 2;
+        has_cjk_font = io.Fonts->AddFontFromFileTTF(cjk_font_path, 0.0f, &cjk_cfg) != nullptr;
+    }
 
     LOGI("Initializing ImGui backends...");
     ImGui_ImplAndroid_Init(app->window);
+    // 输入在独立线程读取并带时间戳入队, 渲染耗时不再推迟触摸的读取; handle_input_event 仅在没有输入队列时使用
+    const char* evdev = getenv("PUREELF_EVDEV");
+    if (evdev != nullptr)
+        g_EvdevInput = ImGui_ImplAndroid_StartEvdevThread(strcmp(evdev, "1") == 0 ? nullptr : evdev);
+    if (!g_EvdevInput && app->inputQueue != nullptr)
+        ImGui_ImplAndroid_StartInputThread(app->inputQueue);
+    // 拖动时把触点外推到预计上屏时间 (默认一帧), 有上屏时间戳后按实测的 NewFrame -> 上屏 延迟修正
+    ImGui_ImplAndroid_SetTouchPrediction(1.0f / 60.0f);
+    const char* idle_fps = getenv("PUREELF_IDLE_FPS");
+    if (idle_fps != nullptr && atoi(idle_fps) > 0) {
+        g_IdleFrameMs = 1000 / atoi(idle_fps);
+        ImGui_ImplAndroid_SetInputWakeLooper(app->looper);
+    }
     ImGui_ImplOpenGL3_Init("#version 300 es");
 
+    // 启动时多线程预烘焙常用汉字, 避免首次显示中文时逐字光栅化造成卡顿 (需在后端初始化之后调用)
+    if (has_cjk_font) {
+        int prebaked = io.Fonts->PrebakeGlyphs(font, font->LegacySize, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
+        LOGI("Prebaked %d glyphs", prebaked);
+    }
+
+    // 输入回放: 不创建叠加层, 回放结束后直接退出
+    const char* replay_path = getenv("PUREELF_REPLAY_INPUT");
+    bool layered = false;
+    if (replay_path != nullptr) {
+        RunInputReplay(replay_path);
+    } else {
+        g_SurfaceManager = std::make_unique<android::SurfaceManager>();
+
+        // 静态层 + 动态层两个 Surface; 创建失败时退回 pbuffer 单层渲染
+        layered = InitOverlayWindows();
+        if (!layered) {
+            LOGE("Layered overlay unavailable, rendering to pbuffer");
+            ShutdownOverlayWindows();
+        }
+        MarkStaticWindow("Info");
+        UpdateEvdevDisplay();
+
+        // 副屏 (Android 13+) 以各自原生分辨率和 DPI 渲染
+        g_SurfaceManager->EnableNativeDisplayRendering(true, OnDisplayAttached, OnDisplayDetached);
+        g_SurfaceManager->EnableAutoMirrorDisplay(true);
+    }
+
+    const char* record_path = getenv("PUREELF_RECORD_INPUT");
+    if (record_path != nullptr && replay_path == nullptr)
+        g_InputRecorder.Start(record_path);
+
     LOGI("Entering main loop...");
-    bool running = true;
+    bool running = replay_path == nullptr;
     int frame_count = 0;
 
     while (running) {
         frame_count++;
         if (frame_count % 60 == 0) {
-            LOGI("Main loop iteration %d, FPS: %.1f", frame_count, ImGui::GetIO().Framerate);
+            ImGui_ImplAndroid_InputStats input_stats = ImGui_ImplAndroid_GetInputStats();
+            LOGI("Main loop iteration %d, FPS: %.1f, input: %d events, %d samples received, %d forwarded", frame_count, ImGui::GetIO().Framerate,
+                 input_stats.EventsReceived, input_stats.SamplesReceived, input_stats.EventsForwarded);
         }
 
+        // 静止时阻塞到有输入/命令或超时, 否则只处理已到达的事件
         int events;
         struct android_poll_source* source;
-        while (ALooper_pollAll(0, nullptr, &events, (void**)&source) >= 0) {
+        int poll_timeout = g_IdleFrameMs > 0 && ImGui::GetCurrentContext()->QuiescentFrames >= 2 ? g_IdleFrameMs : 0;
+        while (ALooper_pollAll(poll_timeout, nullptr, &events, (void**)&source) >= 0) {
             if (source) {
                 source->process(app, source);
             }
+            poll_timeout = 0;
+        }
+
+        // 配置变化时立即检查方向, 否则每秒轮询一次 (Activity 可能锁定方向, 收不到配置变化)
+        if ((layered || g_EvdevInput) && (g_OrientationDirty || frame_count % 60 == 0)) {
+            g_OrientationDirty = false;
+            if (layered)
+                UpdateOverlayOrientation();
+            UpdateEvdevDisplay();
         }
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplAndroid_NewFrame();
+        g_LatencyTracker.BeginFrame(ImGui_ImplAndroid_GetFrameInputTimeNs());
+        if (layered)
+            io.DisplaySize = GetOverlayDisplaySize();
+        g_InputRecorder.RecordFrame();
         ImGui::NewFrame();
+        g_LatencyTracker.MarkNewFrame();
 
-        ImGui::ShowDemoWindow();
+        ShowWindows();
 
         ImGui::Render();
-        glViewport(0, 0, 1080, 1920);
-        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (layered) {
+            RenderOverlayLayers(ImGui::GetDrawData());
+        } else {
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            g_LatencyTracker.MarkRendered();
+
+            eglSwapBuffers(g_EglDisplay, g_EglSurface);
+            g_LatencyTracker.MarkSwapped();
+        }
+        g_LatencyTracker.PollPresentTimes();
+        if (frame_count % 600 == 0) {
+            g_LatencyTracker.LogSummary();
+            auto &present = g_LatencyTracker.GetHistogram(android::LatencyTracker::MetricInputToPresent);
+            auto &new_frame = g_LatencyTracker.GetHistogram(android::LatencyTracker::MetricInputToNewFrame);
+            if (present.GetCount() > 0 && new_frame.GetCount() > 0) {
+                float lead = (float)((present.MeanMs() - new_frame.MeanMs()) / 1000.0);
+                ImGui_ImplAndroid_SetTouchPrediction(lead < 0.0f ? 0.0f : (lead > 0.05f ? 0.05f : lead));
+            }
+        }
 
-        eglSwapBuffers(g_EglDisplay, g_EglSurface);
+        g_SurfaceManager->ProcessMirrorDisplay();
+        RenderDisplayViewports(ImGui::GetIO().DeltaTime);
     }
 
     LOGI("Shutting down...");
+    g_InputRecorder.Stop();
+    ShutdownOverlayWindows();
+    g_SurfaceManager.reset(); // 副屏回调需要 ImGui 上下文, 先于 ImGui 销毁
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplAndroid_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,27 @@
+// Host stand-in for <android/keycodes.h>: the key codes imgui_impl_android.cpp maps, with the NDK's values.
+#pragma once
+
+enum
+{
+    AKEYCODE_UNKNOWN = 0,
+    AKEYCODE_0 = 7, AKEYCODE_1, AKEYCODE_2, AKEYCODE_3, AKEYCODE_4, AKEYCODE_5, AKEYCODE_6, AKEYCODE_7, AKEYCODE_8, AKEYCODE_9,
+    AKEYCODE_DPAD_UP = 19, AKEYCODE_DPAD_DOWN, AKEYCODE_DPAD_LEFT, AKEYCODE_DPAD_RIGHT,
+    AKEYCODE_A = 29, AKEYCODE_B, AKEYCODE_C, AKEYCODE_D, AKEYCODE_E, AKEYCODE_F, AKEYCODE_G, AKEYCODE_H, AKEYCODE_I, AKEYCODE_J,
+    AKEYCODE_K, AKEYCODE_L, AKEYCODE_M, AKEYCODE_N, AKEYCODE_O, AKEYCODE_P, AKEYCODE_Q, AKEYCODE_R, AKEYCODE_S, AKEYCODE_T,
+    AKEYCODE_U, AKEYCODE_V, AKEYCODE_W, AKEYCODE_X, AKEYCODE_Y, AKEYCODE_Z,
+    AKEYCODE_COMMA = 55, AKEYCODE_PERIOD, AKEYCODE_ALT_LEFT, AKEYCODE_ALT_RIGHT, AKEYCODE_SHIFT_LEFT, AKEYCODE_SHIFT_RIGHT,
+    AKEYCODE_TAB = 61, AKEYCODE_SPACE = 62,
+    AKEYCODE_ENTER = 66, AKEYCODE_DEL, AKEYCODE_GRAVE, AKEYCODE_MINUS, AKEYCODE_EQUALS, AKEYCODE_LEFT_BRACKET, AKEYCODE_RIGHT_BRACKET,
+    AKEYCODE_BACKSLASH, AKEYCODE_SEMICOLON, AKEYCODE_APOSTROPHE, AKEYCODE_SLASH,
+    AKEYCODE_MENU = 82,
+    AKEYCODE_PAGE_UP = 92, AKEYCODE_PAGE_DOWN,
+    AKEYCODE_ESCAPE = 111, AKEYCODE_FORWARD_DEL, AKEYCODE_CTRL_LEFT, AKEYCODE_CTRL_RIGHT, AKEYCODE_CAPS_LOCK, AKEYCODE_SCROLL_LOCK,
+    AKEYCODE_META_LEFT, AKEYCODE_META_RIGHT,
+    AKEYCODE_SYSRQ = 120, AKEYCODE_BREAK, AKEYCODE_MOVE_HOME, AKEYCODE_MOVE_END, AKEYCODE_INSERT,
+    AKEYCODE_F1 = 131, AKEYCODE_F2, AKEYCODE_F3, AKEYCODE_F4, AKEYCODE_F5, AKEYCODE_F6, AKEYCODE_F7, AKEYCODE_F8, AKEYCODE_F9,
+    AKEYCODE_F10, AKEYCODE_F11, AKEYCODE_F12, AKEYCODE_NUM_LOCK,
+    AKEYCODE_NUMPAD_0 = 144, AKEYCODE_NUMPAD_1, AKEYCODE_NUMPAD_2, AKEYCODE_NUMPAD_3, AKEYCODE_NUMPAD_4, AKEYCODE_NUMPAD_5,
+    AKEYCODE_NUMPAD_6, AKEYCODE_NUMPAD_7, AKEYCODE_NUMPAD_8, AKEYCODE_NUMPAD_9,
+    AKEYCODE_NUMPAD_DIVIDE = 154, AKEYCODE_NUMPAD_MULTIPLY, AKEYCODE_NUMPAD_SUBTRACT, AKEYCODE_NUMPAD_ADD, AKEYCODE_NUMPAD_DOT,
+    AKEYCODE_NUMPAD_COMMA, AKEYCODE_NUMPAD_ENTER, AKEYCODE_NUMPAD_EQUALS,
+};
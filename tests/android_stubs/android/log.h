@@ -0,0 +1,14 @@
+// Host stand-in for <android/log.h>: only what jni/include uses.
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { ANDROID_LOG_UNKNOWN = 0, ANDROID_LOG_DEFAULT, ANDROID_LOG_VERBOSE, ANDROID_LOG_DEBUG, ANDROID_LOG_INFO, ANDROID_LOG_WARN, ANDROID_LOG_ERROR, ANDROID_LOG_FATAL, ANDROID_LOG_SILENT };
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
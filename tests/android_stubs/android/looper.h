@@ -0,0 +1,23 @@
+// Host stand-in for <android/looper.h>: declarations only, implemented in android_stubs.cpp.
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ALooper ALooper;
+typedef int (*ALooper_callbackFunc)(int fd, int events, void* data);
+
+enum { ALOOPER_PREPARE_ALLOW_NON_CALLBACKS = 1 };
+enum { ALOOPER_POLL_WAKE = -1, ALOOPER_POLL_CALLBACK = -2, ALOOPER_POLL_TIMEOUT = -3, ALOOPER_POLL_ERROR = -4 };
+enum { ALOOPER_EVENT_INPUT = 1 << 0 };
+
+ALooper* ALooper_prepare(int opts);
+void ALooper_acquire(ALooper* looper);
+void ALooper_release(ALooper* looper);
+void ALooper_wake(ALooper* looper);
+int ALooper_pollOnce(int timeoutMillis, int* outFd, int* outEvents, void** outData);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+// Host stand-in for <android/native_window.h>: declarations only. getWidth()/getHeight() are implemented in android_stubs.cpp.
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ANativeWindow ANativeWindow;
+
+int32_t ANativeWindow_getWidth(ANativeWindow* window);
+int32_t ANativeWindow_getHeight(ANativeWindow* window);
+void ANativeWindow_acquire(ANativeWindow* window);
+void ANativeWindow_release(ANativeWindow* window);
+
+#ifdef __cplusplus
+}
+#endif
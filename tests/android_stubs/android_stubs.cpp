@@ -0,0 +1,69 @@
+// Host implementations of the few Android entry points reached by the tests.
+// Logs go to stderr when TEST_VERBOSE is set in the environment, and are dropped otherwise.
+
+#include <android/log.h>
+#include "host_android.h"
+#include <sys/system_properties.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+extern "C" int __android_log_print(int prio, const char* tag, const char* fmt, ...)
+{
+    static const bool verbose = getenv("TEST_VERBOSE") != NULL;
+    if (!verbose)
+        return 0;
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%d/%s: ", prio, tag);
+    int n = vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    return n;
+}
+
+extern "C" int __system_property_get(const char* name, char* value)
+{
+    (void)name;
+    value[0] = 0;
+    return 0;
+}
+
+// <android/native_window.h> and <android/input.h> accessors over host_android.h's objects.
+// No AInputQueue or ALooper ever delivers events: tests call ImGui_ImplAndroid_HandleInputEvent() themselves.
+extern "C" int32_t ANativeWindow_getWidth(ANativeWindow* window)                    { return window ? window->Width : 0; }
+extern "C" int32_t ANativeWindow_getHeight(ANativeWindow* window)                   { return window ? window->Height : 0; }
+
+extern "C" int32_t AInputEvent_getType(const AInputEvent* event)                    { return event->Type; }
+extern "C" int32_t AKeyEvent_getAction(const AInputEvent* event)                    { return event->Action; }
+extern "C" int32_t AKeyEvent_getKeyCode(const AInputEvent* event)                   { return event->KeyCode; }
+extern "C" int32_t AKeyEvent_getScanCode(const AInputEvent* event)                  { return event->ScanCode; }
+extern "C" int32_t AKeyEvent_getMetaState(const AInputEvent* event)                 { return event->MetaState; }
+extern "C" int32_t AKeyEvent_getRepeatCount(const AInputEvent* event)               { return event->RepeatCount; }
+extern "C" int64_t AKeyEvent_getEventTime(const AInputEvent* event)                 { return event->EventTime; }
+
+extern "C" int32_t AMotionEvent_getAction(const AInputEvent* event)                 { return event->Action; }
+extern "C" int32_t AMotionEvent_getButtonState(const AInputEvent* event)            { return event->ButtonState; }
+extern "C" int64_t AMotionEvent_getEventTime(const AInputEvent* event)              { return event->EventTime; }
+extern "C" size_t AMotionEvent_getPointerCount(const AInputEvent*)                  { return 1; }
+extern "C" int32_t AMotionEvent_getPointerId(const AInputEvent*, size_t)            { return 0; }
+extern "C" int32_t AMotionEvent_getToolType(const AInputEvent* event, size_t)       { return event->ToolType; }
+extern "C" float AMotionEvent_getX(const AInputEvent* event, size_t)                { return event->X; }
+extern "C" float AMotionEvent_getY(const AInputEvent* event, size_t)                { return event->Y; }
+extern "C" float AMotionEvent_getAxisValue(const AInputEvent*, int32_t, size_t)     { return 0.0f; }
+extern "C" size_t AMotionEvent_getHistorySize(const AInputEvent*)                   { return 0; }
+extern "C" int64_t AMotionEvent_getHistoricalEventTime(const AInputEvent*, size_t)  { return 0; }
+extern "C" float AMotionEvent_getHistoricalX(const AInputEvent*, size_t, size_t)    { return 0.0f; }
+extern "C" float AMotionEvent_getHistoricalY(const AInputEvent*, size_t, size_t)    { return 0.0f; }
+
+extern "C" void AInputQueue_attachLooper(AInputQueue*, ALooper*, int, ALooper_callbackFunc, void*) {}
+extern "C" void AInputQueue_detachLooper(AInputQueue*) {}
+extern "C" int32_t AInputQueue_getEvent(AInputQueue*, AInputEvent**)                { return -1; }
+extern "C" int32_t AInputQueue_preDispatchEvent(AInputQueue*, AInputEvent*)         { return 0; }
+extern "C" void AInputQueue_finishEvent(AInputQueue*, AInputEvent*, int)            {}
+
+extern "C" ALooper* ALooper_prepare(int)                                            { return NULL; }
+extern "C" void ALooper_acquire(ALooper*)                                           {}
+extern "C" void ALooper_release(ALooper*)                                           {}
+extern "C" void ALooper_wake(ALooper*)                                              {}
+extern "C" int ALooper_pollOnce(int, int*, int*, void**)                            { return ALOOPER_POLL_TIMEOUT; }
@@ -0,0 +1,27 @@
+// Host definitions of the objects the NDK keeps opaque, so tests can build them and hand them to imgui_impl_android.cpp.
+// android_stubs.cpp implements the <android/input.h> and <android/native_window.h> accessors over them.
+#pragma once
+
+#include <android/input.h>
+#include <android/native_window.h>
+
+// A key event, or a motion event with a single pointer and no history
+struct AInputEvent
+{
+    int32_t Type = AINPUT_EVENT_TYPE_KEY;
+    int32_t Action = 0;
+    int64_t EventTime = 0;          // Nanoseconds, CLOCK_MONOTONIC
+    int32_t KeyCode = 0;
+    int32_t ScanCode = 0;
+    int32_t MetaState = 0;
+    int32_t RepeatCount = 0;
+    int32_t ToolType = AMOTION_EVENT_TOOL_TYPE_FINGER;
+    int32_t ButtonState = 0;
+    float   X = 0.0f, Y = 0.0f;
+};
+
+struct ANativeWindow
+{
+    int32_t Width = 0;
+    int32_t Height = 0;
+};
@@ -0,0 +1,147 @@
+// DisplayWatcher (ANativeWindowCreator.h) driven by FakeDisplayChangeDetector, with "dumpsys display" replaced by
+// captures from dumpsys/: attach/detach publish new topologies, no-op changes and failed queries publish nothing.
+// Also checks that Interrupt() wakes UeventDisplayChangeDetector promptly when eventfd() is unavailable.
+
+#include "test_common.h"
+#include "ANativeWindowCreator.h"
+#include <sys/resource.h>
+#include <fcntl.h>
+
+using android::detail::DisplayWatcher;
+using android::detail::FakeDisplayChangeDetector;
+using android::detail::UeventDisplayChangeDetector;
+
+static const char* CURRENT_DUMP = "build/display_watcher_current.txt";
+
+static void SetCurrentDump(const char* capture_path)
+{
+    FILE* src = fopen(capture_path, "rb");
+    FILE* dst = fopen(CURRENT_DUMP, "wb");
+    TEST_CHECK(src != NULL && dst != NULL);
+    if (src == NULL || dst == NULL)
+        exit(1);
+    char buf[4096];
+    size_t size;
+    while ((size = fread(buf, 1, sizeof(buf), src)) > 0)
+        fwrite(buf, 1, size, dst);
+    fclose(src);
+    fclose(dst);
+}
+
+// Render thread side: poll ConsumeChanges() like a frame loop would
+static bool WaitForTopology(DisplayWatcher& watcher, int timeout_ms)
+{
+    for (int elapsed = 0; elapsed < timeout_ms; elapsed += 5)
+    {
+        if (watcher.ConsumeChanges())
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+// Wait until the watcher went through a query after the last Trigger() and is idle again
+static void WaitForIdle(FakeDisplayChangeDetector* detector, int wait_count_before)
+{
+    // Trigger ends the fallback wait -> one 100 ms settle wait -> query -> next fallback wait
+    for (int elapsed = 0; elapsed < 2000 && detector->GetWaitCount() < wait_count_before + 2; elapsed += 5)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+}
+
+static void TestAttachDetach()
+{
+    SetCurrentDump("dumpsys/phone_a13.txt");
+
+    auto detector_owned = std::make_unique<FakeDisplayChangeDetector>();
+    FakeDisplayChangeDetector* detector = detector_owned.get();
+    DisplayWatcher watcher;
+    watcher.SetQueryCommand(std::string("cat ") + CURRENT_DUMP);
+    watcher.Start(std::move(detector_owned), std::chrono::hours(1)); // Only our triggers cause queries
+
+    // Initial query always publishes
+    TEST_CHECK(WaitForTopology(watcher, 2000));
+    TEST_CHECK_EQ(watcher.GetTopology().generation, 1);
+    TEST_CHECK_EQ(watcher.GetTopology().displays.size(), 1);
+
+    // Attach an overlay + a virtual display
+    SetCurrentDump("dumpsys/phone_cast_a11.txt");
+    detector->Trigger();
+    TEST_CHECK(WaitForTopology(watcher, 2000));
+    TEST_CHECK_EQ(watcher.GetTopology().generation, 2);
+    TEST_CHECK_EQ(watcher.GetTopology().displays.size(), 3);
+    if (watcher.GetTopology().displays.size() == 3)
+        TEST_CHECK(watcher.GetTopology().displays[2].type == "VIRTUAL");
+
+    // Detach them
+    SetCurrentDump("dumpsys/phone_a13.txt");
+    detector->Trigger();
+    TEST_CHECK(WaitForTopology(watcher, 2000));
+    TEST_CHECK_EQ(watcher.GetTopology().generation, 3);
+    TEST_CHECK_EQ(watcher.GetTopology().displays.size(), 1);
+
+    // Spurious change: queried, but identical topology isn't published
+    int wait_count = detector->GetWaitCount();
+    detector->Trigger();
+    WaitForIdle(detector, wait_count);
+    TEST_CHECK(detector->GetWaitCount() >= wait_count + 2);
+    TEST_CHECK(!watcher.ConsumeChanges());
+
+    // Failed query (service missing, e.g. during a system_server restart): last good topology is kept
+    SetCurrentDump("dumpsys/no_service.txt");
+    wait_count = detector->GetWaitCount();
+    detector->Trigger();
+    WaitForIdle(detector, wait_count);
+    TEST_CHECK(!watcher.ConsumeChanges());
+    TEST_CHECK_EQ(watcher.GetTopology().generation, 3);
+    TEST_CHECK_EQ(watcher.GetTopology().displays.size(), 1);
+
+    // Service back with a new display
+    SetCurrentDump("dumpsys/phone_cast_a11.txt");
+    detector->Trigger();
+    TEST_CHECK(WaitForTopology(watcher, 2000));
+    TEST_CHECK_EQ(watcher.GetTopology().generation, 4);
+    TEST_CHECK_EQ(watcher.GetTopology().displays.size(), 3);
+
+    auto t0 = std::chrono::steady_clock::now();
+    watcher.Stop();
+    TEST_CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(1));
+    TEST_CHECK(!watcher.IsRunning());
+    remove(CURRENT_DUMP);
+}
+
+// Exhaust file descriptors so eventfd() fails in the constructor, then check Interrupt() still wakes WaitForChange().
+static void TestInterruptWithoutEventFd()
+{
+    rlimit old_limit;
+    getrlimit(RLIMIT_NOFILE, &old_limit);
+    int lowest_free_fd = fcntl(0, F_DUPFD, 0);
+    close(lowest_free_fd);
+    rlimit limit = old_limit;
+    limit.rlim_cur = (rlim_t)lowest_free_fd;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    UeventDisplayChangeDetector detector;
+    setrlimit(RLIMIT_NOFILE, &old_limit);
+    TEST_CHECK(!detector.HasWakeupFd());
+
+    std::atomic<bool> result{true};
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread waiter([&] { result = detector.WaitForChange(std::chrono::seconds(10)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    detector.Interrupt();
+    waiter.join();
+    TEST_CHECK(!result);
+    TEST_CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(1));
+
+    // Interrupt() before waiting applies to the next wait
+    detector.Interrupt();
+    t0 = std::chrono::steady_clock::now();
+    TEST_CHECK(!detector.WaitForChange(std::chrono::seconds(10)));
+    TEST_CHECK(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(1));
+}
+
+int main()
+{
+    TestAttachDetach();
+    TestInterruptWithoutEventFd();
+    return TestReport("display_watcher");
+}
@@ -0,0 +1,42 @@
+// Throughput of the streaming "dumpsys display" parser over the captures in dumpsys/, fed in 4 KB chunks like
+// ReadDumpDisplayInfo() does. The output vector is reused across runs, as in DisplayWatcher.
+
+#include "test_common.h"
+#include "ANativeWindowCreator.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+using android::detail::DumpDisplayInfo;
+using android::detail::DumpDisplayInfoParser;
+
+int main()
+{
+    static const char* files[] = { "dumpsys/phone_a13.txt", "dumpsys/phone_cast_a11.txt", "dumpsys/foldable_a14.txt" };
+    for (const char* path : files)
+    {
+        std::ifstream f(path, std::ios::binary);
+        std::stringstream ss;
+        ss << f.rdbuf();
+        const std::string text = ss.str();
+
+        std::vector<DumpDisplayInfo> displays;
+        size_t count = 0;
+        double best_us = 1e9;
+        for (int run = 0; run < 10; run++)
+        {
+            const int ITERATIONS = 2000;
+            auto t0 = std::chrono::steady_clock::now();
+            for (int n = 0; n < ITERATIONS; n++)
+            {
+                DumpDisplayInfoParser parser(displays);
+                for (size_t pos = 0; pos < text.size(); pos += 4096)
+                    parser.Feed(std::string_view(text).substr(pos, 4096));
+                count = parser.Finish();
+            }
+            best_us = ImMin(best_us, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / ITERATIONS);
+        }
+        printf("%-28s %6zu bytes, %zu displays: %7.2f us/parse, %7.1f MB/s\n", path, text.size(), count, best_us, text.size() / best_us);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+// "dumpsys display" parsing (ANativeWindowCreator.h) against the captures in dumpsys/:
+// - expected displays for each capture, whole and fed in arbitrary chunks
+// - ReadDumpDisplayInfo() failure reporting, which DisplayWatcher relies on to keep the last good topology
+
+#include "test_common.h"
+#include "ANativeWindowCreator.h"
+#include <fstream>
+#include <sstream>
+
+using android::detail::DumpDisplayInfo;
+using android::detail::DumpDisplayInfoParser;
+
+static std::string LoadFile(const char* path)
+{
+    std::ifstream f(path, std::ios::binary);
+    TEST_CHECK(f.good());
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+static void CheckDisplay(const DumpDisplayInfo& info, const char* unique_id, uint32_t layer_stack, int32_t orientation, int32_t density, const char* type, int32_t w, int32_t h)
+{
+    TEST_CHECK(info.uniqueId == unique_id);
+    TEST_CHECK_EQ(info.currentLayerStack, layer_stack);
+    TEST_CHECK_EQ(info.orientation, orientation);
+    TEST_CHECK_EQ(info.density, density);
+    TEST_CHECK(info.type == type);
+    TEST_CHECK_EQ(info.currentLayerStackRect.left, 0);
+    TEST_CHECK_EQ(info.currentLayerStackRect.top, 0);
+    TEST_CHECK_EQ(info.currentLayerStackRect.right, w);
+    TEST_CHECK_EQ(info.currentLayerStackRect.bottom, h);
+}
+
+// Parse in chunks of every size from 1 to 64 bytes, reusing the output vector: results must match a single pass.
+static void CheckChunked(const std::string& text, const std::vector<DumpDisplayInfo>& expected)
+{
+    std::vector<DumpDisplayInfo> result;
+    for (size_t chunk = 1; chunk <= 64; chunk++)
+    {
+        DumpDisplayInfoParser parser(result);
+        for (size_t pos = 0; pos < text.size(); pos += chunk)
+            parser.Feed(std::string_view(text).substr(pos, chunk));
+        TEST_CHECK_EQ(parser.Finish(), expected.size());
+        TEST_CHECK(result == expected);
+    }
+}
+
+int main()
+{
+    std::vector<DumpDisplayInfo> displays;
+
+    // Single internal display
+    std::string text = LoadFile("dumpsys/phone_a13.txt");
+    TEST_CHECK_EQ(android::detail::ParseDumpDisplayInfo(text, displays), 1);
+    if (displays.size() == 1)
+        CheckDisplay(displays[0], "local:4619827259835644672", 0, 0, 440, "INTERNAL", 1080, 2400);
+    CheckChunked(text, displays);
+
+    // Landscape internal display + overlay + screen recorder virtual display
+    text = LoadFile("dumpsys/phone_cast_a11.txt");
+    TEST_CHECK_EQ(android::detail::ParseDumpDisplayInfo(text, displays), 3);
+    if (displays.size() == 3)
+    {
+        CheckDisplay(displays[0], "local:0", 0, 1, 400, "INTERNAL", 2340, 1080);
+        CheckDisplay(displays[1], "overlay:1", 1, 0, 160, "OVERLAY", 720, 480);
+        CheckDisplay(displays[2], "virtual:com.android.systemui,10123,ScreenRecorder,0", 2, 0, 320, "VIRTUAL", 1280, 720);
+    }
+    CheckChunked(text, displays);
+
+    // Foldable: the folded inner panel has no layer stack and is skipped
+    text = LoadFile("dumpsys/foldable_a14.txt");
+    TEST_CHECK_EQ(android::detail::ParseDumpDisplayInfo(text, displays), 1);
+    if (displays.size() == 1)
+        CheckDisplay(displays[0], "local:4630946545580055169", 0, 0, 420, "INTERNAL", 1812, 2176);
+    CheckChunked(text, displays);
+
+    // Malformed records are skipped, the valid one is kept
+    text = LoadFile("dumpsys/malformed.txt");
+    TEST_CHECK_EQ(android::detail::ParseDumpDisplayInfo(text, displays), 1);
+    if (displays.size() == 1)
+        CheckDisplay(displays[0], "local:0", 0, 0, 480, "INTERNAL", 1080, 1920);
+    CheckChunked(text, displays);
+
+    // ReadDumpDisplayInfo(): success requires a clean exit and at least one display
+    TEST_CHECK(android::detail::ReadDumpDisplayInfo(displays, "cat dumpsys/phone_cast_a11.txt"));
+    TEST_CHECK_EQ(displays.size(), 3);
+    TEST_CHECK(!android::detail::ReadDumpDisplayInfo(displays, "cat dumpsys/no_service.txt"));
+    TEST_CHECK(!android::detail::ReadDumpDisplayInfo(displays, "cat dumpsys/phone_a13.txt; exit 1"));
+    TEST_CHECK(!android::detail::ReadDumpDisplayInfo(displays, "kill -9 $$"));
+    TEST_CHECK(!android::detail::ReadDumpDisplayInfo(displays, "true"));
+
+    return TestReport("dumpsys_parse");
+}
@@ -0,0 +1,176 @@
+// Multi-touch protocol B decoding (EvdevTouchDecoder.h) of the capture in evdev/:
+// - evdev/pinch_dropped.bin: raw 'struct input_event' records (64-bit layout, as read from /dev/input/eventN) of a touchscreen that also
+//   reports BTN_TOUCH, legacy ABS_X/ABS_Y, touch major and MSC_TIMESTAMP: a drag, a second finger, a SYN_DROPPED overflow, a pen contact
+//   replacing a finger in the same frame, a tracking ID replaced without a lift and events for a slot past the device's range
+// - the pointer stream it decodes to, with the kernel state read back after SYN_DROPPED
+// - contacts lifted by ReleaseAll() when the device goes away
+
+#include "test_common.h"
+#include "EvdevTouchDecoder.h"
+#include <vector>
+
+using android::detail::EvdevTouchDecoder;
+using android::detail::EvdevTouchEvent;
+using Kind = EvdevTouchEvent::Kind;
+
+struct ExpectedTouch
+{
+    int     Frame;          // SYN_REPORT number in the capture
+    Kind    Action;
+    int     Slot;
+    bool    Stylus;
+    bool    Continuation;
+    int32_t X, Y;
+};
+
+static const ExpectedTouch g_Expected[] =
+{
+    { 0, Kind::Down,        0, false, false, 500,  800 },
+    { 1, Kind::Move,        0, false, false, 510,  800 },
+    { 2, Kind::Move,        0, false, false, 510,  805 },   // Slot 0 moved before the second finger went down
+    { 2, Kind::PointerDown, 1, false, false, 900,  1200 },
+    { 3, Kind::Move,        0, false, false, 520,  805 },
+    { 3, Kind::Move,        1, false, true,  880,  1200 },
+    // Frame 4 only changes the touch major: nothing
+    // Frame 5 follows SYN_DROPPED: the X 999 in between is ignored, state comes from the kernel (see KernelState())
+    { 5, Kind::PointerUp,   1, false, false, 880,  1200 },  // Lifted while events were lost, at its last reported position
+    { 5, Kind::Move,        0, false, false, 540,  810 },
+    { 5, Kind::PointerDown, 2, false, false, 300,  300 },
+    { 6, Kind::PointerUp,   2, false, false, 300,  300 },   // Current slot 2 comes from the kernel too
+    { 6, Kind::PointerDown, 3, true,  false, 50,   60 },
+    { 7, Kind::PointerUp,   0, false, false, 540,  810 },
+    { 7, Kind::Up,          3, true,  false, 50,   60 },
+    { 8, Kind::Down,        0, false, false, 10,   20 },
+    { 9, Kind::Up,          0, false, false, 10,   20 },    // New tracking ID without a lift: a new contact
+    { 9, Kind::Down,        0, false, false, 15,   20 },
+    { 10, Kind::Up,         0, false, false, 15,   20 },    // Slot 20 is past the device's 10 slots
+};
+
+static std::vector<input_event> LoadCapture(const char* path)
+{
+    std::vector<input_event> events;
+    FILE* f = fopen(path, "rb");
+    TEST_CHECK(f != NULL);
+    if (f == NULL)
+        return events;
+    input_event event;
+    while (fread(&event, sizeof(event), 1, f) == 1)
+        events.push_back(event);
+    fclose(f);
+    return events;
+}
+
+// What EVIOCGMTSLOTS/EVIOCGABS(ABS_MT_SLOT) return when the decoder resyncs after SYN_DROPPED
+static int g_QueryCount = 0;
+static bool KernelState(uint32_t code, int32_t* values, int count)
+{
+    g_QueryCount++;
+    for (int i = 0; i < count; i++)
+        values[i] = code == ABS_MT_TRACKING_ID ? -1 : 0;
+    switch (code)
+    {
+    case ABS_MT_SLOT:           values[0] = 2; break;
+    case ABS_MT_TRACKING_ID:    values[0] = 100; values[2] = 102; break;
+    case ABS_MT_POSITION_X:     values[0] = 540; values[1] = 880; values[2] = 300; break;
+    case ABS_MT_POSITION_Y:     values[0] = 810; values[1] = 1200; values[2] = 300; break;
+    }
+    return true;
+}
+
+struct DecodedTouch
+{
+    int             Frame;
+    EvdevTouchEvent Event;
+};
+
+static std::vector<DecodedTouch> Decode(const std::vector<input_event>& events)
+{
+    std::vector<DecodedTouch> decoded;
+    EvdevTouchDecoder decoder(10, KernelState);
+    int frame = 0;
+    for (const input_event& event : events)
+    {
+        int64_t time_ns = (int64_t)event.input_event_sec * 1000000000 + (int64_t)event.input_event_usec * 1000;
+        decoder.Process(event, time_ns, [&](const EvdevTouchEvent& touch) { decoded.push_back({ frame, touch }); });
+        if (event.type == EV_SYN && event.code == SYN_REPORT)
+            frame++;
+    }
+    TEST_CHECK_EQ(frame, 11);
+    TEST_CHECK(!decoder.IsSyncDropped());
+    return decoded;
+}
+
+int main()
+{
+    std::vector<input_event> events = LoadCapture("evdev/pinch_dropped.bin");
+    TEST_CHECK_EQ(events.size(), 63);
+
+    // SYN_REPORT times, to check every decoded event carries the time of its frame
+    std::vector<int64_t> frame_times;
+    for (const input_event& event : events)
+        if (event.type == EV_SYN && event.code == SYN_REPORT)
+            frame_times.push_back((int64_t)event.input_event_sec * 1000000000 + (int64_t)event.input_event_usec * 1000);
+
+    std::vector<DecodedTouch> decoded = Decode(events);
+    TEST_CHECK_EQ(g_QueryCount, 4);     // One resync: tracking IDs, X, Y, current slot
+    TEST_CHECK_EQ(decoded.size(), IM_ARRAYSIZE(g_Expected));
+    for (size_t n = 0; n < decoded.size() && n < (size_t)IM_ARRAYSIZE(g_Expected); n++)
+    {
+        const ExpectedTouch& expected = g_Expected[n];
+        const DecodedTouch& touch = decoded[n];
+        TEST_CHECK_EQ(touch.Frame, expected.Frame);
+        TEST_CHECK_EQ(touch.Event.Action, expected.Action);
+        TEST_CHECK_EQ(touch.Event.Slot, expected.Slot);
+        TEST_CHECK_EQ(touch.Event.Stylus, expected.Stylus);
+        TEST_CHECK_EQ(touch.Event.Continuation, expected.Continuation);
+        TEST_CHECK_EQ(touch.Event.RawX, expected.X);
+        TEST_CHECK_EQ(touch.Event.RawY, expected.Y);
+        if (touch.Frame < (int)frame_times.size())
+            TEST_CHECK_EQ(touch.Event.TimeNs, frame_times[touch.Frame]);
+    }
+
+    // Without kernel state (replayed files), SYN_DROPPED only skips events up to the next SYN_REPORT
+    {
+        EvdevTouchDecoder decoder;
+        TEST_CHECK(!decoder.Resync());
+        std::vector<EvdevTouchEvent> out;
+        auto sink = [&](const EvdevTouchEvent& touch) { out.push_back(touch); };
+        input_event event = {};
+        event.type = EV_ABS; event.code = ABS_MT_TRACKING_ID; event.value = 1; decoder.Process(event, 0, sink);
+        event.type = EV_SYN; event.code = SYN_DROPPED; event.value = 0; decoder.Process(event, 0, sink);
+        event.type = EV_ABS; event.code = ABS_MT_TRACKING_ID; event.value = -1; decoder.Process(event, 0, sink);
+        TEST_CHECK(decoder.IsSyncDropped());
+        event.type = EV_SYN; event.code = SYN_REPORT; decoder.Process(event, 0, sink);
+        TEST_CHECK(!decoder.IsSyncDropped());
+        TEST_CHECK_EQ(out.size(), 1);
+        if (out.size() == 1)
+            TEST_CHECK_EQ(out[0].Action, Kind::Down);
+    }
+
+    // A device that goes away with two contacts down lifts both
+    {
+        EvdevTouchDecoder decoder;
+        std::vector<EvdevTouchEvent> out;
+        auto sink = [&](const EvdevTouchEvent& touch) { out.push_back(touch); };
+        input_event event = {};
+        for (int slot = 0; slot < 2; slot++)
+        {
+            event.type = EV_ABS; event.code = ABS_MT_SLOT; event.value = slot; decoder.Process(event, 0, sink);
+            event.type = EV_ABS; event.code = ABS_MT_TRACKING_ID; event.value = 10 + slot; decoder.Process(event, 0, sink);
+        }
+        event.type = EV_SYN; event.code = SYN_REPORT; event.value = 0; decoder.Process(event, 0, sink);
+        event.type = EV_SYN; event.code = SYN_DROPPED; decoder.Process(event, 0, sink);
+        out.clear();
+        decoder.ReleaseAll(5, sink);
+        TEST_CHECK(!decoder.IsSyncDropped());
+        TEST_CHECK_EQ(out.size(), 2);
+        if (out.size() == 2)
+        {
+            TEST_CHECK_EQ(out[0].Action, Kind::PointerUp);
+            TEST_CHECK_EQ(out[1].Action, Kind::Up);
+            TEST_CHECK_EQ(out[1].TimeNs, 5);
+        }
+    }
+
+    return TestReport("evdev_decoder");
+}
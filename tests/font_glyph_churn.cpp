@@ -0,0 +1,139 @@
+// ImFontAtlas::TexMemoryBudget: cycling through more glyphs than fit in the budget must evict and reload them
+// without growing ImFontBaked::Glyphs[] (glyph indices are 16-bit, so unbounded growth eventually asserts).
+// Over budget with nothing evictable, the eviction pass is skipped instead of rescanning every frame.
+
+#include "test_common.h"
+
+static const float FONT_SIZE = 40.0f;
+static const int CHARS_PER_FRAME = 8;
+
+static void DrawFrame(int frame)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::Begin("Churn", NULL, ImGuiWindowFlags_NoDecoration);
+    ImGui::PushFont(NULL, FONT_SIZE);
+    char buf[CHARS_PER_FRAME + 1];
+    for (int n = 0; n < CHARS_PER_FRAME; n++)
+        buf[n] = (char)(0x21 + (frame * CHARS_PER_FRAME + n) % (0x7F - 0x21)); // Walk '!'..'~' over and over
+    buf[CHARS_PER_FRAME] = 0;
+    ImGui::TextUnformatted(buf);
+    ImGui::PopFont();
+    ImGui::End();
+    ImGui::Render();
+    TestUpdateTextures();
+}
+
+static void DrawTextFrame(const char* text)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::Begin("Churn", NULL, ImGuiWindowFlags_NoDecoration);
+    ImGui::PushFont(NULL, FONT_SIZE);
+    ImGui::TextUnformatted(text);
+    ImGui::PopFont();
+    ImGui::End();
+    ImGui::Render();
+    TestUpdateTextures();
+}
+
+// Over budget with every glyph drawn each frame: nothing can be evicted, so the eviction pass must not run every frame,
+// yet glyphs that stop being drawn must still go once the skip expires.
+static void TestEvictionSkip()
+{
+    TestCreateContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    char all_chars[0x7F - 0x21 + 4]; // 3 lines, all visible
+    int len = 0;
+    for (int n = 0; n < 0x7F - 0x21; n++)
+    {
+        if (n > 0 && n % 32 == 0)
+            all_chars[len++] = '\n';
+        all_chars[len++] = (char)(0x21 + n);
+    }
+    all_chars[len] = 0;
+    DrawTextFrame(all_chars);
+    atlas->TexMemoryBudget = 64 * 64 * 4; // Far below what the drawn glyphs need
+
+    const int FRAMES = 300;
+    int passes = 0, last_skip_frame = -1;
+    const ImU64 evictions_before = builder->CacheStats.GlyphEvictions;
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        DrawTextFrame(all_chars);
+        if (builder->EvictSkipUntilFrame != last_skip_frame)
+            passes++;
+        last_skip_frame = builder->EvictSkipUntilFrame;
+    }
+    TEST_CHECK_EQ(builder->CacheStats.GlyphEvictions, evictions_before);
+    TEST_CHECK(passes > 0);
+    TEST_CHECK(passes <= FRAMES / IMGUI_FONT_BUDGET_IDLE_FRAMES + 1);
+
+    // A budget change cancels the skip
+    atlas->TexMemoryBudget = 64 * 64 * 4 + 1024;
+    DrawTextFrame(all_chars);
+    TEST_CHECK_EQ(builder->EvictSkipBudget, atlas->TexMemoryBudget);
+
+    // Half the glyphs stop being drawn: evicted by the next pass
+    all_chars[len / 2] = 0;
+    for (int frame = 0; frame < IMGUI_FONT_BUDGET_IDLE_FRAMES + 3; frame++)
+        DrawTextFrame(all_chars);
+    TEST_CHECK(builder->CacheStats.GlyphEvictions > evictions_before);
+    ImGui::DestroyContext();
+}
+
+// Every Lookup[] entry must point to a live glyph with the same codepoint, and free slots must not be referenced.
+static void CheckLookupConsistency(ImFontBaked* baked)
+{
+    ImVector<int> refs;
+    refs.resize(baked->Glyphs.Size, 0);
+    for (int page_n = 0; page_n < baked->IndexPages.Size; page_n++)
+        for (int i = 0; i < IM_FONTBAKED_INDEX_PAGE_SIZE; i++)
+        {
+            const ImU16 idx = baked->IndexPages[page_n]->Lookup[i];
+            if (idx >= 0xFFFE) // IM_FONTGLYPH_INDEX_UNUSED, IM_FONTGLYPH_INDEX_NOT_FOUND (private to imgui_draw.cpp)
+                continue;
+            TEST_CHECK(idx < baked->Glyphs.Size);
+            if (idx >= baked->Glyphs.Size)
+                continue;
+            TEST_CHECK_EQ(baked->Glyphs[idx].Codepoint, (page_n << IM_FONTBAKED_INDEX_PAGE_SHIFT) + i);
+            refs[idx]++;
+        }
+    for (int slot : baked->GlyphsFreeSlots)
+        TEST_CHECK_EQ(refs[slot], 0);
+    TEST_CHECK_EQ(baked->GlyphsLastUsedFrame.Size, baked->Glyphs.Size);
+}
+
+int main()
+{
+    TestCreateContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    atlas->TexMemoryBudget = 256 * 128 * 4;
+
+    const int FRAMES = 3000;
+    int max_glyphs = 0;
+    for (int frame = 0; frame < FRAMES; frame++)
+    {
+        DrawFrame(frame);
+        ImFontBaked* baked = ImGui::GetFont()->GetFontBaked(FONT_SIZE);
+        max_glyphs = ImMax(max_glyphs, baked->Glyphs.Size);
+    }
+
+    ImFontBaked* baked = ImGui::GetFont()->GetFontBaked(FONT_SIZE);
+    const ImFontAtlasCacheStats& stats = atlas->Builder->CacheStats;
+    printf("glyphs: %d (max %d, %d free slots), glyph evictions: %" IM_PRIu64 ", tex %dx%d\n",
+        baked->Glyphs.Size, max_glyphs, baked->GlyphsFreeSlots.Size, stats.GlyphEvictions, atlas->TexData->Width, atlas->TexData->Height);
+
+    // The workload must actually have gone through eviction several times over.
+    TEST_CHECK(stats.GlyphEvictions > 2 * (0x7F - 0x21));
+
+    // Bounded by the distinct glyphs used (+ fallback/ellipsis/tab and such), regardless of the number of evictions.
+    TEST_CHECK(max_glyphs <= (0x7F - 0x21) + 8);
+    CheckLookupConsistency(baked);
+
+    ImGui::DestroyContext();
+
+    TestEvictionSkip();
+    return TestReport("font_glyph_churn");
+}
@@ -0,0 +1,207 @@
+// Codepoint index of ImFontBaked (IndexPages[], two levels) with a 20k glyph CJK working set, against the flat IndexAdvanceX[]/
+// IndexLookup[] arrays it replaced (rebuilt here from the same glyphs). A fake loader returns metrics only, so nothing is rasterized.
+// Reports index memory, FindGlyph()/GetCharAdvance() lookups per second over the CJK set, and CalcTextSizeA() over ASCII and CJK text.
+// Timings are the best of 8 runs; expect a few % of noise between invocations.
+
+#include "test_common.h"
+#include <chrono>
+#include <vector>
+
+static const unsigned int g_CjkFirst = 0x4E00;
+static const int g_CjkCount = 20000;
+
+// Every ASCII and CJK Unified Ideograph codepoint exists, with a made-up advance
+static bool FakeLoaderLoadGlyph(ImFontAtlas*, ImFontConfig*, ImFontBaked*, void*, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
+{
+    if (!((codepoint >= 0x20 && codepoint < 0x7F) || (codepoint >= 0x4E00 && codepoint <= 0x9FA5)))
+        return false;
+    const float advance_x = (codepoint < 0x80) ? 7.0f + (codepoint % 5) : 16.0f;
+    if (out_advance_x != NULL)
+    {
+        *out_advance_x = advance_x;
+        return true;
+    }
+    out_glyph->AdvanceX = advance_x;
+    out_glyph->Visible = false;
+    return true;
+}
+
+static bool FakeLoaderContainsGlyph(ImFontAtlas*, ImFontConfig*, ImWchar codepoint)
+{
+    return (codepoint >= 0x20 && codepoint < 0x7F) || (codepoint >= 0x4E00 && codepoint <= 0x9FA5);
+}
+
+// The index as it was before IndexPages[]: arrays sized to the highest codepoint loaded
+struct FlatIndex
+{
+    ImVector<float> IndexAdvanceX;
+    ImVector<ImU16> IndexLookup;
+};
+
+static void BuildFlatIndex(FlatIndex* index, const ImFontBaked* baked)
+{
+    unsigned int max_codepoint = 0;
+    for (const ImFontGlyph& glyph : baked->Glyphs)
+        max_codepoint = ImMax(max_codepoint, glyph.Codepoint);
+    index->IndexAdvanceX.resize((int)max_codepoint + 1, -1.0f);
+    index->IndexLookup.resize((int)max_codepoint + 1, (ImU16)-1);
+    for (int glyph_n = 0; glyph_n < baked->Glyphs.Size; glyph_n++)
+    {
+        index->IndexAdvanceX[baked->Glyphs[glyph_n].Codepoint] = baked->Glyphs[glyph_n].AdvanceX;
+        index->IndexLookup[baked->Glyphs[glyph_n].Codepoint] = (ImU16)glyph_n;
+    }
+}
+
+// Out of line like the ImFontBaked members they stand for. With GCC, noinline alone still lets these be specialized for their only caller.
+#if defined(__clang__)
+#define BENCH_OUT_OF_LINE   __attribute__((noinline))
+#else
+#define BENCH_OUT_OF_LINE   __attribute__((noipa))
+#endif
+
+IM_MSVC_RUNTIME_CHECKS_OFF
+static BENCH_OUT_OF_LINE ImFontGlyph* FlatFindGlyph(const FlatIndex* index, ImFontBaked* baked, ImWchar c)
+{
+    if (c < index->IndexLookup.Size) IM_LIKELY
+    {
+        const int i = (int)index->IndexLookup.Data[c];
+        if (i == (ImU16)-2)
+            return &baked->Glyphs.Data[baked->FallbackGlyphIndex];
+        if (i != (ImU16)-1)
+            return &baked->Glyphs.Data[i];
+    }
+    return &baked->Glyphs.Data[baked->FallbackGlyphIndex]; // Not reached: everything is loaded
+}
+
+static BENCH_OUT_OF_LINE float FlatGetCharAdvance(const FlatIndex* index, ImWchar c)
+{
+    if ((int)c < index->IndexAdvanceX.Size)
+    {
+        const float x = index->IndexAdvanceX.Data[c];
+        if (x >= 0.0f)
+            return x;
+    }
+    return 0.0f; // Not reached
+}
+
+// ImFontCalcTextSizeEx() without wrapping, on the flat index
+static BENCH_OUT_OF_LINE float FlatCalcTextWidth(const FlatIndex* index, float scale, float max_width, const char* s, const char* text_end)
+{
+    float text_width = 0.0f, line_width = 0.0f;
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c == '\n')
+        {
+            text_width = ImMax(text_width, line_width);
+            line_width = 0.0f;
+            continue;
+        }
+        if (c == '\r')
+            continue;
+        float char_width = ((int)c < index->IndexAdvanceX.Size) ? index->IndexAdvanceX.Data[c] : -1.0f;
+        if (char_width < 0.0f)
+            char_width = 0.0f; // Not reached
+        char_width *= scale;
+        if (line_width + char_width >= max_width)
+            break;
+        line_width += char_width;
+    }
+    return ImMax(text_width, line_width);
+}
+IM_MSVC_RUNTIME_CHECKS_RESTORE
+
+// Best of 8 runs, in millions of 'count' per second
+template<typename FUNC>
+static double MeasureMillionsPerSecond(size_t count, FUNC func)
+{
+    double best_seconds = 1e9;
+    for (int run = 0; run < 8; run++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        func();
+        best_seconds = ImMin(best_seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return count / best_seconds / 1e6;
+}
+
+int main()
+{
+    ImGuiContext* ctx = TestCreateContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImFontLoader loader;
+    loader.Name = "fake";
+    loader.FontSrcContainsGlyph = FakeLoaderContainsGlyph;
+    loader.FontBakedLoadGlyph = FakeLoaderLoadGlyph;
+    ImFontConfig font_cfg;
+    font_cfg.FontLoader = &loader;
+    font_cfg.SizePixels = 16.0f;
+    ImFont* font = atlas->AddFont(&font_cfg);
+    ImGui::NewFrame();
+    ImFontBaked* baked = font->GetFontBaked(16.0f);
+
+    // Working set: ASCII, then 20k CJK glyphs
+    std::vector<ImWchar> cjk;
+    for (unsigned int c = 0x20; c < 0x7F; c++)
+        baked->FindGlyph((ImWchar)c);
+    for (int n = 0; n < g_CjkCount; n++)
+    {
+        cjk.push_back((ImWchar)(g_CjkFirst + n));
+        baked->FindGlyph(cjk.back());
+    }
+    FlatIndex flat;
+    BuildFlatIndex(&flat, baked);
+
+    int pages_used = 0;
+    for (ImFontBakedIndexPage* page : baked->IndexPages)
+        pages_used += (page != ImFontBakedIndexPage_GetEmpty()) ? 1 : 0;
+    const size_t paged_bytes = (size_t)pages_used * sizeof(ImFontBakedIndexPage) + (size_t)baked->IndexPages.Size * sizeof(ImFontBakedIndexPage*);
+    const size_t flat_bytes = (size_t)flat.IndexAdvanceX.Size * sizeof(float) + (size_t)flat.IndexLookup.Size * sizeof(ImU16);
+    printf("%d glyphs, index memory: pages %zu KB (%d/%d pages), flat %zu KB\n", baked->Glyphs.Size, paged_bytes / 1024, pages_used, baked->IndexPages.Size, flat_bytes / 1024);
+
+    // Lookups in a shuffled order, so consecutive ones rarely share a page
+    srand(28);
+    std::vector<ImWchar> queries;
+    for (int n = 0; n < 1 << 20; n++)
+        queries.push_back(cjk[rand() % cjk.size()]);
+    volatile uintptr_t sink = 0;
+    double paged_find = MeasureMillionsPerSecond(queries.size(), [&] { uintptr_t acc = 0; for (ImWchar c : queries) acc += (uintptr_t)baked->FindGlyph(c); sink = acc; });
+    double flat_find = MeasureMillionsPerSecond(queries.size(), [&] { uintptr_t acc = 0; for (ImWchar c : queries) acc += (uintptr_t)FlatFindGlyph(&flat, baked, c); sink = acc; });
+    volatile float sink_f = 0.0f;
+    double paged_advance = MeasureMillionsPerSecond(queries.size(), [&] { float acc = 0.0f; for (ImWchar c : queries) acc += baked->GetCharAdvance(c); sink_f = acc; });
+    double flat_advance = MeasureMillionsPerSecond(queries.size(), [&] { float acc = 0.0f; for (ImWchar c : queries) acc += FlatGetCharAdvance(&flat, c); sink_f = acc; });
+    printf("FindGlyph:      pages %6.0f M/s, flat %6.0f M/s\n", paged_find, flat_find);
+    printf("GetCharAdvance: pages %6.0f M/s, flat %6.0f M/s\n", paged_advance, flat_advance);
+
+    // Text: a paragraph of ASCII, and CJK drawn from the working set
+    ImGuiTextBuffer ascii_text, cjk_text;
+    while (ascii_text.size() < 64 * 1024)
+        ascii_text.append("The quick brown fox jumps over the lazy dog, 0123456789 times (or more); then rests.\n");
+    for (int n = 0; n < 16 * 1024; n++)
+    {
+        char utf8[5];
+        ImTextCharToUtf8(utf8, cjk[rand() % cjk.size()]);
+        cjk_text.append(utf8);
+    }
+    const int cjk_chars = ImTextCountCharsFromUtf8(cjk_text.begin(), cjk_text.end());
+    float paged_width = 0.0f, flat_width = 0.0f;
+    const float size = baked->Size;
+    struct { const char* Name; ImGuiTextBuffer* Text; int Chars; } texts[] = { { "ASCII", &ascii_text, ascii_text.size() }, { "CJK", &cjk_text, cjk_chars } };
+    for (auto& text : texts)
+    {
+        double paged = MeasureMillionsPerSecond((size_t)text.Chars * 16, [&] { for (int n = 0; n < 16; n++) paged_width = font->CalcTextSizeA(size, FLT_MAX, 0.0f, text.Text->begin(), text.Text->end()).x; });
+        double flat_speed = MeasureMillionsPerSecond((size_t)text.Chars * 16, [&] { for (int n = 0; n < 16; n++) flat_width = FlatCalcTextWidth(&flat, 1.0f, FLT_MAX, text.Text->begin(), text.Text->end()); });
+        printf("CalcTextSizeA %-5s pages %6.0f M chars/s, flat %6.0f M chars/s\n", text.Name, paged, flat_speed);
+        TEST_CHECK(paged_width == flat_width);
+    }
+    IM_UNUSED(sink);
+    IM_UNUSED(sink_f);
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext(ctx);
+    return TestReport("font_index_bench");
+}
@@ -0,0 +1,114 @@
+// Window hit-testing with 500 windows (50 palettes of 9 child windows), driven by the input replay harness (InputReplay.h):
+// a session of mouse sweeps and title bar drags is recorded once, then replayed. Reports the replayed frame times, and at the
+// mouse position of every replayed frame, the cost of FindHoveredWindowEx() (g.WindowsHitTestGrid) against the linear walk.
+
+#include "test_common.h"
+#include "hit_test_reference.h"
+#include "InputReplay.h"
+#include <chrono>
+#include <math.h>
+
+static const char* g_RecordingPath = "build/hit_test_bench.rec";
+static const int g_Palettes = 50;
+static const int g_PaletteChildren = 9;
+static const int g_Frames = 600;
+
+static void BuildUi()
+{
+    for (int p = 0; p < g_Palettes; p++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "Palette %d", p);
+        ImGui::SetNextWindowPos(ImVec2(20.0f + (p % 10) * 230.0f, 20.0f + (p / 10) * 200.0f), ImGuiCond_Once);
+        ImGui::SetNextWindowSize(ImVec2(260, 240), ImGuiCond_Once);
+        ImGui::Begin(name);
+        for (int c = 0; c < g_PaletteChildren; c++)
+        {
+            ImGui::PushID(c);
+            ImGui::BeginChild("tools", ImVec2(70, 50), ImGuiChildFlags_Borders);
+            ImGui::EndChild();
+            if (c % 3 != 2)
+                ImGui::SameLine();
+            ImGui::PopID();
+        }
+        ImGui::End();
+    }
+}
+
+static void Record()
+{
+    ImGuiContext* ctx = TestCreateContext(2400, 1080);
+    ImGuiIO& io = ImGui::GetIO();
+    android::InputRecorder recorder;
+    recorder.Start(g_RecordingPath);
+    for (int frame = 0; frame < g_Frames; frame++)
+    {
+        // Sweeps across the whole display, with a palette dragged by its title bar every 100 frames
+        int drag_frame = frame % 100;
+        float t = frame / (float)g_Frames;
+        if (drag_frame == 0)
+        {
+            io.AddMousePosEvent(40.0f + (frame / 100) * 230.0f, 30.0f);
+            io.AddMouseButtonEvent(0, true);
+        }
+        else if (drag_frame < 40)
+            io.AddMousePosEvent(40.0f + (frame / 100) * 230.0f + drag_frame * 17.0f, 30.0f + drag_frame * 13.0f);
+        else if (drag_frame == 40)
+            io.AddMouseButtonEvent(0, false);
+        else
+            io.AddMousePosEvent(1200.0f + 1150.0f * sinf(t * 37.0f), 540.0f + 520.0f * sinf(t * 23.0f));
+        recorder.RecordFrame();
+        ImGui::NewFrame();
+        BuildUi();
+        ImGui::Render();
+        TestUpdateTextures();
+    }
+    recorder.Stop();
+    ImGui::DestroyContext(ctx);
+}
+
+int main()
+{
+    Record();
+
+    ImGuiContext* ctx = TestCreateContext(2400, 1080);
+    android::InputReplayer replayer;
+    if (!replayer.Open(g_RecordingPath))
+        return 1;
+    replayer.Run(BuildUi, [](ImDrawData*) { TestUpdateTextures(); }); // Warm up: every window exists from here on
+
+    const int QUERIES = 200;
+    double grid_ns = 0.0, linear_ns = 0.0;
+    int queried_frames = 0, mismatches = 0;
+    volatile uintptr_t sink = 0;   // Keeps the queries from being optimized out
+    android::InputReplayer::Stats stats = replayer.Run(BuildUi, [&](ImDrawData*)
+    {
+        TestUpdateTextures();
+        const ImVec2 pos = ImGui::GetIO().MousePos;
+        ImGuiWindow* hovered = NULL, * hovered_under_moving = NULL;
+        ImGuiWindow* linear_hovered = NULL, * linear_hovered_under_moving = NULL;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int n = 0; n < QUERIES; n++)
+        {
+            ImGui::FindHoveredWindowEx(pos, false, &hovered, &hovered_under_moving);
+            sink = sink + (uintptr_t)hovered;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (int n = 0; n < QUERIES; n++)
+        {
+            FindHoveredWindowLinear(pos, false, &linear_hovered, &linear_hovered_under_moving);
+            sink = sink + (uintptr_t)linear_hovered;
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        grid_ns += std::chrono::duration<double, std::nano>(t1 - t0).count() / QUERIES;
+        linear_ns += std::chrono::duration<double, std::nano>(t2 - t1).count() / QUERIES;
+        mismatches += hovered != linear_hovered || hovered_under_moving != linear_hovered_under_moving;
+        queried_frames++;
+    });
+
+    printf("%d windows, %u replayed frames: mean %.3f ms, p50 %.3f ms, p99 %.3f ms\n", GImGui->Windows.Size, stats.frames, stats.meanMs, stats.p50Ms, stats.p99Ms);
+    printf("FindHoveredWindowEx: grid %.1f ns/query, linear walk %.1f ns/query (x%.1f), %d mismatches\n", grid_ns / queried_frames,
+        linear_ns / queried_frames, linear_ns / grid_ns, mismatches);
+    ImGui::DestroyContext(ctx);
+    return mismatches == 0 ? 0 : 1;
+}
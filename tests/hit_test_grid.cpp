@@ -0,0 +1,146 @@
+// Window hit-testing through g.WindowsHitTestGrid (FindHoveredWindowEx()) against the linear walk it replaced (hit_test_reference.h):
+// overlapping and child windows, NoResize/AlwaysAutoResize padding, NoInputs windows, a popup and a tooltip, a hit-test hole,
+// a window bigger than IMGUI_HITTEST_GRID_MAX_CELLS, windows appearing/disappearing, focus changes reordering g.Windows,
+// window drags (g.MovingWindow) and a TouchExtraPadding increase. Both search modes, at random points and around every window edge.
+
+#include "test_common.h"
+#include "hit_test_reference.h"
+
+static const int g_WindowCount = 60;
+static int g_ComparedPoints = 0;
+
+static void BuildUi(int frame)
+{
+    for (int n = 0; n < g_WindowCount; n++)
+    {
+        // Windows 40+ come and go
+        if (n >= 40 && ((frame / 25 + n) % 3) == 0)
+            continue;
+        ImGuiWindowFlags flags = 0;
+        if (n % 7 == 1)
+            flags |= ImGuiWindowFlags_NoResize;
+        if (n % 11 == 2)
+            flags |= ImGuiWindowFlags_AlwaysAutoResize;
+        if (n % 9 == 3)
+            flags |= ImGuiWindowFlags_NoInputs;
+        char name[32];
+        snprintf(name, sizeof(name), "Window %d", n);
+        ImGui::SetNextWindowPos(ImVec2((float)((n * 97) % 1100), (float)((n * 53) % 600)), ImGuiCond_Once);
+        ImGui::SetNextWindowSize(ImVec2((float)(120 + (n * 31) % 260), (float)(90 + (n * 17) % 200)), ImGuiCond_Once);
+        ImGui::Begin(name, NULL, flags);
+        ImGui::Text("%d", n);
+        if (n % 4 == 0)
+        {
+            ImGui::BeginChild("child", ImVec2(80, 60), ImGuiChildFlags_Borders);
+            ImGui::Text("child");
+            ImGui::EndChild();
+        }
+        if (n == 5)
+            ImGui::SetWindowHitTestHole(ImGui::GetCurrentWindow(), ImGui::GetWindowPos() + ImVec2(20, 30), ImVec2(40, 30));
+        if (n == 6 && frame % 40 == 10)
+            ImGui::SetWindowPos(ImVec2((float)(frame % 900), 200.0f)); // Programmatic move, OuterRectClipped lags by a frame
+        if (n == 8 && (frame / 30) % 2 == 0)
+        {
+            ImGui::Button("popup");
+            if (frame % 30 == 0)
+                ImGui::OpenPopup("menu");
+            if (ImGui::BeginPopup("menu"))
+            {
+                ImGui::Text("popup contents");
+                ImGui::EndPopup();
+            }
+            if (frame % 30 < 15)
+                ImGui::SetTooltip("tooltip"); // Follows the mouse, never hit
+        }
+        ImGui::End();
+    }
+
+    // Full-screen background, more than IMGUI_HITTEST_GRID_MAX_CELLS cells: kept in LargeWindows
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Background", NULL, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoBringToFrontOnFocus);
+    ImGui::End();
+}
+
+static void ComparePoint(const ImVec2& pos)
+{
+    for (int find_first = 0; find_first < 2; find_first++)
+    {
+        ImGuiWindow* grid_hovered = NULL, * grid_under_moving = NULL;
+        ImGuiWindow* linear_hovered = NULL, * linear_under_moving = NULL;
+        ImGui::FindHoveredWindowEx(pos, find_first != 0, &grid_hovered, &grid_under_moving);
+        FindHoveredWindowLinear(pos, find_first != 0, &linear_hovered, &linear_under_moving);
+        if (grid_hovered != linear_hovered || grid_under_moving != linear_under_moving)
+        {
+            fprintf(stderr, "(%.1f,%.1f) mode %d: grid '%s'/'%s', linear '%s'/'%s'\n", pos.x, pos.y, find_first,
+                grid_hovered ? grid_hovered->Name : "-", grid_under_moving ? grid_under_moving->Name : "-",
+                linear_hovered ? linear_hovered->Name : "-", linear_under_moving ? linear_under_moving->Name : "-");
+            g_TestFailures++;
+        }
+        g_ComparedPoints++;
+    }
+}
+
+static void CompareAll()
+{
+    ImGuiContext& g = *GImGui;
+    for (int n = 0; n < 300; n++)
+        ComparePoint(ImVec2((float)(rand() % 1500) - 100.0f, (float)(rand() % 1000) - 100.0f));
+    // Just inside/outside every edge, where padding decides
+    const float offsets[] = { -g.Style.WindowBorderHoverPadding - 0.5f, -g.Style.TouchExtraPadding.x - 0.5f, -0.5f, 0.0f, 0.5f, 4.5f };
+    for (ImGuiWindow* window : g.Windows)
+    {
+        if (!window->WasActive)
+            continue;
+        const ImRect& r = window->OuterRectClipped;
+        for (float o : offsets)
+        {
+            ComparePoint(ImVec2(r.Min.x + o, r.GetCenter().y));
+            ComparePoint(ImVec2(r.Max.x - o, r.GetCenter().y));
+            ComparePoint(ImVec2(r.GetCenter().x, r.Min.y + o));
+            ComparePoint(ImVec2(r.GetCenter().x, r.Max.y - o));
+            ComparePoint(ImVec2(r.Min.x + o, r.Min.y + o));
+        }
+    }
+}
+
+int main()
+{
+    ImGuiContext* ctx = TestCreateContext(1280, 800);
+    ImGuiIO& io = ImGui::GetIO();
+    srand(48);
+    int moving_frames = 0, popup_frames = 0, tooltip_frames = 0;
+    for (int frame = 0; frame < 300; frame++)
+    {
+        // Clicks focus (reorder) windows, presses on title bars start drags
+        int r = rand() % 100;
+        if (r < 30)
+            io.AddMousePosEvent((float)(rand() % 1280), (float)(rand() % 800));
+        else if (r < 45)
+            io.AddMouseButtonEvent(0, !io.MouseDown[0]);
+        else if (r < 50)
+        {
+            ImGuiWindow* window = GImGui->Windows[rand() % GImGui->Windows.Size];
+            io.AddMousePosEvent(window->Pos.x + 30.0f, window->Pos.y + 5.0f);
+            io.AddMouseButtonEvent(0, true);
+        }
+        if (frame == 150)
+            ImGui::GetStyle().TouchExtraPadding = ImVec2(12, 12); // Above WindowBorderHoverPadding: the grid is rebuilt
+        ImGui::NewFrame();
+        BuildUi(frame);
+        ImGui::Render();
+        TestUpdateTextures();
+        CompareAll();
+        moving_frames += GImGui->MovingWindow != NULL;
+        popup_frames += GImGui->OpenPopupStack.Size > 0;
+        ImGuiWindow* tooltip = ImGui::FindWindowByName("##Tooltip_00");
+        tooltip_frames += tooltip != NULL && tooltip->Active;
+    }
+    TEST_CHECK(g_ComparedPoints > 100000);
+    TEST_CHECK(moving_frames > 0);
+    TEST_CHECK(popup_frames > 0);
+    TEST_CHECK(tooltip_frames > 0);
+    TEST_CHECK(GImGui->WindowsHitTestGrid.LargeWindows.Size > 0);
+    ImGui::DestroyContext(ctx);
+    return TestReport("hit_test_grid");
+}
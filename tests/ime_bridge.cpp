@@ -0,0 +1,176 @@
+// IME bridge of imgui_impl_android.cpp (ImGui_ImplAndroid_AddImeText(), ImGui_ImplAndroid_SetImeComposition()), through the backend's
+// NewFrame() with host AInputEvents (android_stubs/host_android.h): text committed from another thread reaches the focused InputText(),
+// the composition is drawn at its cursor on the foreground draw list, is cleared when that InputText() is deactivated (tap on another
+// field, tap outside) rather than showing up in the next one, and an AKEY_EVENT_ACTION_MULTIPLE AKEYCODE_DEL erases RepeatCount characters.
+// Commits and key events are applied in timestamp order, not commits last.
+
+#include "test_common.h"
+#include "host_android.h"
+#include "imgui_impl_android.h"
+#include <android/keycodes.h>
+#include <string.h>
+#include <time.h>
+#include <thread>
+
+static char g_Search[64];
+static char g_Name[64];
+static ImRect g_SearchRect, g_NameRect;
+
+static void BuildUi(bool focus_search)
+{
+    ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(400, 200), ImGuiCond_Once);
+    ImGui::Begin("IME");
+    if (focus_search)
+        ImGui::SetKeyboardFocusHere();
+    ImGui::InputText("Search", g_Search, IM_ARRAYSIZE(g_Search));
+    g_SearchRect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    ImGui::InputText("Name", g_Name, IM_ARRAYSIZE(g_Name));
+    g_NameRect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    ImGui::End();
+}
+
+// Runs one frame through the backend, returns the foreground draw list's bounds (empty: nothing drawn over the windows)
+static ImRect RunFrame(bool focus_search = false)
+{
+    ImGui_ImplAndroid_NewFrame();
+    ImGui::NewFrame();
+    BuildUi(focus_search);
+    ImGui::Render();
+    TestUpdateTextures();
+    ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (ImDrawList* draw_list : ImGui::GetDrawData()->CmdLists)
+        if (strstr(draw_list->_OwnerName, "##Foreground") != NULL)
+            for (const ImDrawVert& vtx : draw_list->VtxBuffer)
+                bounds.Add(vtx.pos);
+    return bounds;
+}
+
+static bool IsDrawn(const ImRect& bounds)
+{
+    return bounds.Min.x <= bounds.Max.x;
+}
+
+static int64_t NowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+// Backspace pressed and released at 'time'
+static void PressDel(int64_t time)
+{
+    AInputEvent event;
+    event.Type = AINPUT_EVENT_TYPE_KEY;
+    event.KeyCode = AKEYCODE_DEL;
+    event.EventTime = time;
+    event.Action = AKEY_EVENT_ACTION_DOWN;
+    ImGui_ImplAndroid_HandleInputEvent(&event);
+    event.Action = AKEY_EVENT_ACTION_UP;
+    ImGui_ImplAndroid_HandleInputEvent(&event);
+}
+
+// Finger down, then up a frame later (trickled by io.ConfigInputTrickleEventQueue either way)
+static void Tap(float x, float y)
+{
+    AInputEvent event;
+    event.Type = AINPUT_EVENT_TYPE_MOTION;
+    event.X = x;
+    event.Y = y;
+    event.Action = AMOTION_EVENT_ACTION_DOWN;
+    ImGui_ImplAndroid_HandleInputEvent(&event);
+    RunFrame();
+    event.Action = AMOTION_EVENT_ACTION_UP;
+    ImGui_ImplAndroid_HandleInputEvent(&event);
+    RunFrame();
+}
+
+int main()
+{
+    ImGuiContext* ctx = TestCreateContext();
+    ImGui::GetIO().ConfigInputTrickleEventQueue = true; // Key repeats are down/up pairs queued at once, as from the backend on a device
+    ANativeWindow window;
+    window.Width = 1280;
+    window.Height = 720;
+    ImGui_ImplAndroid_Init(&window);
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiContext& g = *GImGui;
+
+    RunFrame(true);
+    RunFrame();
+    const ImGuiID search_id = g.ActiveId;
+    TEST_CHECK(search_id != 0);
+
+    // Commits and a composition from an InputConnection thread, applied together at the next NewFrame()
+    std::thread ime_thread([]
+    {
+        ImGui_ImplAndroid_AddImeText("ni");
+        ImGui_ImplAndroid_AddImeText("\xe4\xbd\xa0\xe5\xa5\xbd"); // "ni hao" in CJK: 3 bytes per character
+        ImGui_ImplAndroid_SetImeComposition("shi", 2);
+    });
+    ime_thread.join();
+    ImRect overlay = RunFrame();
+    TEST_CHECK(strcmp(g_Search, "ni\xe4\xbd\xa0\xe5\xa5\xbd") == 0);
+    TEST_CHECK(io.InputComposition.Size > 0 && strcmp(io.InputComposition.Data, "shi") == 0);
+    TEST_CHECK_EQ(io.InputCompositionCursor, 2);
+    TEST_CHECK(IsDrawn(overlay));
+    TEST_CHECK(overlay.Min.y >= g_SearchRect.Min.y && overlay.Max.y <= g_SearchRect.Max.y);
+
+    // Composing ends
+    ImGui_ImplAndroid_SetImeComposition(nullptr);
+    TEST_CHECK(!IsDrawn(RunFrame()));
+    TEST_CHECK_EQ(io.InputComposition.Size, 0);
+
+    // One AKEY_EVENT_ACTION_MULTIPLE event for three backspaces: three characters go, whatever their UTF-8 length
+    AInputEvent del;
+    del.Type = AINPUT_EVENT_TYPE_KEY;
+    del.Action = AKEY_EVENT_ACTION_MULTIPLE;
+    del.KeyCode = AKEYCODE_DEL;
+    del.RepeatCount = 3;
+    ImGui_ImplAndroid_HandleInputEvent(&del);
+    for (int n = 0; n < 8; n++)
+        RunFrame();
+    TEST_CHECK(strcmp(g_Search, "n") == 0);
+
+    // Commit then backspace: the backspace erases committed text. Backspace timestamped before a commit: erases what was there.
+    ImGui_ImplAndroid_AddImeText("xy");
+    PressDel(NowNs());
+    for (int n = 0; n < 4; n++)
+        RunFrame();
+    TEST_CHECK(strcmp(g_Search, "nx") == 0);
+    const int64_t before_commit = NowNs();
+    ImGui_ImplAndroid_AddImeText("z");
+    PressDel(before_commit);
+    for (int n = 0; n < 4; n++)
+        RunFrame();
+    TEST_CHECK(strcmp(g_Search, "nz") == 0);
+    PressDel(NowNs());
+    for (int n = 0; n < 4; n++)
+        RunFrame();
+    TEST_CHECK(strcmp(g_Search, "n") == 0);
+
+    // Tapping the other field while composing: the composition doesn't follow
+    ImGui_ImplAndroid_SetImeComposition("ma");
+    TEST_CHECK(IsDrawn(RunFrame()));
+    Tap(g_NameRect.GetCenter().x, g_NameRect.GetCenter().y);
+    TEST_CHECK(g.ActiveId != 0 && g.ActiveId != search_id);
+    TEST_CHECK_EQ(io.InputComposition.Size, 0);
+    TEST_CHECK(!IsDrawn(RunFrame()));
+    TEST_CHECK(strcmp(g_Search, "n") == 0);
+    TEST_CHECK(g_Name[0] == 0);
+
+    // Tapping outside any window deactivates the field, which clears its composition
+    ImGui_ImplAndroid_SetImeComposition("ke");
+    overlay = RunFrame();
+    TEST_CHECK(IsDrawn(overlay));
+    TEST_CHECK(overlay.Min.y >= g_NameRect.Min.y && overlay.Max.y <= g_NameRect.Max.y);
+    Tap(900.0f, 600.0f);
+    TEST_CHECK_EQ(g.ActiveId, 0);
+    TEST_CHECK_EQ(io.InputComposition.Size, 0);
+    TEST_CHECK(!IsDrawn(RunFrame()));
+
+    ImGui_ImplAndroid_Shutdown();
+    ImGui::DestroyContext(ctx);
+    return TestReport("ime_bridge");
+}
@@ -0,0 +1,167 @@
+// Input record/replay (InputReplay.h):
+// - a recorded session (clicks, trickled events, keys, text, a frame with more events than a 16-bit count) replays to the same
+//   io and window state at every frame
+// - version 1 recordings (16-bit event counts) are still read
+
+#include "test_common.h"
+#include "InputReplay.h"
+#include <vector>
+
+static const char* g_RecordingPath = "build/input_replay.rec";
+static const int g_FloodFrame = 30;
+static const int g_FloodEvents = 70000;     // > UINT16_MAX
+
+struct FrameState
+{
+    ImVec2  MousePos;
+    bool    MouseDown;
+    ImVec2  WindowPos;
+    int     Clicks;
+    char    Text[32];
+    double  Time;
+
+    bool operator==(const FrameState& o) const
+    {
+        return MousePos.x == o.MousePos.x && MousePos.y == o.MousePos.y && MouseDown == o.MouseDown && WindowPos.x == o.WindowPos.x &&
+            WindowPos.y == o.WindowPos.y && Clicks == o.Clicks && strcmp(Text, o.Text) == 0 && Time == o.Time;
+    }
+};
+
+static int g_Clicks = 0;
+static char g_Text[32] = "";
+static std::vector<FrameState> g_States;
+
+static void BuildUi()
+{
+    ImGui::SetNextWindowPos(ImVec2(40, 30), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Replay");
+    if (ImGui::Button("Click"))
+        g_Clicks++;
+    ImGui::InputText("Text", g_Text, IM_ARRAYSIZE(g_Text));
+    ImGui::End();
+
+    ImGuiIO& io = ImGui::GetIO();
+    FrameState state = {};
+    state.MousePos = io.MousePos;
+    state.MouseDown = io.MouseDown[0];
+    state.WindowPos = ImGui::FindWindowByName("Replay")->Pos;
+    state.Clicks = g_Clicks;
+    strcpy(state.Text, g_Text);
+    state.Time = ImGui::GetTime();
+    g_States.push_back(state);
+}
+
+static ImGuiContext* CreateContext()
+{
+    ImGuiContext* ctx = TestCreateContext(800, 600);
+    ImGui::GetIO().ConfigInputTrickleEventQueue = true;
+    g_Clicks = 0;
+    g_Text[0] = 0;
+    g_States.clear();
+    return ctx;
+}
+
+static std::vector<FrameState> Record()
+{
+    ImGuiContext* ctx = CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    android::InputRecorder recorder;
+    TEST_CHECK(recorder.Start(g_RecordingPath));
+    for (int frame = 0; frame < 50; frame++)
+    {
+        io.DeltaTime = frame % 3 == 0 ? 1.0f / 30.0f : 1.0f / 60.0f;
+        if (frame == 2)
+            io.AddMousePosEvent(55, 60);
+        if (frame == 3)
+            io.AddMouseButtonEvent(0, true);
+        if (frame == 5)
+            io.AddMouseButtonEvent(0, false);
+        if (frame == 8)
+        {
+            // Trickled over several frames
+            io.AddMousePosEvent(56, 61);
+            io.AddMouseButtonEvent(0, true);
+            io.AddMouseButtonEvent(0, false);
+            io.AddMouseButtonEvent(0, true);
+            io.AddMouseButtonEvent(0, false);
+        }
+        if (frame == 20)
+        {
+            io.AddKeyEvent(ImGuiKey_A, true);
+            io.AddInputCharacter('x');
+            io.AddKeyEvent(ImGuiKey_A, false);
+            io.AddInputCharactersUTF8("yz");
+        }
+        if (frame == g_FloodFrame)
+            for (int n = 0; n < g_FloodEvents; n++)
+                io.AddMousePosEvent((float)(100 + n % 200), (float)(200 + n % 3));
+        if (frame == 40)
+            io.AddFocusEvent(false);
+        recorder.RecordFrame();
+        ImGui::NewFrame();
+        BuildUi();
+        ImGui::Render();
+        TestUpdateTextures();
+    }
+    TEST_CHECK_EQ(recorder.GetFrameCount(), 50);
+    recorder.Stop();
+    std::vector<FrameState> states = g_States;
+    ImGui::DestroyContext(ctx);
+    return states;
+}
+
+int main()
+{
+    std::vector<FrameState> recorded = Record();
+    TEST_CHECK_EQ(recorded[4].Clicks, 0);
+    TEST_CHECK_EQ(recorded[5].Clicks, 1);    // On release
+    TEST_CHECK_EQ(recorded.back().Clicks, 3);
+    TEST_CHECK(recorded[g_FloodFrame].MousePos.x != recorded[g_FloodFrame - 1].MousePos.x);
+
+    ImGuiContext* ctx = CreateContext();
+    android::InputReplayer replayer;
+    TEST_CHECK(replayer.Open(g_RecordingPath));
+    android::InputReplayer::Stats stats = replayer.Run(BuildUi, [](ImDrawData*) { TestUpdateTextures(); });
+    TEST_CHECK_EQ(stats.frames, 50);
+    TEST_CHECK_EQ(g_States.size(), recorded.size());
+    for (size_t n = 0; n < g_States.size() && n < recorded.size(); n++)
+        if (!(g_States[n] == recorded[n]))
+        {
+            fprintf(stderr, "frame %d: replayed state differs\n", (int)n);
+            g_TestFailures++;
+        }
+    ImGui::DestroyContext(ctx);
+
+    // Version 1: same frame record with a 16-bit event count
+    {
+        android::detail::InputReplayWriter writer;
+        writer.Put(android::detail::kInputReplayMagic);
+        writer.Put((uint32_t)1);
+        writer.Put((uint32_t)0);
+        writer.Put((uint32_t)0);
+        writer.Put(1.0f / 60.0f);
+        writer.Put(640.0f);
+        writer.Put(480.0f);
+        writer.Put((uint16_t)1);
+        writer.Put((uint8_t)ImGuiInputEventType_MousePos);
+        writer.Put((uint8_t)ImGuiMouseSource_Mouse);
+        writer.Put(12.0f);
+        writer.Put(34.0f);
+        FILE* f = fopen(g_RecordingPath, "wb");
+        fwrite(writer.GetData().data(), 1, writer.GetData().size(), f);
+        fclose(f);
+
+        ctx = CreateContext();
+        TEST_CHECK(replayer.Open(g_RecordingPath));
+        replayer.Rewind();
+        TEST_CHECK(replayer.ApplyNextFrame());
+        ImGui::NewFrame();
+        TEST_CHECK(ImGui::GetIO().MousePos.x == 12.0f && ImGui::GetIO().MousePos.y == 34.0f);
+        TEST_CHECK(ImGui::GetIO().DisplaySize.x == 640.0f);
+        ImGui::EndFrame();
+        TEST_CHECK(!replayer.ApplyNextFrame());
+        ImGui::DestroyContext(ctx);
+    }
+
+    return TestReport("input_replay");
+}
@@ -0,0 +1,81 @@
+// ImFontAtlas::PrebakeGlyphs() measures and rasterizes stb_truetype glyphs on its own (in bulk, on worker threads), apart from the
+// on-demand FindGlyph() path. Two fonts with the same config, one prebaked and one loaded glyph by glyph, must end up with the same
+// glyphs: advance, drawing box, and the texels their UVs point to.
+
+#include "test_common.h"
+#include <string.h>
+
+static const ImWchar g_Ranges[] = { 0x0020, 0x00FF, 0x2000, 0x206F, 0 }; // Basic Latin, Latin-1 Supplement, General Punctuation
+
+static void CompareGlyphs(const ImFontConfig& font_cfg, float size)
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImFont* prebaked_font = atlas->AddFontDefaultVector(&font_cfg);
+    ImFont* loaded_font = atlas->AddFontDefaultVector(&font_cfg);
+    ImGui::NewFrame();
+
+    const int prebaked_count = atlas->PrebakeGlyphs(prebaked_font, size, g_Ranges, 4);
+    TEST_CHECK(prebaked_count > 0x7F - 0x20);
+    ImFontBaked* prebaked = prebaked_font->GetFontBaked(size);
+    ImFontBaked* loaded = loaded_font->GetFontBaked(size);
+    for (const ImWchar* range = g_Ranges; range[0]; range += 2)
+        for (unsigned int c = range[0]; c <= range[1]; c++)
+            loaded->FindGlyph((ImWchar)c);
+    TEST_CHECK_EQ(prebaked->Glyphs.Size - prebaked->GlyphsFreeSlots.Size, loaded->Glyphs.Size - loaded->GlyphsFreeSlots.Size);
+
+    // Both sets are in the same texture: compare texels through each glyph's UVs
+    ImTextureData* tex = atlas->TexData;
+    int visible_count = 0;
+    for (const ImWchar* range = g_Ranges; range[0]; range += 2)
+        for (unsigned int c = range[0]; c <= range[1]; c++)
+        {
+            const ImFontGlyph* a = prebaked->FindGlyphNoFallback((ImWchar)c);
+            const ImFontGlyph* b = loaded->FindGlyphNoFallback((ImWchar)c);
+            TEST_CHECK((a == NULL) == (b == NULL));
+            if (a == NULL || b == NULL)
+                continue;
+            TEST_CHECK_EQ(a->Codepoint, b->Codepoint);
+            TEST_CHECK_EQ(a->Visible, b->Visible);
+            TEST_CHECK(a->AdvanceX == b->AdvanceX);
+            TEST_CHECK(a->X0 == b->X0 && a->Y0 == b->Y0 && a->X1 == b->X1 && a->Y1 == b->Y1);
+            if (!a->Visible || !b->Visible)
+                continue;
+            visible_count++;
+            const int ax = (int)(a->U0 * tex->Width), ay = (int)(a->V0 * tex->Height);
+            const int bx = (int)(b->U0 * tex->Width), by = (int)(b->V0 * tex->Height);
+            const int w = (int)((a->U1 - a->U0) * tex->Width + 0.5f), h = (int)((a->V1 - a->V0) * tex->Height + 0.5f);
+            TEST_CHECK_EQ(w, (int)((b->U1 - b->U0) * tex->Width + 0.5f));
+            TEST_CHECK_EQ(h, (int)((b->V1 - b->V0) * tex->Height + 0.5f));
+            TEST_CHECK(w > 0 && h > 0);
+            int rows_differing = 0;
+            for (int y = 0; y < h; y++)
+                if (memcmp(tex->GetPixelsAt(ax, ay + y), tex->GetPixelsAt(bx, by + y), (size_t)(w * tex->BytesPerPixel)) != 0)
+                    rows_differing++;
+            if (rows_differing != 0)
+                fprintf(stderr, "U+%04X: %d/%d rows of texels differ\n", c, rows_differing, h);
+            TEST_CHECK_EQ(rows_differing, 0);
+        }
+    TEST_CHECK(visible_count > 0x7F - 0x21);
+
+    ImGui::EndFrame();
+}
+
+int main()
+{
+    ImGuiContext* ctx = TestCreateContext();
+
+    // Automatic oversampling (2x horizontally at this size), fractional glyph offset
+    ImFontConfig font_cfg;
+    font_cfg.GlyphOffset = ImVec2(0.4f, 1.6f);
+    CompareGlyphs(font_cfg, 23.0f);
+
+    // Explicit oversampling on both axes, rasterizer density
+    font_cfg = ImFontConfig();
+    font_cfg.OversampleH = 3;
+    font_cfg.OversampleV = 2;
+    font_cfg.RasterizerDensity = 1.5f;
+    CompareGlyphs(font_cfg, 17.0f);
+
+    ImGui::DestroyContext(ctx);
+    return TestReport("prebake_glyphs");
+}
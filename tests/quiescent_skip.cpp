@@ -0,0 +1,210 @@
+// Quiescent keyboard fast path (g.KeysQuiescent, UpdateKeyboardInputs()): a recorded session with long idle stretches between
+// keys, chords, shortcuts, key owners, wheel, text and clicks is replayed with g.KeysQuiescentSkip on and off. io and key state
+// (durations, owners, locks, last press time), hovered/active items and the draw data must match at every frame.
+
+#include "test_common.h"
+#include "InputReplay.h"
+#include <vector>
+
+static const char* g_RecordingPath = "build/quiescent_skip.rec";
+static const int g_Frames = 6000;
+
+static char g_Text[64];
+static float g_Value;
+static int g_Saves;
+static std::vector<ImU32> g_FrameHashes;
+static int g_SkippedFrames;     // Frames where the fast path applied
+static int g_QuiescentFrames;   // Frames with g.QuiescentFrames > 0
+
+static void ResetUiState()
+{
+    strcpy(g_Text, "hello");
+    g_Value = 0.5f;
+    g_Saves = 0;
+    g_FrameHashes.clear();
+    g_SkippedFrames = g_QuiescentFrames = 0;
+}
+
+static ImU32 HashIoState(ImU32 seed)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    ImU32 h = seed;
+    for (int n = 0; n < ImGuiKey_NamedKey_COUNT; n++)
+    {
+        const ImGuiKeyData& key = io.KeysData[n];
+        const ImGuiKeyOwnerData& owner = g.KeysOwnerData[n];
+        h = ImHashData(&key.Down, sizeof(key.Down), h);
+        h = ImHashData(&key.DownDuration, sizeof(key.DownDuration), h);
+        h = ImHashData(&key.DownDurationPrev, sizeof(key.DownDurationPrev), h);
+        h = ImHashData(&key.AnalogValue, sizeof(key.AnalogValue), h);
+        h = ImHashData(&owner.OwnerCurr, sizeof(owner.OwnerCurr), h);
+        h = ImHashData(&owner.OwnerNext, sizeof(owner.OwnerNext), h);
+        h = ImHashData(&owner.LockThisFrame, sizeof(owner.LockThisFrame), h);
+        h = ImHashData(&owner.LockUntilRelease, sizeof(owner.LockUntilRelease), h);
+    }
+    h = ImHashData(&g.LastKeyboardKeyPressTime, sizeof(g.LastKeyboardKeyPressTime), h);
+    h = ImHashData(&io.KeyMods, sizeof(io.KeyMods), h);
+    h = ImHashData(&io.MousePos, sizeof(io.MousePos), h);
+    h = ImHashData(io.MouseDown, sizeof(io.MouseDown), h);
+    h = ImHashData(&g.HoveredId, sizeof(g.HoveredId), h);
+    h = ImHashData(&g.ActiveId, sizeof(g.ActiveId), h);
+    h = ImHashData(&g.QuiescentFrames, sizeof(g.QuiescentFrames), h);
+    return h;
+}
+
+static void BuildUi()
+{
+    ImGuiContext& g = *GImGui;
+    ImU32 h = HashIoState(0);
+    g_QuiescentFrames += g.QuiescentFrames > 0;
+
+    ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_Once);
+    ImGui::Begin("Quiescent");
+    ImGui::InputText("Text", g_Text, IM_ARRAYSIZE(g_Text));
+    ImGui::SliderFloat("Value", &g_Value, 0.0f, 1.0f);
+    ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+    if (ImGui::IsItemHovered() && ImGui::GetIO().MouseWheel != 0.0f)
+        g_Value = ImClamp(g_Value + ImGui::GetIO().MouseWheel * 0.1f, 0.0f, 1.0f);
+    if (ImGui::Button("Button"))
+        g_Saves += 10;
+    ImGui::SetItemTooltip("Tooltip");
+    if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_S, ImGuiInputFlags_RouteGlobal))
+        g_Saves++;
+    if (ImGui::IsKeyPressed(ImGuiKey_F5))
+        g_Saves += 100;
+    ImGui::Text("%d", g_Saves);
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(450, 20), ImGuiCond_Once);
+    ImGui::Begin("Second");
+    ImGui::Text("Other window");
+    ImGui::End();
+
+    g_FrameHashes.push_back(h);
+}
+
+// Draw data after Render(), and whether the last NewFrame() took the fast path (g.KeysQuiescent on entry stays set)
+static void ConsumeDrawData(ImDrawData* draw_data)
+{
+    TestUpdateTextures();
+    ImU32 h = g_FrameHashes.back();
+    for (ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        h = ImHashData(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.size_in_bytes(), h);
+        h = ImHashData(draw_list->IdxBuffer.Data, draw_list->IdxBuffer.size_in_bytes(), h);
+    }
+    h = ImHashData(g_Text, strlen(g_Text), h);
+    h = ImHashData(&g_Value, sizeof(g_Value), h);
+    h = ImHashData(&g_Saves, sizeof(g_Saves), h);
+    g_FrameHashes.back() = h;
+    g_SkippedFrames += GImGui->KeysQuiescent;
+}
+
+static void Record()
+{
+    ImGuiContext* ctx = TestCreateContext(1280, 720);
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    ResetUiState();
+    android::InputRecorder recorder;
+    TEST_CHECK(recorder.Start(g_RecordingPath));
+    srand(49);
+    ImVector<ImGuiKeyChord> held_keys;  // Key | (release frame << 16)
+    for (int frame = 0; frame < g_Frames; frame++)
+    {
+        // Keys and buttons are released 1 to 20 frames after going down, some overlapping (chords)
+        for (int n = held_keys.Size - 1; n >= 0; n--)
+            if ((held_keys[n] >> 16) == frame)
+            {
+                ImGuiKey key = (ImGuiKey)(held_keys[n] & 0xFFFF);
+                if (key >= ImGuiKey_MouseLeft && key <= ImGuiKey_MouseMiddle)
+                    io.AddMouseButtonEvent(key - ImGuiKey_MouseLeft, false);
+                else
+                    io.AddKeyEvent(key, false);
+                held_keys.erase(held_keys.Data + n);
+            }
+        auto press = [&](ImGuiKey key)
+        {
+            if (key >= ImGuiKey_MouseLeft && key <= ImGuiKey_MouseMiddle)
+                io.AddMouseButtonEvent(key - ImGuiKey_MouseLeft, true);
+            else
+                io.AddKeyEvent(key, true);
+            held_keys.push_back((ImGuiKeyChord)key | ((frame + 1 + rand() % 20) << 16));
+        };
+
+        // Roughly one event every 8 frames: idle stretches in between
+        int r = rand() % 800;
+        if (r < 20)
+            io.AddMousePosEvent((float)(rand() % 700), (float)(rand() % 400));
+        else if (r < 30)
+            press((ImGuiKey)(ImGuiKey_MouseLeft + rand() % 2));
+        else if (r < 50)
+            press((ImGuiKey)(ImGuiKey_NamedKey_BEGIN + rand() % 100));
+        else if (r < 60)
+            press(ImGuiMod_Ctrl);
+        else if (r < 66)
+            press(ImGuiKey_S);
+        else if (r < 70)
+            press(ImGuiKey_F5);
+        else if (r < 75)
+            io.AddMouseWheelEvent(0.0f, (float)(rand() % 3 - 1));
+        else if (r < 85)
+            io.AddInputCharacter('a' + rand() % 26);
+        else if (r < 87)
+        {
+            io.ClearInputKeys();
+            held_keys.clear();
+        }
+        else if (r < 88)
+            io.AddFocusEvent(rand() % 2 != 0);
+        recorder.RecordFrame();
+        ImGui::NewFrame();
+        BuildUi();
+        ImGui::Render();
+        ConsumeDrawData(ImGui::GetDrawData());
+    }
+    recorder.Stop();
+    ImGui::DestroyContext(ctx);
+}
+
+static std::vector<ImU32> Replay(bool skip, int* out_skipped_frames)
+{
+    ImGuiContext* ctx = TestCreateContext(1280, 720);
+    ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    GImGui->KeysQuiescentSkip = skip;
+    ResetUiState();
+    android::InputReplayer replayer;
+    TEST_CHECK(replayer.Open(g_RecordingPath));
+    android::InputReplayer::Stats stats = replayer.Run(BuildUi, ConsumeDrawData);
+    TEST_CHECK_EQ(stats.frames, g_Frames);
+    *out_skipped_frames = g_SkippedFrames;
+    ImGui::DestroyContext(ctx);
+    return g_FrameHashes;
+}
+
+int main()
+{
+    Record();
+
+    int skipped_frames = 0, unused = 0;
+    std::vector<ImU32> with_skip = Replay(true, &skipped_frames);
+    int quiescent_frames = g_QuiescentFrames;
+    std::vector<ImU32> without_skip = Replay(false, &unused);
+    TEST_CHECK_EQ(with_skip.size(), without_skip.size());
+    for (size_t n = 0; n < with_skip.size() && n < without_skip.size(); n++)
+        if (with_skip[n] != without_skip[n])
+        {
+            fprintf(stderr, "frame %d: state differs with the fast path\n", (int)n);
+            g_TestFailures++;
+            break;
+        }
+
+    // The session must actually exercise the fast path, and still reach keys-down frames
+    printf("%d frames, %d with the keyboard fast path, %d quiescent\n", g_Frames, skipped_frames, quiescent_frames);
+    TEST_CHECK(skipped_frames > g_Frames / 4);
+    TEST_CHECK(skipped_frames < g_Frames);
+    TEST_CHECK(quiescent_frames > 0);
+    return TestReport("quiescent_skip");
+}
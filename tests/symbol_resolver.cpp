@@ -0,0 +1,113 @@
+// Functionals::SymbolResolver (ANativeWindowCreator.h) with a fake dlopen/dlsym: a variant from another Android version is only
+// bound when it has the exact same C++ prototype as the expected one, including when it comes from the variant cache.
+// Misses aren't cached, and a cache file others could have written is ignored.
+
+#define SURFACE_SYMBOL_CACHE_PATH "build/symbol_resolver.cache"
+#include "test_common.h"
+#include "ANativeWindowCreator.h"
+#include <set>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using android::detail::Functionals;
+
+static const char* APPLY_2 = "_ZN7android21SurfaceComposerClient11Transaction5applyEb";
+static const char* APPLY_3 = "_ZN7android21SurfaceComposerClient11Transaction5applyEbb";
+static const char* LAYER_METADATA_13 = "_ZN7android13LayerMetadataC2Ev";
+static const char* LAYER_METADATA_14 = "_ZN7android3gui13LayerMetadataC2Ev";
+
+static std::set<std::string> g_Exported;
+static char g_FakeLibrary;
+
+static void* FakeOpen(const char*, int)     { return &g_FakeLibrary; }
+static int FakeClose(void*)                 { return 0; }
+static void* FakeFind(void*, const char* symbol)
+{
+    auto it = g_Exported.find(symbol);
+    return it != g_Exported.end() ? (void*)&*it : NULL; // Any stable non-null address will do
+}
+
+static Functionals Resolve(size_t system_version, std::initializer_list<const char*> exported, Functionals::StartupReport* out_report = NULL)
+{
+    g_Exported.clear();
+    for (const char* symbol : exported)
+        g_Exported.insert(symbol);
+    Functionals functionals;
+    functionals.systemVersion = system_version;
+    Functionals::SymbolResolver resolver(functionals, { FakeOpen, FakeFind, FakeClose });
+    resolver.Require(Functionals::FeatureCore);
+    if (out_report != NULL)
+        *out_report = resolver.GetReport();
+    return functionals;
+}
+
+int main()
+{
+    // Expected variant
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    Functionals f = Resolve(12, { APPLY_2 });
+    TEST_CHECK((void*)f.SurfaceComposerClient__Transaction__Apply == FakeFind(NULL, APPLY_2));
+
+    // Android 12 ROM exporting only the 13+ three-parameter apply(): another prototype, the slot stays null
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    f = Resolve(12, { APPLY_3 });
+    TEST_CHECK(f.SurfaceComposerClient__Transaction__Apply == NULL);
+
+    // Same prototype, class moved to another namespace: can stand in both ways
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    f = Resolve(13, { LAYER_METADATA_14 });
+    TEST_CHECK((void*)f.LayerMetadata__Constructor == FakeFind(NULL, LAYER_METADATA_14));
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    f = Resolve(14, { LAYER_METADATA_13 });
+    TEST_CHECK((void*)f.LayerMetadata__Constructor == FakeFind(NULL, LAYER_METADATA_13));
+
+    // A cache entry left by an older version pointing at the three-parameter apply() isn't trusted on Android 12
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    Resolve(12, { APPLY_2 }); // Writes a cache file with this build's key on its first line
+    char key[256] = {};
+    if (FILE* file = fopen(SURFACE_SYMBOL_CACHE_PATH, "r"))
+    {
+        TEST_CHECK(fgets(key, sizeof(key), file) != NULL);
+        fclose(file);
+    }
+    if (FILE* file = fopen(SURFACE_SYMBOL_CACHE_PATH, "w"))
+    {
+        fprintf(file, "%sSurfaceComposerClient__Transaction::Apply 1\n", key);
+        fclose(file);
+    }
+    f = Resolve(12, { APPLY_3 });
+    TEST_CHECK(f.SurfaceComposerClient__Transaction__Apply == NULL);
+
+    // A miss (e.g. dlopen failing once) isn't remembered: the symbol resolves on the next launch
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    Resolve(12, {});
+    f = Resolve(12, { APPLY_2 });
+    TEST_CHECK((void*)f.SurfaceComposerClient__Transaction__Apply == FakeFind(NULL, APPLY_2));
+
+    // Cache written by the run above is private, and read back as long as nobody else can write it
+    struct stat info;
+    TEST_CHECK(stat(SURFACE_SYMBOL_CACHE_PATH, &info) == 0 && (info.st_mode & 0777) == 0600);
+    Functionals::StartupReport report;
+    Resolve(12, { APPLY_2 }, &report);
+    TEST_CHECK(report.cacheLoaded);
+    TEST_CHECK_EQ(report.cacheHits, 1);
+    chmod(SURFACE_SYMBOL_CACHE_PATH, 0666);
+    Resolve(12, { APPLY_2 }, &report);
+    TEST_CHECK(!report.cacheLoaded);
+    TEST_CHECK_EQ(report.cacheHits, 0);
+
+    // A link planted at the temporary path isn't written through
+    const char* victim_path = SURFACE_SYMBOL_CACHE_PATH ".victim";
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    remove(victim_path);
+    TEST_CHECK(symlink("symbol_resolver.cache.victim", SURFACE_SYMBOL_CACHE_PATH ".tmp") == 0);
+    Resolve(12, { APPLY_2 });
+    TEST_CHECK(access(victim_path, F_OK) != 0);
+    TEST_CHECK(lstat(SURFACE_SYMBOL_CACHE_PATH, &info) == 0 && S_ISREG(info.st_mode));
+
+    remove(SURFACE_SYMBOL_CACHE_PATH ".tmp");
+    remove(victim_path);
+    remove(SURFACE_SYMBOL_CACHE_PATH);
+    return TestReport("symbol_resolver");
+}
@@ -0,0 +1,60 @@
+// Shared helpers for host-side tests: a headless renderer that accepts every texture request, and check macros.
+#pragma once
+
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static int g_TestFailures = 0;
+
+#define TEST_CHECK(_EXPR)           do { if (!(_EXPR)) { fprintf(stderr, "%s:%d: CHECK FAILED: %s\n", __FILE__, __LINE__, #_EXPR); g_TestFailures++; } } while (0)
+#define TEST_CHECK_EQ(_A, _B)       do { long long _a = (long long)(_A), _b = (long long)(_B); if (_a != _b) { fprintf(stderr, "%s:%d: CHECK FAILED: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #_A, #_B, _a, _b); g_TestFailures++; } } while (0)
+
+// Create a context with a default font, a display and a renderer that supports ImGuiBackendFlags_RendererHasTextures.
+static inline ImGuiContext* TestCreateContext(float w = 1920.0f, float h = 1080.0f)
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(w, h);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.ConfigInputTrickleEventQueue = false;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.Fonts->AddFontDefault();
+    return ctx;
+}
+
+// Mimic a renderer backend processing ImGuiPlatformIO::Textures after Render().
+static inline void TestUpdateTextures()
+{
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+    {
+        if (tex->Status == ImTextureStatus_OK)
+            continue;
+        if (tex->Status == ImTextureStatus_WantDestroy)
+        {
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+        else if (tex->Status != ImTextureStatus_Destroyed)
+        {
+            tex->SetTexID((ImTextureID)1);
+            tex->SetStatus(ImTextureStatus_OK);
+        }
+    }
+}
+
+static inline int TestReport(const char* name)
+{
+    if (g_TestFailures == 0)
+        printf("%s: OK\n", name);
+    else
+        printf("%s: %d failure(s)\n", name, g_TestFailures);
+    return g_TestFailures == 0 ? 0 : 1;
+}